@@ -1816,6 +1816,7 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF("debug/settings/crash_handler/message.editor",
 			String("Please include this when reporting the bug on: https://github.com/godotengine/godot/issues"));
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/occlusion_culling/bvh_build_quality", PROPERTY_HINT_ENUM, "Low,Medium,High"), 2);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/occlusion_culling/culling_method", PROPERTY_HINT_ENUM, "Raycast,Raster"), 0);
 	GLOBAL_DEF_RST("rendering/occlusion_culling/jitter_projection", true);
 
 	GLOBAL_DEF_RST("internationalization/rendering/force_right_to_left_layout_direction", false);
@@ -1841,6 +1842,10 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/rendering_device/staging_buffer/texture_download_region_size_px", PROPERTY_HINT_RANGE, "1,256,1,or_greater"), 64);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::BOOL, "rendering/rendering_device/pipeline_cache/enable"), true);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/rendering_device/pipeline_cache/save_chunk_size_mb", PROPERTY_HINT_RANGE, "0.000001,64.0,0.001,or_greater"), 3.0);
+	GLOBAL_DEF_RST("rendering/rendering_device/pipeline_usage/record", false);
+	GLOBAL_DEF_RST("rendering/rendering_device/pipeline_usage/precompile", false);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "rendering/rendering_device/pipeline_usage/file_path", PROPERTY_HINT_SAVE_FILE, "*.rdpu"), "res://pipeline_usage.rdpu");
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/rendering_device/secondary_command_buffers/max_per_frame", PROPERTY_HINT_RANGE, "0,64,1"), 0);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/rendering_device/vulkan/max_descriptors_per_pool", PROPERTY_HINT_RANGE, "1,256,1,or_greater"), 64);
 
 	GLOBAL_DEF_RST("rendering/rendering_device/d3d12/max_resource_descriptors", 65536);
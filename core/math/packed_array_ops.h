@@ -0,0 +1,327 @@
+/**************************************************************************/
+/*  packed_array_ops.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cfloat>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Bulk arithmetic over packed numeric arrays, used by the element-wise methods of
+// the packed array types. The generic kernels are plain loops over raw pointers that
+// compilers vectorize; 32-bit floats, the common case for numeric scripts, get explicit
+// SSE2 or NEON kernels processing four elements at once.
+namespace PackedArrayOps {
+
+// The element type widened to its Variant counterpart, `int` or `float`.
+template <typename T>
+using Wide = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+
+// Integer sums and dot products are done in 64 bits, floating point ones in double precision.
+template <typename T>
+using Accumulator = Wide<T>;
+
+// Integers wrap around on overflow instead of being undefined behavior.
+template <typename T>
+_FORCE_INLINE_ T _add(T p_a, T p_b) {
+	if constexpr (std::is_integral_v<T>) {
+		return T(std::make_unsigned_t<T>(p_a) + std::make_unsigned_t<T>(p_b));
+	} else {
+		return p_a + p_b;
+	}
+}
+
+template <typename T>
+_FORCE_INLINE_ T _multiply(T p_a, T p_b) {
+	if constexpr (std::is_integral_v<T>) {
+		return T(std::make_unsigned_t<T>(p_a) * std::make_unsigned_t<T>(p_b));
+	} else {
+		return p_a * p_b;
+	}
+}
+
+// Same NaN behavior as the SSE2 instructions: the second operand is returned when unordered.
+template <typename T>
+_FORCE_INLINE_ T _min(T p_a, T p_b) {
+	return p_a < p_b ? p_a : p_b;
+}
+
+template <typename T>
+_FORCE_INLINE_ T _max(T p_a, T p_b) {
+	return p_a > p_b ? p_a : p_b;
+}
+
+template <typename T>
+void add(const T *p_a, const T *p_b, T *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = _add(p_a[i], p_b[i]);
+	}
+}
+
+template <typename T>
+void multiply(const T *p_a, const T *p_b, T *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = _multiply(p_a[i], p_b[i]);
+	}
+}
+
+template <typename T>
+void min(const T *p_a, const T *p_b, T *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = _min(p_a[i], p_b[i]);
+	}
+}
+
+template <typename T>
+void max(const T *p_a, const T *p_b, T *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = _max(p_a[i], p_b[i]);
+	}
+}
+
+// Writes 1 for every element greater than p_value and 0 for the others.
+// Compares in the wide type, so values out of the element range are not truncated first.
+template <typename T>
+void greater(const T *p_a, const Wide<T> &p_value, uint8_t *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = Wide<T>(p_a[i]) > p_value ? 1 : 0;
+	}
+}
+
+// Writes 1 for every element less than p_value and 0 for the others.
+template <typename T>
+void less(const T *p_a, const Wide<T> &p_value, uint8_t *r_dst, int64_t p_size) {
+	for (int64_t i = 0; i < p_size; i++) {
+		r_dst[i] = Wide<T>(p_a[i]) < p_value ? 1 : 0;
+	}
+}
+
+// Four independent partial sums, so that floating point additions are not serialized
+// on a single register (the compiler may not reorder them by itself).
+template <typename T>
+Accumulator<T> sum(const T *p_a, int64_t p_size) {
+	Accumulator<T> partial[4] = {};
+	int64_t i = 0;
+	for (; i + 4 <= p_size; i += 4) {
+		partial[0] = _add<Accumulator<T>>(partial[0], p_a[i + 0]);
+		partial[1] = _add<Accumulator<T>>(partial[1], p_a[i + 1]);
+		partial[2] = _add<Accumulator<T>>(partial[2], p_a[i + 2]);
+		partial[3] = _add<Accumulator<T>>(partial[3], p_a[i + 3]);
+	}
+	for (; i < p_size; i++) {
+		partial[0] = _add<Accumulator<T>>(partial[0], p_a[i]);
+	}
+	return _add(_add(partial[0], partial[1]), _add(partial[2], partial[3]));
+}
+
+template <typename T>
+Accumulator<T> dot(const T *p_a, const T *p_b, int64_t p_size) {
+	using A = Accumulator<T>;
+	A partial[4] = {};
+	int64_t i = 0;
+	for (; i + 4 <= p_size; i += 4) {
+		partial[0] = _add(partial[0], _multiply<A>(p_a[i + 0], p_b[i + 0]));
+		partial[1] = _add(partial[1], _multiply<A>(p_a[i + 1], p_b[i + 1]));
+		partial[2] = _add(partial[2], _multiply<A>(p_a[i + 2], p_b[i + 2]));
+		partial[3] = _add(partial[3], _multiply<A>(p_a[i + 3], p_b[i + 3]));
+	}
+	for (; i < p_size; i++) {
+		partial[0] = _add(partial[0], _multiply<A>(p_a[i], p_b[i]));
+	}
+	return _add(_add(partial[0], partial[1]), _add(partial[2], partial[3]));
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#if defined(__SSE2__)
+typedef __m128 Lanes;
+
+_FORCE_INLINE_ Lanes lanes_load(const float *p_ptr) {
+	return _mm_loadu_ps(p_ptr);
+}
+
+_FORCE_INLINE_ Lanes lanes_set(float p_value) {
+	return _mm_set1_ps(p_value);
+}
+
+_FORCE_INLINE_ void lanes_store(float *p_ptr, Lanes p_value) {
+	_mm_storeu_ps(p_ptr, p_value);
+}
+
+_FORCE_INLINE_ Lanes lanes_add(Lanes p_a, Lanes p_b) {
+	return _mm_add_ps(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_multiply(Lanes p_a, Lanes p_b) {
+	return _mm_mul_ps(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_min(Lanes p_a, Lanes p_b) {
+	return _mm_min_ps(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_max(Lanes p_a, Lanes p_b) {
+	return _mm_max_ps(p_a, p_b);
+}
+
+// One bit per lane, set where p_a is greater than p_b.
+_FORCE_INLINE_ uint32_t lanes_greater_mask(Lanes p_a, Lanes p_b) {
+	return uint32_t(_mm_movemask_ps(_mm_cmpgt_ps(p_a, p_b)));
+}
+#else
+typedef float32x4_t Lanes;
+
+_FORCE_INLINE_ Lanes lanes_load(const float *p_ptr) {
+	return vld1q_f32(p_ptr);
+}
+
+_FORCE_INLINE_ Lanes lanes_set(float p_value) {
+	return vdupq_n_f32(p_value);
+}
+
+_FORCE_INLINE_ void lanes_store(float *p_ptr, Lanes p_value) {
+	vst1q_f32(p_ptr, p_value);
+}
+
+_FORCE_INLINE_ Lanes lanes_add(Lanes p_a, Lanes p_b) {
+	return vaddq_f32(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_multiply(Lanes p_a, Lanes p_b) {
+	return vmulq_f32(p_a, p_b);
+}
+
+// Selects explicitly rather than using vminq_f32/vmaxq_f32, which propagate NaN.
+_FORCE_INLINE_ Lanes lanes_min(Lanes p_a, Lanes p_b) {
+	return vbslq_f32(vcltq_f32(p_a, p_b), p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_max(Lanes p_a, Lanes p_b) {
+	return vbslq_f32(vcgtq_f32(p_a, p_b), p_a, p_b);
+}
+
+_FORCE_INLINE_ uint32_t lanes_greater_mask(Lanes p_a, Lanes p_b) {
+	uint32_t lanes[4];
+	vst1q_u32(lanes, vcgtq_f32(p_a, p_b));
+	return (lanes[0] & 1) | (lanes[1] & 2) | (lanes[2] & 4) | (lanes[3] & 8);
+}
+#endif
+
+template <Lanes (*LANES_OP)(Lanes, Lanes), float (*SCALAR_OP)(float, float)>
+void _float_lanes_kernel(const float *p_a, const float *p_b, float *r_dst, int64_t p_size) {
+	int64_t i = 0;
+	for (; i + 4 <= p_size; i += 4) {
+		lanes_store(r_dst + i, LANES_OP(lanes_load(p_a + i), lanes_load(p_b + i)));
+	}
+	for (; i < p_size; i++) {
+		r_dst[i] = SCALAR_OP(p_a[i], p_b[i]);
+	}
+}
+
+inline void add(const float *p_a, const float *p_b, float *r_dst, int64_t p_size) {
+	_float_lanes_kernel<lanes_add, _add<float>>(p_a, p_b, r_dst, p_size);
+}
+
+inline void multiply(const float *p_a, const float *p_b, float *r_dst, int64_t p_size) {
+	_float_lanes_kernel<lanes_multiply, _multiply<float>>(p_a, p_b, r_dst, p_size);
+}
+
+inline void min(const float *p_a, const float *p_b, float *r_dst, int64_t p_size) {
+	_float_lanes_kernel<lanes_min, _min<float>>(p_a, p_b, r_dst, p_size);
+}
+
+inline void max(const float *p_a, const float *p_b, float *r_dst, int64_t p_size) {
+	_float_lanes_kernel<lanes_max, _max<float>>(p_a, p_b, r_dst, p_size);
+}
+
+inline void _write_mask(uint32_t p_mask, uint8_t *r_dst) {
+	r_dst[0] = p_mask & 1;
+	r_dst[1] = (p_mask >> 1) & 1;
+	r_dst[2] = (p_mask >> 2) & 1;
+	r_dst[3] = (p_mask >> 3) & 1;
+}
+
+// The largest float not above p_value. Converting out of range values directly is undefined.
+inline float _float_at_most(double p_value) {
+	if (p_value >= double(FLT_MAX)) {
+		return p_value == INFINITY ? INFINITY : FLT_MAX;
+	}
+	if (p_value < -double(FLT_MAX)) {
+		return -INFINITY;
+	}
+	const float value = float(p_value); // NaN is kept, and compares false either way.
+	return double(value) > p_value ? std::nextafter(value, -INFINITY) : value;
+}
+
+// The smallest float not below p_value.
+inline float _float_at_least(double p_value) {
+	if (p_value <= -double(FLT_MAX)) {
+		return p_value == -INFINITY ? -INFINITY : -FLT_MAX;
+	}
+	if (p_value > double(FLT_MAX)) {
+		return INFINITY;
+	}
+	const float value = float(p_value);
+	return double(value) < p_value ? std::nextafter(value, INFINITY) : value;
+}
+
+// The lanes compare in single precision against the nearest float on the right side of
+// p_value, which gives the same result for every float element as comparing in double precision.
+inline void greater(const float *p_a, const double &p_value, uint8_t *r_dst, int64_t p_size) {
+	const Lanes value = lanes_set(_float_at_most(p_value));
+	int64_t i = 0;
+	for (; i + 4 <= p_size; i += 4) {
+		_write_mask(lanes_greater_mask(lanes_load(p_a + i), value), r_dst + i);
+	}
+	for (; i < p_size; i++) {
+		r_dst[i] = double(p_a[i]) > p_value ? 1 : 0;
+	}
+}
+
+inline void less(const float *p_a, const double &p_value, uint8_t *r_dst, int64_t p_size) {
+	const Lanes value = lanes_set(_float_at_least(p_value));
+	int64_t i = 0;
+	for (; i + 4 <= p_size; i += 4) {
+		_write_mask(lanes_greater_mask(value, lanes_load(p_a + i)), r_dst + i);
+	}
+	for (; i < p_size; i++) {
+		r_dst[i] = double(p_a[i]) < p_value ? 1 : 0;
+	}
+}
+#endif // defined(__SSE2__) || defined(__ARM_NEON)
+
+} // namespace PackedArrayOps
@@ -33,6 +33,7 @@
 #include "core/config/engine.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 #include "core/templates/sort_array.h"
 #include "core/version.h"
 
@@ -65,6 +66,21 @@ ClassDB::APIType ClassDB::get_current_api() {
 }
 
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
+bool ClassDB::inheritance_ranges_dirty = true;
+
+// While ClassDB is frozen, readers skip `Locker::lock` and only count
+// themselves in one of these shards, which writers wait on to drain.
+// Sharding keeps concurrent readers from contending on one cache line.
+struct alignas(Thread::CACHE_LINE_BYTES) ClassDBFrozenReaders {
+	std::atomic<uint32_t> count = 0;
+};
+static constexpr uint32_t CLASS_DB_FROZEN_READER_SHARDS = 16;
+static ClassDBFrozenReaders class_db_frozen_readers[CLASS_DB_FROZEN_READER_SHARDS];
+static std::atomic<uint32_t> class_db_next_reader_shard = 0;
+static thread_local uint32_t class_db_reader_shard = class_db_next_reader_shard.fetch_add(1, std::memory_order_relaxed) % CLASS_DB_FROZEN_READER_SHARDS;
+static std::atomic<bool> class_db_frozen = false;
+static bool class_db_freeze_requested = false; // Only accessed with the write lock held.
+
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
@@ -232,7 +248,48 @@ public:
 
 bool ClassDB::_is_parent_class(const StringName &p_class, const StringName &p_inherits) {
 	const ClassInfo *c = classes.getptr(p_class);
-	return c ? c->gdtype->get_name_hierarchy().has(p_inherits) : false;
+	if (!c) {
+		return false;
+	}
+	if (!inheritance_ranges_dirty) {
+		const ClassInfo *inherits = classes.getptr(p_inherits);
+		return inherits && c->inheritance_index >= inherits->inheritance_index && c->inheritance_index < inherits->inheritance_end;
+	}
+	return c->gdtype->get_name_hierarchy().has(p_inherits);
+}
+
+void ClassDB::_update_inheritance_ranges() {
+	HashMap<const ClassInfo *, LocalVector<ClassInfo *>> children;
+	LocalVector<Pair<ClassInfo *, bool>> stack;
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		ClassInfo *parent = classes.getptr(E.value.gdtype->get_super_type_name());
+		if (parent) {
+			children[parent].push_back(&E.value);
+		} else {
+			stack.push_back(Pair<ClassInfo *, bool>(&E.value, false));
+		}
+	}
+
+	// Number the classes depth-first, so that each subtree is a contiguous range.
+	uint32_t index = 0;
+	while (!stack.is_empty()) {
+		const Pair<ClassInfo *, bool> entry = stack[stack.size() - 1];
+		stack.remove_at(stack.size() - 1);
+		if (entry.second) {
+			entry.first->inheritance_end = index;
+			continue;
+		}
+		entry.first->inheritance_index = index++;
+		stack.push_back(Pair<ClassInfo *, bool>(entry.first, true));
+		const LocalVector<ClassInfo *> *subclasses = children.getptr(entry.first);
+		if (subclasses) {
+			for (ClassInfo *subclass : *subclasses) {
+				stack.push_back(Pair<ClassInfo *, bool>(subclass, false));
+			}
+		}
+	}
+
+	inheritance_ranges_dirty = false;
 }
 
 bool ClassDB::is_parent_class(const StringName &p_class, const StringName &p_inherits) {
@@ -939,6 +996,7 @@ void ClassDB::_add_class(GDType &p_class, const GDType *p_inherits) {
 
 	ERR_FAIL_COND_MSG(classes.has(name), vformat("Class '%s' already exists.", name));
 
+	inheritance_ranges_dirty = true;
 	classes[name] = ClassInfo();
 	ClassInfo &ti = classes[name];
 	ti.gdtype = &p_class;
@@ -2245,6 +2303,7 @@ Variant ClassDB::class_get_default_property_value(const StringName &p_class, con
 
 void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	GLOBAL_LOCK_FUNCTION;
+	Locker::Lock lock(Locker::STATE_WRITE);
 
 	ERR_FAIL_COND_MSG(classes.has(p_extension->class_name), vformat("Class already registered: '%s'.", String(p_extension->class_name)));
 	ERR_FAIL_COND_MSG(!classes.has(p_extension->parent_class_name), vformat("Parent class name for extension class not found: '%s'.", String(p_extension->parent_class_name)));
@@ -2288,10 +2347,13 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 
 	c.gdtype = p_extension->gdtype;
 
+	inheritance_ranges_dirty = true;
 	classes[p_extension->class_name] = c;
 }
 
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
+	Locker::Lock lock(Locker::STATE_WRITE);
+
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, vformat("Class '%s' does not exist.", String(p_class)));
 	if (p_free_method_binds) {
@@ -2300,6 +2362,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_
 		}
 	}
 	classes.erase(p_class);
+	inheritance_ranges_dirty = true;
 	default_values_cached.erase(p_class);
 	default_values.erase(p_class);
 #ifdef TOOLS_ENABLED
@@ -2357,7 +2420,11 @@ void ClassDB::cleanup() {
 		}
 	}
 
+	class_db_freeze_requested = false;
+	class_db_frozen.store(false, std::memory_order_seq_cst);
+
 	classes.clear();
+	inheritance_ranges_dirty = true;
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
@@ -2388,6 +2455,17 @@ ClassDB::Locker::Lock::Lock(Locker::State p_state) {
 		if (Locker::thread_state == STATE_UNLOCKED) {
 			state = STATE_READ;
 			Locker::thread_state = STATE_READ;
+			if (class_db_frozen.load(std::memory_order_acquire)) {
+				// Announce the reader before checking again, so a writer thawing
+				// in between either sees it or is seen by it.
+				const uint32_t shard = class_db_reader_shard;
+				class_db_frozen_readers[shard].count.fetch_add(1, std::memory_order_seq_cst);
+				if (likely(class_db_frozen.load(std::memory_order_seq_cst))) {
+					frozen_shard = shard;
+					return;
+				}
+				class_db_frozen_readers[shard].count.fetch_sub(1, std::memory_order_release);
+			}
 			Locker::lock.read_lock();
 		}
 	} else if (p_state == STATE_WRITE) {
@@ -2395,6 +2473,17 @@ ClassDB::Locker::Lock::Lock(Locker::State p_state) {
 			state = STATE_WRITE;
 			Locker::thread_state = STATE_WRITE;
 			Locker::lock.write_lock();
+			if (class_db_frozen.load(std::memory_order_relaxed)) {
+				// Slow path: new readers now queue on the lock, wait for the lock-free ones to finish.
+				class_db_frozen.store(false, std::memory_order_seq_cst);
+				// Sequentially consistent like the readers' increment-then-recheck, so a reader
+				// either sees the flag cleared or is seen here still holding its count.
+				for (ClassDBFrozenReaders &readers : class_db_frozen_readers) {
+					while (readers.count.load(std::memory_order_seq_cst) != 0) {
+						Thread::yield();
+					}
+				}
+			}
 		} else if (Locker::thread_state == STATE_READ) {
 			CRASH_NOW_MSG("Lock can't be upgraded from read to write.");
 		}
@@ -2403,12 +2492,37 @@ ClassDB::Locker::Lock::Lock(Locker::State p_state) {
 
 ClassDB::Locker::Lock::~Lock() {
 	if (state == STATE_READ) {
-		Locker::lock.read_unlock();
+		if (frozen_shard != UINT32_MAX) {
+			class_db_frozen_readers[frozen_shard].count.fetch_sub(1, std::memory_order_release);
+		} else {
+			Locker::lock.read_unlock();
+		}
 		Locker::thread_state = STATE_UNLOCKED;
 	} else if (state == STATE_WRITE) {
+		if (class_db_freeze_requested) {
+			if (inheritance_ranges_dirty) {
+				_update_inheritance_ranges();
+			}
+			class_db_frozen.store(true, std::memory_order_seq_cst);
+		}
 		Locker::lock.write_unlock();
 		Locker::thread_state = STATE_UNLOCKED;
 	}
 }
 
+void ClassDB::freeze() {
+	// The table is frozen once this write lock is released.
+	Locker::Lock lock(Locker::STATE_WRITE);
+	class_db_freeze_requested = true;
+}
+
+void ClassDB::unfreeze() {
+	Locker::Lock lock(Locker::STATE_WRITE);
+	class_db_freeze_requested = false;
+}
+
+bool ClassDB::is_frozen() {
+	return class_db_frozen.load(std::memory_order_acquire);
+}
+
 #undef ERR_FAIL_NO_CLASS
@@ -154,6 +154,11 @@ public:
 		bool is_runtime = false;
 		// The bool argument indicates the need to postinitialize.
 		Object *(*creation_func)(bool) = nullptr;
+
+		// Depth-first pre-order position in the inheritance tree, the class and
+		// its descendants occupy `[inheritance_index, inheritance_end)`.
+		uint32_t inheritance_index = 0;
+		uint32_t inheritance_end = 0;
 	};
 
 	template <typename T>
@@ -169,6 +174,8 @@ public:
 
 	// We need a recursive r/w lock because there are various code paths
 	// that may in turn invoke other entry points with require locking.
+	// Once ClassDB is frozen, readers don't take the lock at all and writers
+	// first wait for those readers to finish (see `ClassDB::freeze()`).
 	class Locker {
 	public:
 		enum State {
@@ -184,6 +191,7 @@ public:
 	public:
 		class Lock {
 			State state = STATE_UNLOCKED;
+			uint32_t frozen_shard = UINT32_MAX; // Set if this read skipped the lock.
 
 		public:
 			explicit Lock(State p_state);
@@ -231,6 +239,8 @@ private:
 	// Non-locking variants of get_parent_class and is_parent_class.
 	static StringName _get_parent_class(const StringName &p_class);
 	static bool _is_parent_class(const StringName &p_class, const StringName &p_inherits);
+	static bool inheritance_ranges_dirty;
+	static void _update_inheritance_ranges();
 	static void _bind_compatibility(ClassInfo *r_type, MethodBind *p_method);
 	static MethodBind *_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility);
 	static void _bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility);
@@ -537,6 +547,12 @@ public:
 	static void cleanup_defaults();
 	static void cleanup();
 
+	// Called once registration is done. Lookups then skip the lock, and any
+	// later registration (e.g. GDExtension reloads) takes a slower path.
+	static void freeze();
+	static void unfreeze();
+	static bool is_frozen();
+
 	static void register_native_struct(const StringName &p_name, const String &p_code, uint64_t p_current_size);
 	static void get_native_struct_list(List<StringName> *r_names);
 	static String get_native_struct_code(const StringName &p_name);
@@ -1172,19 +1172,46 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData::SlotArray *Object::SignalData::acquire_slot_array() {
+	if (slot_map.is_empty()) {
+		return nullptr;
+	}
+
+	if (!slot_array) {
+		slot_array = memnew(SlotArray);
+		slot_array->refcount.init();
+		slot_array->callables.reserve(slot_map.size());
+		slot_array->flags.reserve(slot_map.size());
+		for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+			slot_array->callables.push_back(slot_kv.value.conn.callable);
+			slot_array->flags.push_back(slot_kv.value.conn.flags);
+		}
+	}
+
+	slot_array->refcount.ref();
+	return slot_array;
+}
+
+void Object::SignalData::invalidate_slot_array() {
+	if (slot_array) {
+		// Emissions in progress keep their own reference.
+		release_slot_array(slot_array);
+		slot_array = nullptr;
+	}
+}
+
+void Object::SignalData::release_slot_array(SlotArray *p_slot_array) {
+	if (p_slot_array->refcount.unref()) {
+		memdelete(p_slot_array);
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	SignalData::SlotArray *slots = nullptr;
 
 	{
 		ObjectSignalLock signal_lock(this);
@@ -1200,22 +1227,16 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
 		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		// will not affect the signal calling. The slot array is only rebuilt
+		// when connections changed since the last emission.
+		slots = s->acquire_slot_array();
 	}
 
+	const uint32_t slot_count = slots ? slots->callables.size() : 0;
+	const Callable *slot_callables = slots ? slots->callables.ptr() : nullptr;
+	const uint32_t *slot_flags = slots ? slots->flags.ptr() : nullptr;
+
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
 		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
@@ -1311,13 +1332,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
+	if (slots) {
+		SignalData::release_slot_array(slots);
 	}
 
 	if (pending_unref) {
@@ -1575,6 +1591,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_slot_array();
 
 	return OK;
 }
@@ -1653,6 +1670,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_slot_array();
 
 	if (s->slot_map.is_empty() && get_gdtype().get_signal_map(false).has(p_signal)) {
 		//not user signal, delete
@@ -2378,8 +2396,9 @@ void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+		const ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.get_validator()) {
+			p_func(object_slot.object.load(std::memory_order_relaxed), p_user_data);
 			count--;
 		}
 	}
@@ -2434,8 +2453,8 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<uint32_t> ObjectDB::slot_max = 0;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_chunks[OBJECTDB_SLOT_CHUNK_COUNT] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2444,32 +2463,32 @@ int ObjectDB::get_object_count() {
 
 ObjectID ObjectDB::add_instance(Object *p_object) {
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
+	uint32_t current_slot_max = slot_max.load(std::memory_order_relaxed);
+	if (unlikely(slot_count == current_slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		// Add a new chunk. Existing ones never move, so lock-free readers stay valid.
+		ObjectSlot *chunk = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_CHUNK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_CHUNK_SIZE; i++) {
+			memnew_placement(&chunk[i], ObjectSlot);
+			chunk[i].set_next_free(current_slot_max + i);
 		}
-		slot_max = new_slot_max;
+		object_slot_chunks[current_slot_max >> OBJECTDB_SLOT_CHUNK_BITS].store(chunk, std::memory_order_release);
+		slot_max.store(current_slot_max + OBJECTDB_SLOT_CHUNK_SIZE, std::memory_order_release);
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).get_next_free();
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_relaxed);
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	object_slot.set_validator(validator_counter, p_object->is_ref_counted());
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2492,17 +2511,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (object_slot.get_validator() != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(object_slot.get_validator() != validator);
 		}
 	}
 
@@ -2510,11 +2531,10 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	_get_slot(slot_count).set_next_free(slot);
+	//invalidate before clearing the object, so lock-free checks against it fail
+	object_slot.set_validator(0, false);
+	object_slot.object.store(nullptr, std::memory_order_release);
 
 	spin_lock.unlock();
 }
@@ -2537,8 +2557,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				const ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.get_validator()) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2551,7 +2572,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (object_slot.get_validator() << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted() ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2562,9 +2583,10 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_CHUNK_SIZE) {
+		memfree(object_slot_chunks[i >> OBJECTDB_SLOT_CHUNK_BITS].exchange(nullptr));
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
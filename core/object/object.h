@@ -40,6 +40,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
@@ -421,9 +422,36 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Flat, immutable copy of the connections in `slot_map`. Emissions share it
+		// instead of copying every callable, and keep it alive while they run.
+		// Dropped whenever the connections change and rebuilt by the next emission.
+		struct SlotArray {
+			SafeRefCount refcount;
+			LocalVector<Callable> callables;
+			LocalVector<uint32_t> flags;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		SlotArray *slot_array = nullptr;
 		bool removable = false;
+
+		// Must be called with the signal lock held.
+		SlotArray *acquire_slot_array();
+		void invalidate_slot_array();
+		static void release_slot_array(SlotArray *p_slot_array);
+
+		SignalData() {}
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other) {
+			invalidate_slot_array();
+			user = p_other.user;
+			slot_map = p_other.slot_map;
+			removable = p_other.removable;
+			return *this;
+		}
+		~SignalData() { invalidate_slot_array(); }
 	};
 	mutable Mutex *signal_mutex = nullptr;
 	HashMap<StringName, SignalData> signal_map;
@@ -884,20 +912,43 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots live in fixed-size chunks that are never moved, so they can be read without the lock.
+#define OBJECTDB_SLOT_CHUNK_BITS 12
+#define OBJECTDB_SLOT_CHUNK_SIZE (uint32_t(1) << OBJECTDB_SLOT_CHUNK_BITS)
+#define OBJECTDB_SLOT_CHUNK_MASK (OBJECTDB_SLOT_CHUNK_SIZE - 1)
+#define OBJECTDB_SLOT_CHUNK_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_CHUNK_BITS))
 
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Validator, next free slot and reference bit, laid out like in an ObjectID.
+		// Only written with the spin lock held, but read atomically by get_instance().
+		std::atomic<uint64_t> data = 0;
+		std::atomic<Object *> object = nullptr;
+
+		_ALWAYS_INLINE_ uint64_t get_validator() const { return data.load(std::memory_order_acquire) & OBJECTDB_VALIDATOR_MASK; }
+		_ALWAYS_INLINE_ uint32_t get_next_free() const { return (data.load(std::memory_order_relaxed) >> OBJECTDB_VALIDATOR_BITS) & OBJECTDB_SLOT_MAX_COUNT_MASK; }
+		_ALWAYS_INLINE_ bool is_ref_counted() const { return data.load(std::memory_order_relaxed) & OBJECTDB_REFERENCE_BIT; }
+
+		_ALWAYS_INLINE_ void set_next_free(uint32_t p_slot) {
+			uint64_t value = data.load(std::memory_order_relaxed) & ~(OBJECTDB_SLOT_MAX_COUNT_MASK << OBJECTDB_VALIDATOR_BITS);
+			data.store(value | (uint64_t(p_slot) << OBJECTDB_VALIDATOR_BITS), std::memory_order_relaxed);
+		}
+		// Publishes the validator, so any object stored before is visible to readers that match it.
+		_ALWAYS_INLINE_ void set_validator(uint64_t p_validator, bool p_ref_counted) {
+			uint64_t value = data.load(std::memory_order_relaxed) & (OBJECTDB_SLOT_MAX_COUNT_MASK << OBJECTDB_VALIDATOR_BITS);
+			data.store(value | p_validator | (p_ref_counted ? OBJECTDB_REFERENCE_BIT : 0), std::memory_order_release);
+		}
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<uint32_t> slot_max;
+	static std::atomic<ObjectSlot *> object_slot_chunks[OBJECTDB_SLOT_CHUNK_COUNT];
 	static uint64_t validator_counter;
 
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_chunks[p_slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire)[p_slot & OBJECTDB_SLOT_CHUNK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -911,24 +962,26 @@ class ObjectDB {
 public:
 	typedef void (*DebugFunc)(Object *p_obj, void *p_user_data);
 
+	// Lock-free: the object is only returned if the slot held the validator of the ID
+	// both before and after reading it, so a concurrently freed or reused slot yields null.
 	_ALWAYS_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); // This should never happen unless RID is corrupted.
 
+		const ObjectSlot &object_slot = _get_slot(slot);
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.get_validator() != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		if (unlikely(object_slot.get_validator() != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
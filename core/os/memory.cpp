@@ -30,6 +30,7 @@
 
 #include "memory.h"
 
+#include "core/os/small_object_allocator.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
@@ -44,6 +45,57 @@ static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
 #endif
 
+// Backing allocation for alloc_static(), realloc_static() and free_static(). Small blocks come
+// from SmallObjectAllocator when it's enabled, everything else from the system allocator.
+template <bool p_ensure_zero>
+static _FORCE_INLINE_ void *_alloc_raw(size_t p_bytes) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (p_bytes <= SmallObjectAllocator::MAX_SIZE) {
+		void *mem = SmallObjectAllocator::alloc(p_bytes, p_ensure_zero);
+		if (likely(mem)) {
+			return mem;
+		}
+	}
+#endif
+	if constexpr (p_ensure_zero) {
+		return calloc(1, p_bytes);
+	} else {
+		return malloc(p_bytes);
+	}
+}
+
+static _FORCE_INLINE_ void *_realloc_raw(void *p_memory, size_t p_bytes) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (SmallObjectAllocator::owns(p_memory)) {
+		const size_t block_size = SmallObjectAllocator::get_block_size(p_memory);
+		if (p_bytes == 0) {
+			SmallObjectAllocator::free(p_memory);
+			return nullptr;
+		}
+		if (p_bytes <= block_size) {
+			return p_memory;
+		}
+		void *mem = _alloc_raw<false>(p_bytes);
+		if (mem) {
+			memcpy(mem, p_memory, block_size);
+			SmallObjectAllocator::free(p_memory);
+		}
+		return mem;
+	}
+#endif
+	return realloc(p_memory, p_bytes);
+}
+
+static _FORCE_INLINE_ void _free_raw(void *p_memory) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (SmallObjectAllocator::owns(p_memory)) {
+		SmallObjectAllocator::free(p_memory);
+		return;
+	}
+#endif
+	free(p_memory);
+}
+
 void *operator new(size_t p_size, DefaultAllocator p_allocator) {
 	return Memory::alloc_static(p_size);
 }
@@ -94,12 +146,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
-	}
+	void *mem = _alloc_raw<p_ensure_zero>(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 	GodotProfileAlloc(mem, p_bytes + (prepad ? DATA_OFFSET : 0));
@@ -151,13 +198,13 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 		if (p_bytes == 0) {
 			GodotProfileFree(mem);
-			free(mem);
+			_free_raw(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
 			GodotProfileFree(mem);
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_realloc_raw(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 			GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
 
@@ -169,7 +216,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		}
 	} else {
 		GodotProfileFree(mem);
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_realloc_raw(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 		GodotProfileAlloc(mem, p_bytes);
@@ -198,10 +245,10 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 #endif
 
 		GodotProfileFree(mem);
-		free(mem);
+		_free_raw(mem);
 	} else {
 		GodotProfileFree(mem);
-		free(mem);
+		_free_raw(mem);
 	}
 }
 
@@ -0,0 +1,369 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+constexpr size_t ARENA_BITS = 22; // 4 MiB.
+constexpr size_t ARENA_SIZE = size_t(1) << ARENA_BITS;
+constexpr size_t PAGE_BITS = 16; // 64 KiB.
+constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+constexpr uint32_t PAGES_PER_ARENA = ARENA_SIZE / PAGE_SIZE;
+
+// Arenas are registered in a two-level bitmap indexed by address, so any pointer can be
+// checked for ownership without locking. This covers 48-bit addresses; arenas placed
+// above that are given back and the allocation falls back to the system allocator.
+constexpr uint32_t ARENA_MAP_LEAF_BITS = 13;
+constexpr uint32_t ARENA_MAP_ROOT_BITS = 48 - ARENA_BITS - ARENA_MAP_LEAF_BITS;
+constexpr uint32_t ARENA_MAP_LEAF_MASK = (1 << ARENA_MAP_LEAF_BITS) - 1;
+
+constexpr size_t SIZE_CLASSES[SmallObjectAllocator::SIZE_CLASS_COUNT] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+static_assert(SIZE_CLASSES[SmallObjectAllocator::SIZE_CLASS_COUNT - 1] == SmallObjectAllocator::MAX_SIZE);
+
+struct SizeClassLookup {
+	uint8_t table[(SmallObjectAllocator::MAX_SIZE >> 4) + 1] = {};
+
+	constexpr SizeClassLookup() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i <= (SmallObjectAllocator::MAX_SIZE >> 4); i++) {
+			while (SIZE_CLASSES[size_class] < i * 16) {
+				size_class++;
+			}
+			table[i] = size_class;
+		}
+	}
+};
+
+constexpr SizeClassLookup size_class_lookup;
+
+// Blocks moved between a thread cache and the central list at once.
+constexpr uint32_t get_batch_size(uint32_t p_size_class) {
+	return CLAMP(uint32_t(4096 / SIZE_CLASSES[p_size_class]), 8u, 64u);
+}
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// Stored at the start of each arena. The first page is never handed out.
+struct ArenaHeader {
+	uint8_t page_size_class[PAGES_PER_ARENA];
+};
+
+struct ArenaMapLeaf {
+	std::atomic<uint64_t> bits[(1 << ARENA_MAP_LEAF_BITS) / 64];
+};
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *free_list = nullptr;
+	uint64_t free_count = 0;
+	uint64_t page_count = 0;
+};
+
+SpinLock page_lock;
+uint8_t *current_arena = nullptr;
+uint32_t next_page = PAGES_PER_ARENA;
+std::atomic<uint64_t> arena_count = 0;
+std::atomic<ArenaMapLeaf *> arena_map[1 << ARENA_MAP_ROOT_BITS] = {};
+CentralList central_lists[SmallObjectAllocator::SIZE_CLASS_COUNT];
+
+void _give_to_central(uint32_t p_size_class, FreeBlock *p_first, FreeBlock *p_last, uint32_t p_count);
+
+// Trivially destructible, so it can still be read by destructors of other thread-local
+// objects after ThreadCacheFlush has given its blocks back.
+struct ThreadCache {
+	FreeBlock *lists[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	uint32_t counts[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	bool flush_registered;
+	bool flushed;
+};
+
+thread_local ThreadCache thread_cache = {};
+
+struct ThreadCacheFlush {
+	bool registered = false;
+
+	~ThreadCacheFlush() {
+		ThreadCache &cache = thread_cache;
+		for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+			if (cache.lists[i]) {
+				FreeBlock *last = cache.lists[i];
+				while (last->next) {
+					last = last->next;
+				}
+				_give_to_central(i, cache.lists[i], last, cache.counts[i]);
+				cache.lists[i] = nullptr;
+				cache.counts[i] = 0;
+			}
+		}
+		// Blocks freed by destructors running after this one go straight to the central lists.
+		cache.flushed = true;
+	}
+};
+
+thread_local ThreadCacheFlush thread_cache_flush;
+
+_FORCE_INLINE_ ThreadCache &_get_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	if (unlikely(!cache.flush_registered)) {
+		// Touching the flush object constructs it, which registers its destructor for this thread.
+		cache.flush_registered = true;
+		thread_cache_flush.registered = true;
+	}
+	return cache;
+}
+
+void *_alloc_arena() {
+#ifdef _WIN32
+	return _aligned_malloc(ARENA_SIZE, ARENA_SIZE);
+#else
+	void *arena = nullptr;
+	if (posix_memalign(&arena, ARENA_SIZE, ARENA_SIZE) != 0) {
+		return nullptr;
+	}
+	return arena;
+#endif
+}
+
+void _free_arena(void *p_arena) {
+#ifdef _WIN32
+	_aligned_free(p_arena);
+#else
+	::free(p_arena);
+#endif
+}
+
+// Must be called with page_lock held.
+uint8_t *_alloc_page(uint32_t p_size_class) {
+	if (next_page == PAGES_PER_ARENA) {
+		// Arenas are aligned to their size, so the header of any block is found by masking its address.
+		uint8_t *arena = (uint8_t *)_alloc_arena();
+		if (!arena) {
+			return nullptr;
+		}
+		uint64_t key = (uint64_t)(uintptr_t)arena >> ARENA_BITS;
+		if (key >> (ARENA_MAP_ROOT_BITS + ARENA_MAP_LEAF_BITS)) {
+			_free_arena(arena);
+			return nullptr;
+		}
+
+		ArenaMapLeaf *leaf = arena_map[key >> ARENA_MAP_LEAF_BITS].load(std::memory_order_relaxed);
+		if (!leaf) {
+			leaf = (ArenaMapLeaf *)calloc(1, sizeof(ArenaMapLeaf));
+			if (!leaf) {
+				_free_arena(arena);
+				return nullptr;
+			}
+			arena_map[key >> ARENA_MAP_LEAF_BITS].store(leaf, std::memory_order_release);
+		}
+
+		ArenaHeader *header = (ArenaHeader *)arena;
+		memset(header->page_size_class, 0, sizeof(header->page_size_class));
+		leaf->bits[(key & ARENA_MAP_LEAF_MASK) >> 6].fetch_or(uint64_t(1) << (key & 63), std::memory_order_release);
+
+		current_arena = arena;
+		next_page = 1;
+		arena_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	((ArenaHeader *)current_arena)->page_size_class[next_page] = p_size_class;
+	return current_arena + PAGE_SIZE * next_page++;
+}
+
+// Takes up to p_max blocks, carving a new page if the central list is empty.
+uint32_t _take_from_central(uint32_t p_size_class, uint32_t p_max, FreeBlock *&r_first, FreeBlock *&r_last) {
+	CentralList &central = central_lists[p_size_class];
+	central.lock.lock();
+
+	if (!central.free_list) {
+		page_lock.lock();
+		uint8_t *page = _alloc_page(p_size_class);
+		page_lock.unlock();
+
+		if (!page) {
+			central.lock.unlock();
+			return 0;
+		}
+
+		const size_t block_size = SIZE_CLASSES[p_size_class];
+		const uint32_t block_count = PAGE_SIZE / block_size;
+		for (uint32_t i = 0; i < block_count; i++) {
+			((FreeBlock *)(page + i * block_size))->next = i + 1 < block_count ? (FreeBlock *)(page + (i + 1) * block_size) : nullptr;
+		}
+		central.free_list = (FreeBlock *)page;
+		central.free_count += block_count;
+		central.page_count++;
+	}
+
+	r_first = central.free_list;
+	r_last = r_first;
+	uint32_t count = 1;
+	while (count < p_max && r_last->next) {
+		r_last = r_last->next;
+		count++;
+	}
+	central.free_list = r_last->next;
+	central.free_count -= count;
+
+	central.lock.unlock();
+
+	r_last->next = nullptr;
+	return count;
+}
+
+void _give_to_central(uint32_t p_size_class, FreeBlock *p_first, FreeBlock *p_last, uint32_t p_count) {
+	CentralList &central = central_lists[p_size_class];
+	central.lock.lock();
+	p_last->next = central.free_list;
+	central.free_list = p_first;
+	central.free_count += p_count;
+	central.lock.unlock();
+}
+
+_FORCE_INLINE_ uint32_t _get_size_class(const void *p_ptr) {
+	const ArenaHeader *header = (const ArenaHeader *)((uintptr_t)p_ptr & ~(uintptr_t)(ARENA_SIZE - 1));
+	return header->page_size_class[((uintptr_t)p_ptr - (uintptr_t)header) >> PAGE_BITS];
+}
+
+} // namespace
+
+void *SmallObjectAllocator::alloc(size_t p_bytes, bool p_zero) {
+	if (p_bytes > MAX_SIZE) {
+		return nullptr;
+	}
+
+	const uint32_t size_class = size_class_lookup.table[(p_bytes + 15) >> 4];
+	ThreadCache &cache = _get_thread_cache();
+	FreeBlock *block = nullptr;
+
+	if (unlikely(cache.flushed)) {
+		FreeBlock *last = nullptr;
+		if (!_take_from_central(size_class, 1, block, last)) {
+			return nullptr;
+		}
+	} else {
+		if (unlikely(!cache.lists[size_class])) {
+			FreeBlock *first = nullptr;
+			FreeBlock *last = nullptr;
+			const uint32_t count = _take_from_central(size_class, get_batch_size(size_class), first, last);
+			if (!count) {
+				return nullptr;
+			}
+			cache.lists[size_class] = first;
+			cache.counts[size_class] = count;
+		}
+		block = cache.lists[size_class];
+		cache.lists[size_class] = block->next;
+		cache.counts[size_class]--;
+	}
+
+	if (p_zero) {
+		memset(block, 0, SIZE_CLASSES[size_class]);
+	}
+	return block;
+}
+
+void SmallObjectAllocator::free(void *p_ptr) {
+	const uint32_t size_class = _get_size_class(p_ptr);
+	FreeBlock *block = (FreeBlock *)p_ptr;
+	ThreadCache &cache = _get_thread_cache();
+
+	if (unlikely(cache.flushed)) {
+		_give_to_central(size_class, block, block, 1);
+		return;
+	}
+
+	block->next = cache.lists[size_class];
+	cache.lists[size_class] = block;
+	cache.counts[size_class]++;
+
+	const uint32_t batch_size = get_batch_size(size_class);
+	if (unlikely(cache.counts[size_class] > batch_size * 2)) {
+		// Hand a batch back, so blocks freed by a different thread than the one
+		// allocating them don't pile up in this cache.
+		FreeBlock *first = cache.lists[size_class];
+		FreeBlock *last = first;
+		for (uint32_t i = 1; i < batch_size; i++) {
+			last = last->next;
+		}
+		cache.lists[size_class] = last->next;
+		cache.counts[size_class] -= batch_size;
+		_give_to_central(size_class, first, last, batch_size);
+	}
+}
+
+bool SmallObjectAllocator::owns(const void *p_ptr) {
+	const uint64_t key = (uint64_t)(uintptr_t)p_ptr >> ARENA_BITS;
+	if (unlikely(key >> (ARENA_MAP_ROOT_BITS + ARENA_MAP_LEAF_BITS))) {
+		return false;
+	}
+	const ArenaMapLeaf *leaf = arena_map[key >> ARENA_MAP_LEAF_BITS].load(std::memory_order_acquire);
+	return leaf && (leaf->bits[(key & ARENA_MAP_LEAF_MASK) >> 6].load(std::memory_order_acquire) & (uint64_t(1) << (key & 63)));
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+	return SIZE_CLASSES[_get_size_class(p_ptr)];
+}
+
+SmallObjectAllocator::SizeClassStats SmallObjectAllocator::get_size_class_stats(uint32_t p_size_class) {
+	SizeClassStats stats;
+	if (p_size_class >= SIZE_CLASS_COUNT) {
+		return stats;
+	}
+
+	CentralList &central = central_lists[p_size_class];
+	central.lock.lock();
+	stats.block_size = SIZE_CLASSES[p_size_class];
+	stats.page_count = central.page_count;
+	stats.used_blocks = central.page_count * (PAGE_SIZE / stats.block_size) - central.free_count;
+	central.lock.unlock();
+
+	return stats;
+}
+
+uint64_t SmallObjectAllocator::get_reserved_bytes() {
+	return arena_count.load(std::memory_order_relaxed) * ARENA_SIZE;
+}
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+// Allocator for small blocks used by Memory::alloc_static() when the engine is built
+// with `small_object_allocator=yes`. Blocks are grouped by size class into 64 KiB pages
+// carved from 4 MiB arenas. Each thread keeps a cache of free blocks per size class and
+// only exchanges them with the central lists in batches, so most allocations and frees
+// neither lock nor call into the system allocator. Pages are never returned to the
+// system, but a page only ever holds blocks of one size, which keeps long-running
+// processes from fragmenting the heap with many tiny allocations.
+class SmallObjectAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 512;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 16;
+
+	struct SizeClassStats {
+		size_t block_size = 0;
+		uint64_t page_count = 0;
+		uint64_t used_blocks = 0; // Includes blocks held in thread caches.
+	};
+
+	// Returns null if the size is too large or no arena could be allocated.
+	static void *alloc(size_t p_bytes, bool p_zero);
+	static void free(void *p_ptr);
+	static bool owns(const void *p_ptr);
+	static size_t get_block_size(const void *p_ptr);
+
+	static SizeClassStats get_size_class_stats(uint32_t p_size_class);
+	static uint64_t get_reserved_bytes();
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  cowdata.cpp                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "cowdata.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "core/templates/sort_array.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+namespace CowDataCopyStats {
+
+// Open addressing table with lock-free inserts; call sites are never removed.
+// Copies from call sites that don't fit anymore are still counted in the totals.
+static constexpr uint32_t TABLE_SIZE = 4096;
+
+struct Slot {
+	std::atomic<const void *> address = nullptr;
+	std::atomic<uint64_t> copies = 0;
+	std::atomic<uint64_t> bytes = 0;
+};
+
+static Slot table[TABLE_SIZE];
+static std::atomic<uint64_t> total_copies = 0;
+static std::atomic<uint64_t> total_bytes = 0;
+
+void record(const void *p_call_site, uint64_t p_bytes) {
+	total_copies.fetch_add(1, std::memory_order_relaxed);
+	total_bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+
+	uint32_t idx = (uint32_t)(((uint64_t)(uintptr_t)p_call_site * 0x9E3779B97F4A7C15ull) >> 52) & (TABLE_SIZE - 1);
+	for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+		Slot &slot = table[idx];
+		const void *address = slot.address.load(std::memory_order_acquire);
+		if (address == nullptr) {
+			if (slot.address.compare_exchange_strong(address, p_call_site, std::memory_order_acq_rel)) {
+				address = p_call_site;
+			}
+		}
+		if (address == p_call_site) {
+			slot.copies.fetch_add(1, std::memory_order_relaxed);
+			slot.bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+			return;
+		}
+		idx = (idx + 1) & (TABLE_SIZE - 1);
+	}
+}
+
+uint64_t get_copy_count() {
+	return total_copies.load(std::memory_order_relaxed);
+}
+
+uint64_t get_copied_bytes() {
+	return total_bytes.load(std::memory_order_relaxed);
+}
+
+struct CallSiteSort {
+	_FORCE_INLINE_ bool operator()(const CallSite &p_a, const CallSite &p_b) const {
+		return p_a.bytes > p_b.bytes;
+	}
+};
+
+uint32_t get_call_sites(CallSite *r_sites, uint32_t p_max) {
+	if (p_max == 0) {
+		return 0;
+	}
+
+	// Keep the heaviest sites in a sorted list of at most `p_max` entries.
+	SortArray<CallSite, CallSiteSort> sorter;
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+		const void *address = table[i].address.load(std::memory_order_acquire);
+		if (address == nullptr) {
+			continue;
+		}
+		CallSite site;
+		site.address = address;
+		site.copies = table[i].copies.load(std::memory_order_relaxed);
+		site.bytes = table[i].bytes.load(std::memory_order_relaxed);
+
+		if (count == p_max) {
+			if (site.bytes <= r_sites[count - 1].bytes) {
+				continue;
+			}
+			count--;
+		}
+		r_sites[count++] = site;
+		sorter.sort(r_sites, count);
+	}
+	return count;
+}
+
+void print_call_sites(uint32_t p_max) {
+	const uint64_t copies = get_copy_count();
+	if (copies == 0) {
+		return;
+	}
+
+	CallSite *sites = memnew_arr(CallSite, p_max);
+	const uint32_t count = get_call_sites(sites, p_max);
+
+	print_line(vformat("CowData: %d shared buffers copied on write (%s). Heaviest call sites (runtime addresses):", copies, String::humanize_size(get_copied_bytes())));
+	for (uint32_t i = 0; i < count; i++) {
+		print_line(vformat("  0x%s: %d copies, %s", String::num_uint64((uint64_t)(uintptr_t)sites[i].address, 16), sites[i].copies, String::humanize_size(sites[i].bytes)));
+	}
+
+	memdelete_arr(sites);
+}
+
+} // namespace CowDataCopyStats
+
+#endif // DEBUG_ENABLED
@@ -43,6 +43,14 @@
 #include <sanitizer/asan_interface.h>
 #endif
 
+// Address of the code calling the current function, used to attribute copy-on-write forks.
+#if defined(DEBUG_ENABLED) && defined(_MSC_VER)
+#include <intrin.h>
+#define COWDATA_CALL_SITE _ReturnAddress()
+#elif defined(DEBUG_ENABLED)
+#define COWDATA_CALL_SITE __builtin_return_address(0)
+#endif
+
 static_assert(std::is_trivially_destructible_v<std::atomic<uint64_t>>);
 
 // Silences false-positive warnings.
@@ -56,6 +64,26 @@ GODOT_GCC_PRAGMA(GCC diagnostic warning "-Wstringop-overflow=0") // Can't "ignor
 GODOT_GCC_PRAGMA(GCC diagnostic warning "-Wdangling-pointer=0") // Can't "ignore" this for some reason.
 #endif
 
+#ifdef DEBUG_ENABLED
+// Counts the buffers forked by copy-on-write, keyed by the address of the code that
+// asked for write access. Used to find code that writes to arrays it shares, which
+// silently copies the whole buffer.
+namespace CowDataCopyStats {
+struct CallSite {
+	const void *address = nullptr;
+	uint64_t copies = 0;
+	uint64_t bytes = 0;
+};
+
+void record(const void *p_call_site, uint64_t p_bytes);
+uint64_t get_copy_count();
+uint64_t get_copied_bytes();
+// Writes up to `p_max` call sites, sorted by bytes copied, and returns how many were written.
+uint32_t get_call_sites(CallSite *r_sites, uint32_t p_max);
+void print_call_sites(uint32_t p_max);
+} // namespace CowDataCopyStats
+#endif // DEBUG_ENABLED
+
 template <typename T>
 class CowData {
 public:
@@ -149,7 +177,20 @@ private:
 	[[nodiscard]] Error _remove(USize p_index, USize p_count);
 
 	/// Ensure we are the only owners of the backing buffer.
-	[[nodiscard]] Error _copy_on_write();
+	[[nodiscard]] _FORCE_INLINE_ Error _copy_on_write() {
+		if (!_ptr || _get_refcount()->get() == 1) {
+			// Nothing to do.
+			return OK;
+		}
+		return _fork();
+	}
+	/// Copies the shared buffer. Kept out of line, since forking is rare and every write access checks for it.
+	[[nodiscard]] _NO_INLINE_ Error _fork();
+#ifdef DEBUG_ENABLED
+	/// Counts a fork in CowDataCopyStats. Kept out of line so that the return address is the exact
+	/// instruction that forks, whose inlined frames lead back to the code that asked for the write.
+	static _NO_INLINE_ void _record_fork(USize p_bytes);
+#endif
 
 public:
 	void operator=(const CowData<T> &p_from) { _ref(p_from); }
@@ -363,6 +404,9 @@ Error CowData<T>::_insert_uninitialized(USize p_index, USize p_count, USize p_ca
 	} else {
 		// Insert new element by forking.
 		// Initialize the data elsewhere first and only swap when it's ready.
+#ifdef DEBUG_ENABLED
+		_record_fork(size() * sizeof(T));
+#endif
 		CowData new_data;
 
 		const Error error = new_data._alloc_exact(p_capacity);
@@ -415,6 +459,9 @@ Error CowData<T>::_remove(USize p_index, USize p_count) {
 		}
 	} else {
 		// Remove by forking.
+#ifdef DEBUG_ENABLED
+		_record_fork(new_size * sizeof(T));
+#endif
 		CowData new_data;
 
 		const Error error = new_data._alloc_exact(smaller_capacity(capacity(), new_size));
@@ -522,16 +569,18 @@ Error CowData<T>::_realloc_exact(USize p_capacity) {
 }
 
 template <typename T>
-Error CowData<T>::_copy_on_write() {
-	if (!_ptr || _get_refcount()->get() == 1) {
-		// Nothing to do.
-		return OK;
-	}
-
+Error CowData<T>::_fork() {
 	// Fork to become the only reference.
 	return _insert_uninitialized(size(), 0, capacity());
 }
 
+#ifdef DEBUG_ENABLED
+template <typename T>
+void CowData<T>::_record_fork(USize p_bytes) {
+	CowDataCopyStats::record(COWDATA_CALL_SITE, p_bytes);
+}
+#endif
+
 template <typename T>
 void CowData<T>::_ref(const CowData &p_from) {
 	if (_ptr == p_from._ptr) {
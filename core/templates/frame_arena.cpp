@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/math/math_funcs_binary.h"
+
+namespace {
+
+struct AllocationHeader {
+	void *arena = nullptr;
+	size_t size = 0;
+};
+
+} // namespace
+
+static constexpr size_t ALIGNMENT = 16;
+static constexpr size_t HEADER_SIZE = (sizeof(AllocationHeader) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(void *) + sizeof(size_t) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+struct FrameArena::Block {
+	Block *prev = nullptr;
+	size_t size = 0;
+
+	_FORCE_INLINE_ uint8_t *get_data() { return reinterpret_cast<uint8_t *>(this) + BLOCK_HEADER_SIZE; }
+};
+
+struct FrameArena::ThreadArena {
+	// Blocks that filled up are kept in the `prev` chain of the current one until the
+	// arena is rewound, since allocations in them may still be alive.
+	Block *block = nullptr;
+	size_t offset = 0;
+	size_t used = 0; // Bytes allocated since the last rewind, across all blocks.
+	size_t frame_peak = 0;
+	uint64_t frame = 0;
+	uint32_t live = 0;
+
+	~ThreadArena() {
+		if (live > 0) {
+			return; // Leak rather than leave dangling pointers behind.
+		}
+		while (block) {
+			Block *prev = block->prev;
+			FrameArena::reserved_bytes.fetch_sub(block->size, std::memory_order_relaxed);
+			Memory::free_static(block, false);
+			block = prev;
+		}
+	}
+};
+
+static _FORCE_INLINE_ size_t _get_allocation_size(size_t p_bytes) {
+	return HEADER_SIZE + ((p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+}
+
+static _FORCE_INLINE_ AllocationHeader *_get_header(void *p_ptr) {
+	return reinterpret_cast<AllocationHeader *>(static_cast<uint8_t *>(p_ptr) - HEADER_SIZE);
+}
+
+std::atomic<uint64_t> FrameArena::frame = 0;
+std::atomic<uint64_t> FrameArena::allocation_count = 0;
+std::atomic<uint64_t> FrameArena::block_allocation_count = 0;
+std::atomic<uint64_t> FrameArena::last_frame_allocation_count = 0;
+std::atomic<uint64_t> FrameArena::last_frame_block_allocation_count = 0;
+std::atomic<uint64_t> FrameArena::reserved_bytes = 0;
+
+thread_local FrameArena::ThreadArena FrameArena::thread_arena;
+
+void FrameArena::_rewind(ThreadArena &p_arena) {
+	// Nothing is alive, so blocks that filled up can go. The current block is the
+	// largest one, and was sized to fit everything allocated before it.
+	if (p_arena.block) {
+		Block *prev = p_arena.block->prev;
+		p_arena.block->prev = nullptr;
+		while (prev) {
+			Block *next = prev->prev;
+			reserved_bytes.fetch_sub(prev->size, std::memory_order_relaxed);
+			Memory::free_static(prev, false);
+			prev = next;
+		}
+	}
+
+	p_arena.frame_peak = MAX(p_arena.frame_peak, p_arena.used);
+	p_arena.offset = 0;
+	p_arena.used = 0;
+
+	const uint64_t current_frame = frame.load(std::memory_order_relaxed);
+	if (p_arena.frame != current_frame) {
+		// Give back a block that's much larger than what the last frame needed.
+		if (p_arena.block && p_arena.block->size > MIN_BLOCK_SIZE && p_arena.frame_peak * 4 < p_arena.block->size) {
+			reserved_bytes.fetch_sub(p_arena.block->size, std::memory_order_relaxed);
+			Memory::free_static(p_arena.block, false);
+			p_arena.block = nullptr;
+		}
+		p_arena.frame_peak = 0;
+		p_arena.frame = current_frame;
+	}
+}
+
+void FrameArena::_grow(ThreadArena &p_arena, size_t p_bytes) {
+	// Size the new block to hold everything allocated since the last rewind, so the
+	// next rewind leaves a single block that fits the whole workload.
+	const size_t size = MAX(MIN_BLOCK_SIZE, (size_t)Math::next_power_of_2((uint64_t)(p_arena.used + p_bytes)));
+
+	Block *block = static_cast<Block *>(Memory::alloc_static(BLOCK_HEADER_SIZE + size, false));
+	CRASH_COND_MSG(!block, "Out of memory");
+	block->prev = p_arena.block;
+	block->size = size;
+
+	p_arena.block = block;
+	p_arena.offset = 0;
+
+	block_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	reserved_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	ThreadArena &arena = thread_arena;
+	if (arena.live == 0) {
+		_rewind(arena);
+	}
+
+	const size_t size = _get_allocation_size(p_bytes);
+	if (unlikely(!arena.block || arena.offset + size > arena.block->size)) {
+		_grow(arena, size);
+	}
+
+	AllocationHeader *header = reinterpret_cast<AllocationHeader *>(arena.block->get_data() + arena.offset);
+	header->arena = &arena;
+	header->size = p_bytes;
+
+	arena.offset += size;
+	arena.used += size;
+	arena.live++;
+
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+	return reinterpret_cast<uint8_t *>(header) + HEADER_SIZE;
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	ThreadArena &arena = thread_arena;
+	AllocationHeader *header = _get_header(p_ptr);
+	ERR_FAIL_COND_V_MSG(header->arena != &arena, nullptr, "Frame arena memory must be reallocated by the thread that allocated it.");
+
+	// The most recent allocation can grow or shrink in place.
+	const size_t old_size = _get_allocation_size(header->size);
+	uint8_t *data = arena.block->get_data();
+	if (reinterpret_cast<uint8_t *>(header) >= data && reinterpret_cast<uint8_t *>(header) + old_size == data + arena.offset) {
+		const size_t new_size = _get_allocation_size(p_bytes);
+		if (arena.offset - old_size + new_size <= arena.block->size) {
+			arena.offset = arena.offset - old_size + new_size;
+			arena.used = arena.used - old_size + new_size;
+			header->size = p_bytes;
+			return p_ptr;
+		}
+	}
+
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_ptr, MIN(header->size, p_bytes));
+	free(p_ptr);
+	return mem;
+}
+
+void FrameArena::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+
+	ThreadArena &arena = thread_arena;
+	AllocationHeader *header = _get_header(p_ptr);
+	ERR_FAIL_COND_MSG(header->arena != &arena, "Frame arena memory must be freed by the thread that allocated it.");
+
+	// Give the space back if this is the most recent allocation.
+	const size_t size = _get_allocation_size(header->size);
+	uint8_t *data = arena.block->get_data();
+	if (reinterpret_cast<uint8_t *>(header) >= data && reinterpret_cast<uint8_t *>(header) + size == data + arena.offset) {
+		arena.offset -= size;
+		arena.frame_peak = MAX(arena.frame_peak, arena.used);
+		arena.used -= size;
+	}
+
+	arena.live--;
+}
+
+void FrameArena::advance_frame() {
+	frame.fetch_add(1, std::memory_order_relaxed);
+	last_frame_allocation_count.store(allocation_count.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	last_frame_block_allocation_count.store(block_allocation_count.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
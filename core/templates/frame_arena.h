@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Thread-local bump allocator for temporaries that live no longer than a frame, such as
+// scratch arrays filled and discarded while culling or answering physics queries.
+// Each thread allocates from its own block by moving a pointer forward, and rewinds the
+// block once all of its allocations are freed. Freeing the most recent allocation, or
+// reallocating it, happens in place, so growing a vector is usually free as well.
+//
+// Memory must be freed by the thread that allocated it, and should be freed before the
+// frame ends, since a thread can't rewind its block while anything in it is alive.
+// `advance_frame()` is called at the start of every main loop iteration; threads use it
+// to drop blocks that have grown much larger than what a frame needs.
+class FrameArena {
+	struct Block;
+	struct ThreadArena;
+
+	static constexpr size_t MIN_BLOCK_SIZE = 256 * 1024;
+
+	static std::atomic<uint64_t> frame;
+	static std::atomic<uint64_t> allocation_count;
+	static std::atomic<uint64_t> block_allocation_count;
+	static std::atomic<uint64_t> last_frame_allocation_count;
+	static std::atomic<uint64_t> last_frame_block_allocation_count;
+	static std::atomic<uint64_t> reserved_bytes;
+
+	static thread_local ThreadArena thread_arena;
+
+	static void _rewind(ThreadArena &p_arena);
+	static void _grow(ThreadArena &p_arena, size_t p_bytes);
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	static void advance_frame();
+
+	// Allocations served during the previous frame, each of them a heap allocation saved.
+	static uint64_t get_last_frame_allocation_count() { return last_frame_allocation_count.load(std::memory_order_relaxed); }
+	// Blocks requested from the heap by the arenas during the previous frame.
+	static uint64_t get_last_frame_block_allocation_count() { return last_frame_block_allocation_count.load(std::memory_order_relaxed); }
+	static uint64_t get_reserved_bytes() { return reserved_bytes.load(std::memory_order_relaxed); }
+};
+
+// LocalVector backed by the calling thread's frame arena, for per-frame temporaries.
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArena>;
@@ -32,12 +32,14 @@
 
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 #include <cstdio>
+#include <type_traits>
 #include <typeinfo> // IWYU pragma: keep // Used in macro.
 
 #ifdef TSAN_ENABLED
@@ -95,6 +97,8 @@ class RID_Alloc : public RID_AllocBase {
 		uint32_t validator;
 	};
 	Chunk **chunks = nullptr;
+	// Without THREAD_SAFE, a stack of free indices, `alloc_count` being its top.
+	// With THREAD_SAFE, the index of the next free slot for each free slot.
 	uint32_t **free_list_chunks = nullptr;
 
 	uint32_t elements_in_chunk;
@@ -104,52 +108,162 @@ class RID_Alloc : public RID_AllocBase {
 
 	const char *description = nullptr;
 
+	// With THREAD_SAFE, only taken to add chunks and to list owned RIDs.
 	mutable Mutex mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	// With THREAD_SAFE, free slots are kept in lock-free stacks, sharded by thread so
+	// that concurrent allocations and frees mostly touch different cache lines.
+	// Heads pack an ABA tag in the upper 32 bits and a slot index in the lower ones.
+	// Without THREAD_SAFE, the stacks are left out entirely.
+	static constexpr uint32_t FREE_LIST_SHARDS = 8;
+	static constexpr uint32_t FREE_LIST_END = 0xFFFFFFFF;
+	struct alignas(Thread::CACHE_LINE_BYTES) FreeListShard {
+		std::atomic<uint64_t> head = { FREE_LIST_END };
+	};
+	struct NoFreeListShards {};
+	std::conditional_t<THREAD_SAFE, FreeListShard[FREE_LIST_SHARDS], NoFreeListShards> free_list_shards;
+
+	_FORCE_INLINE_ uint32_t _load_validator(const Chunk &p_chunk) const {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
+			return ((const std::atomic<uint32_t> *)&p_chunk.validator)->load(std::memory_order_acquire);
+		} else {
+			return p_chunk.validator;
+		}
+	}
+
+	_FORCE_INLINE_ void _store_validator(Chunk &p_chunk, uint32_t p_validator) {
+		if constexpr (THREAD_SAFE) {
+			((std::atomic<uint32_t> *)&p_chunk.validator)->store(p_validator, std::memory_order_release);
+		} else {
+			p_chunk.validator = p_validator;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _load_max_alloc() const {
+		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _add_chunk_thread_safe().
+			return ((const std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	_FORCE_INLINE_ std::atomic<uint32_t> &_free_list_next(uint32_t p_index) {
+		return *(std::atomic<uint32_t> *)&free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+	uint32_t _pop_free(FreeListShard &p_shard) {
+		uint64_t head = p_shard.head.load(std::memory_order_acquire);
+		while (uint32_t(head) != FREE_LIST_END) {
+			// The slot may be popped and pushed again meanwhile, the tag makes the exchange fail then.
+			const uint32_t next = _free_list_next(uint32_t(head)).load(std::memory_order_relaxed);
+			const uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+			if (p_shard.head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire)) {
+				return uint32_t(head);
+			}
+		}
+		return FREE_LIST_END;
+	}
+
+	// Pushes the slots from p_first to p_last, which must already be linked to each other.
+	void _push_free(FreeListShard &p_shard, uint32_t p_first, uint32_t p_last) {
+		uint64_t head = p_shard.head.load(std::memory_order_relaxed);
+		do {
+			_free_list_next(p_last).store(uint32_t(head), std::memory_order_relaxed);
+		} while (!p_shard.head.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | p_first, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	_FORCE_INLINE_ uint32_t _get_thread_shard() const {
+		return uint32_t(Thread::get_caller_id() % FREE_LIST_SHARDS);
+	}
+
+	uint32_t _pop_free_any(uint32_t p_shard) {
+		for (uint32_t i = 0; i < FREE_LIST_SHARDS; i++) {
+			const uint32_t free_index = _pop_free(free_list_shards[(p_shard + i) % FREE_LIST_SHARDS]);
+			if (free_index != FREE_LIST_END) {
+				return free_index;
+			}
+		}
+		return FREE_LIST_END;
+	}
+
+	uint32_t _allocate_index_thread_safe() {
+		const uint32_t shard = _get_thread_shard();
+		uint32_t free_index = _pop_free_any(shard);
+		if (likely(free_index != FREE_LIST_END)) {
+			return free_index;
+		}
+
+		MutexLock lock(mutex);
+
+		// Another thread may have added a chunk while this one was waiting.
+		free_index = _pop_free_any(shard);
+		if (free_index != FREE_LIST_END) {
+			return free_index;
+		}
+
+		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		if (chunk_count == chunk_limit) {
+			return FREE_LIST_END;
+		}
+
+		chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			// Don't initialize chunk.
+			chunks[chunk_count][i].validator = 0xFFFFFFFF;
+			free_list_chunks[chunk_count][i] = max_alloc + i + 1;
+		}
+
+		free_index = max_alloc;
+		const uint32_t last_index = max_alloc + elements_in_chunk - 1;
+
+		// Publish the chunk before any of its slots can be handed out.
+		((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_release);
+
+		if (last_index != free_index) {
+			_push_free(free_list_shards[shard], free_index + 1, last_index);
 		}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
+		return free_index;
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		uint32_t free_index;
+
+		if constexpr (THREAD_SAFE) {
+			free_index = _allocate_index_thread_safe();
+			if (unlikely(free_index == FREE_LIST_END)) {
 				if (description != nullptr) {
 					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
 				} else {
 					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
 				}
 			}
+		} else {
+			if (alloc_count == max_alloc) {
+				//allocate a new chunk
+				uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
 
-			//grow chunks
-			if constexpr (!THREAD_SAFE) {
+				//grow chunks
 				chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
-			}
-			chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
-			//grow free lists
-			if constexpr (!THREAD_SAFE) {
+				chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+				//grow free lists
 				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			}
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+				free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
+				//initialize
+				for (uint32_t i = 0; i < elements_in_chunk; i++) {
+					// Don't initialize chunk.
+					chunks[chunk_count][i].validator = 0xFFFFFFFF;
+					free_list_chunks[chunk_count][i] = alloc_count + i;
+				}
 
-			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
-			} else {
 				max_alloc += elements_in_chunk;
 			}
-		}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+			free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		}
 
 		uint32_t free_chunk = free_index / elements_in_chunk;
 		uint32_t free_element = free_index % elements_in_chunk;
@@ -159,13 +273,12 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
-
-		alloc_count++;
+		_store_validator(chunks[free_chunk][free_element], validator | 0x80000000); //mark uninitialized bit
 
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			((std::atomic<uint32_t> *)&alloc_count)->fetch_add(1, std::memory_order_relaxed);
+		} else {
+			alloc_count++;
 		}
 
 		return _make_from_id(id);
@@ -199,13 +312,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _load_max_alloc())) {
 			return nullptr;
 		}
 
@@ -227,34 +334,29 @@ public:
 #ifdef TSAN_ENABLED
 			__tsan_release(&chunks[idx_chunk]);
 			__tsan_release(&chunks[idx_chunk][idx_element]);
-			__tsan_acquire(&c.validator); // We know not a race in practice.
 #endif
 		}
 
+		const uint32_t current_validator = _load_validator(c);
+
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(current_validator & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current_validator & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			_store_validator(c, validator); //initialized
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(current_validator != validator)) {
+			if ((current_validator & 0x80000000) && current_validator != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&c.validator);
-#endif
-		}
-
 		T *ptr = &c.data;
 
 		return ptr;
@@ -300,16 +402,9 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _load_max_alloc())) {
 			return false;
 		}
 
@@ -318,58 +413,48 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (_load_validator(chunks[idx_chunk][idx_element]) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL();
-		}
+		ERR_FAIL_COND(idx >= _load_max_alloc());
 
 		uint32_t idx_chunk = idx / elements_in_chunk;
 		uint32_t idx_element = idx % elements_in_chunk;
 
+		Chunk &c = chunks[idx_chunk][idx_element];
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		uint32_t current_validator = _load_validator(c);
+		if (unlikely(current_validator & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		} else if (unlikely(current_validator != validator)) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
+		if constexpr (THREAD_SAFE) {
+			// Invalidate first, so that only one of several concurrent frees of the same RID goes through.
+			ERR_FAIL_COND(!((std::atomic<uint32_t> *)&c.validator)->compare_exchange_strong(current_validator, 0xFFFFFFFF, std::memory_order_acq_rel));
+			c.data.~T();
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+			((std::atomic<uint32_t> *)&alloc_count)->fetch_sub(1, std::memory_order_relaxed);
+			_push_free(free_list_shards[_get_thread_shard()], idx, idx);
+		} else {
+			c.data.~T();
+			c.validator = 0xFFFFFFFF; // go invalid
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			alloc_count--;
+			free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		if constexpr (THREAD_SAFE) {
+			return ((const std::atomic<uint32_t> *)&alloc_count)->load(std::memory_order_relaxed);
+		} else {
+			return alloc_count;
+		}
 	}
 	LocalVector<RID> get_owned_list() const {
 		LocalVector<RID> owned;
@@ -377,7 +462,7 @@ public:
 			mutex.lock();
 		}
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				owned.push_back(_make_from_id((validator << 32) | i));
 			}
@@ -395,7 +480,7 @@ public:
 		}
 		uint32_t idx = 0;
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
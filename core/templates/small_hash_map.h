@@ -0,0 +1,629 @@
+/**************************************************************************/
+/*  small_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/sort_array.h"
+
+#include <initializer_list>
+
+template <typename TKey, typename TValue>
+struct SmallHashMapElement {
+	KeyValue<TKey, TValue> data;
+	uint32_t hash; // Cached key hash, EMPTY_HASH while the slot is free.
+	uint32_t prev;
+	uint32_t next; // Next slot in insertion order, or in the free list while the slot is free.
+};
+
+// Declared outside of SmallHashMap so that iterator types can be named while
+// the key or value types are still incomplete (see `Dictionary::ConstIterator`).
+template <typename TMap, typename TElement, typename TKeyValue>
+class SmallHashMapIterator {
+	template <typename, typename, typename>
+	friend class SmallHashMapIterator;
+
+	TMap *map = nullptr;
+	TElement *element = nullptr;
+
+public:
+	_FORCE_INLINE_ TKeyValue &operator*() const {
+		return element->data;
+	}
+	_FORCE_INLINE_ TKeyValue *operator->() const { return &element->data; }
+	_FORCE_INLINE_ SmallHashMapIterator &operator++() {
+		if (element) {
+			element = map->_get_element_or_null(element->next);
+		}
+		return *this;
+	}
+	_FORCE_INLINE_ SmallHashMapIterator &operator--() {
+		if (element) {
+			element = map->_get_element_or_null(element->prev);
+		}
+		return *this;
+	}
+
+	_FORCE_INLINE_ bool operator==(const SmallHashMapIterator &p_other) const { return element == p_other.element; }
+	_FORCE_INLINE_ bool operator!=(const SmallHashMapIterator &p_other) const { return element != p_other.element; }
+
+	_FORCE_INLINE_ explicit operator bool() const {
+		return element != nullptr;
+	}
+
+	_FORCE_INLINE_ SmallHashMapIterator(TMap *p_map, TElement *p_element) :
+			map(p_map), element(p_element) {}
+	_FORCE_INLINE_ SmallHashMapIterator() {}
+
+	// Allows converting a mutable iterator into a const one.
+	template <typename TOtherMap, typename TOtherElement, typename TOtherKeyValue>
+	_FORCE_INLINE_ SmallHashMapIterator(const SmallHashMapIterator<TOtherMap, TOtherElement, TOtherKeyValue> &p_other) :
+			map(p_other.map), element(p_other.element) {}
+};
+
+/**
+ * Ordered key-value container using open addressing, with inline storage for small maps.
+ *
+ * The first `INLINE_CAPACITY` entries live inside the map itself and are found by
+ * a linear scan over their cached hashes, so small maps never allocate. Larger
+ * maps spill into heap segments of doubling size and build a linear-probing index
+ * of `{hash, slot}` pairs. Segments are never reallocated, so key-values are
+ * pointer-stable across mutations, as long as the map itself is not moved.
+ * Remembers insertion order and iterates by it.
+ *
+ * Core container guidance:
+ * https://docs.godotengine.org/en/latest/engine_details/architecture/core_types.html#containers
+ */
+template <typename TKey, typename TValue,
+		uint32_t INLINE_CAPACITY = 8,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class _WARN_UNUSED_ SmallHashMap {
+	static_assert(INLINE_CAPACITY > 0 && (INLINE_CAPACITY & (INLINE_CAPACITY - 1)) == 0, "SmallHashMap inline capacity must be a power of two.");
+
+	template <typename, typename, typename>
+	friend class SmallHashMapIterator;
+
+public:
+	static constexpr uint32_t EMPTY_HASH = 0;
+	static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+	static constexpr uint32_t MAX_SIZE = 1u << 30;
+	using KV = KeyValue<TKey, TValue>; // Type alias for easier access to KeyValue.
+	using Element = SmallHashMapElement<TKey, TValue>;
+	using Iterator = SmallHashMapIterator<SmallHashMap, Element, KV>;
+	using ConstIterator = SmallHashMapIterator<const SmallHashMap, const Element, const KV>;
+
+private:
+	struct IndexEntry {
+		uint32_t hash;
+		uint32_t slot;
+	};
+
+	alignas(Element) uint8_t _inline_elements[sizeof(Element) * INLINE_CAPACITY];
+	Element **_segments = nullptr; // Segment `i` holds `INLINE_CAPACITY << i` slots.
+	IndexEntry *_index = nullptr; // Only built once the inline slots are exhausted.
+	uint32_t _segment_count = 0;
+	uint32_t _index_bits = 0;
+	uint32_t _slot_count = 0; // Slots ever handed out; higher slots are untouched.
+	uint32_t _size = 0;
+	uint32_t _head = INVALID_SLOT;
+	uint32_t _tail = INVALID_SLOT;
+	uint32_t _free = INVALID_SLOT;
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	_FORCE_INLINE_ static uint32_t _floor_log2(uint32_t p_value) {
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(p_value);
+#else
+		uint32_t log = 0;
+		while (p_value >>= 1) {
+			log++;
+		}
+		return log;
+#endif
+	}
+
+	_FORCE_INLINE_ Element *_get_element(uint32_t p_slot) {
+		if (likely(p_slot < INLINE_CAPACITY)) {
+			return reinterpret_cast<Element *>(_inline_elements) + p_slot;
+		}
+		const uint32_t segment = _floor_log2(p_slot / INLINE_CAPACITY);
+		return _segments[segment] + (p_slot - (INLINE_CAPACITY << segment));
+	}
+
+	_FORCE_INLINE_ const Element *_get_element(uint32_t p_slot) const {
+		return const_cast<SmallHashMap *>(this)->_get_element(p_slot);
+	}
+
+	_FORCE_INLINE_ Element *_get_element_or_null(uint32_t p_slot) {
+		return p_slot == INVALID_SLOT ? nullptr : _get_element(p_slot);
+	}
+
+	_FORCE_INLINE_ const Element *_get_element_or_null(uint32_t p_slot) const {
+		return p_slot == INVALID_SLOT ? nullptr : _get_element(p_slot);
+	}
+
+	_FORCE_INLINE_ uint32_t _get_index_home(uint32_t p_hash) const {
+		// Fibonacci hashing, so weak low bits in the key hash don't cluster the index.
+		return (p_hash * 2654435769u) >> (32 - _index_bits);
+	}
+
+	/// Returns the index position holding the key, or INVALID_SLOT. Assumes that _index != nullptr.
+	uint32_t _lookup_index_pos(const TKey &p_key, uint32_t p_hash) const {
+		const uint32_t mask = (1u << _index_bits) - 1;
+		uint32_t pos = _get_index_home(p_hash);
+
+		while (true) {
+			const IndexEntry &entry = _index[pos];
+			if (entry.hash == EMPTY_HASH) {
+				return INVALID_SLOT;
+			}
+			if (entry.hash == p_hash && Comparator::compare(_get_element(entry.slot)->data.key, p_key)) {
+				return pos;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	uint32_t _lookup_slot(const TKey &p_key, uint32_t p_hash) const {
+		if (_size == 0) {
+			return INVALID_SLOT;
+		}
+
+		if (_index == nullptr) {
+			// All slots are inline, scan them comparing cached hashes first.
+			const Element *elements = reinterpret_cast<const Element *>(_inline_elements);
+			for (uint32_t i = 0; i < _slot_count; i++) {
+				if (elements[i].hash == p_hash && Comparator::compare(elements[i].data.key, p_key)) {
+					return i;
+				}
+			}
+			return INVALID_SLOT;
+		}
+
+		const uint32_t pos = _lookup_index_pos(p_key, p_hash);
+		return pos == INVALID_SLOT ? INVALID_SLOT : _index[pos].slot;
+	}
+
+	void _index_insert(uint32_t p_hash, uint32_t p_slot) {
+		const uint32_t mask = (1u << _index_bits) - 1;
+		uint32_t pos = _get_index_home(p_hash);
+		while (_index[pos].hash != EMPTY_HASH) {
+			pos = (pos + 1) & mask;
+		}
+		_index[pos].hash = p_hash;
+		_index[pos].slot = p_slot;
+	}
+
+	void _index_erase(uint32_t p_pos) {
+		// Backward-shift deletion, so lookups never need tombstones.
+		const uint32_t mask = (1u << _index_bits) - 1;
+		uint32_t hole = p_pos;
+		uint32_t pos = p_pos;
+
+		while (true) {
+			pos = (pos + 1) & mask;
+			if (_index[pos].hash == EMPTY_HASH) {
+				break;
+			}
+			const uint32_t home = _get_index_home(_index[pos].hash);
+			if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+				_index[hole] = _index[pos];
+				hole = pos;
+			}
+		}
+
+		_index[hole].hash = EMPTY_HASH;
+	}
+
+	void _rebuild_index(uint32_t p_min_capacity) {
+		uint32_t bits = MAX(_index_bits, 4u);
+		// Keep the load factor at 0.75 at most.
+		while ((1u << bits) * 3 < p_min_capacity * 4) {
+			bits++;
+		}
+		if (_index != nullptr && bits == _index_bits) {
+			return;
+		}
+
+		if (_index != nullptr) {
+			Memory::free_static(_index);
+		}
+
+		_index_bits = bits;
+		static_assert(EMPTY_HASH == 0, "Assuming EMPTY_HASH = 0 for alloc_static_zeroed call");
+		_index = reinterpret_cast<IndexEntry *>(Memory::alloc_static_zeroed(sizeof(IndexEntry) * (1u << _index_bits)));
+
+		for (uint32_t i = 0; i < _slot_count; i++) {
+			const uint32_t hash = _get_element(i)->hash;
+			if (hash != EMPTY_HASH) {
+				_index_insert(hash, i);
+			}
+		}
+	}
+
+	void _add_segment() {
+		_segments = reinterpret_cast<Element **>(Memory::realloc_static(_segments, sizeof(Element *) * (_segment_count + 1)));
+		_segments[_segment_count] = reinterpret_cast<Element *>(Memory::alloc_static(sizeof(Element) * (INLINE_CAPACITY << _segment_count)));
+		_segment_count++;
+	}
+
+	_FORCE_INLINE_ uint32_t _get_slot_capacity() const {
+		return INLINE_CAPACITY << _segment_count;
+	}
+
+	Element *_insert(const TKey &p_key, const TValue &p_value, uint32_t p_hash, bool p_front_insert = false) {
+		ERR_FAIL_COND_V_MSG(_size >= MAX_SIZE, nullptr, "Hash table maximum capacity reached, aborting insertion.");
+
+		if (_size >= INLINE_CAPACITY) {
+			// Slots past the inline ones can only be found through the index.
+			if (_index == nullptr || (_size + 1) * 4 > (1u << _index_bits) * 3) {
+				_rebuild_index(_size + 1);
+			}
+		}
+
+		uint32_t slot = _free;
+		if (slot != INVALID_SLOT) {
+			_free = _get_element(slot)->next;
+		} else {
+			if (_slot_count == _get_slot_capacity()) {
+				_add_segment();
+			}
+			slot = _slot_count++;
+		}
+
+		Element *element = _get_element(slot);
+		memnew_placement(&element->data, KV(p_key, p_value));
+		element->hash = p_hash;
+
+		if (_tail == INVALID_SLOT) {
+			element->prev = INVALID_SLOT;
+			element->next = INVALID_SLOT;
+			_head = slot;
+			_tail = slot;
+		} else if (p_front_insert) {
+			element->prev = INVALID_SLOT;
+			element->next = _head;
+			_get_element(_head)->prev = slot;
+			_head = slot;
+		} else {
+			element->prev = _tail;
+			element->next = INVALID_SLOT;
+			_get_element(_tail)->next = slot;
+			_tail = slot;
+		}
+
+		if (_index != nullptr) {
+			_index_insert(p_hash, slot);
+		}
+		_size++;
+
+		return element;
+	}
+
+	void _remove_slot(uint32_t p_slot) {
+		Element *element = _get_element(p_slot);
+
+		if (element->prev != INVALID_SLOT) {
+			_get_element(element->prev)->next = element->next;
+		} else {
+			_head = element->next;
+		}
+		if (element->next != INVALID_SLOT) {
+			_get_element(element->next)->prev = element->prev;
+		} else {
+			_tail = element->prev;
+		}
+
+		element->data.~KV();
+		element->hash = EMPTY_HASH;
+		element->next = _free;
+		_free = p_slot;
+		_size--;
+	}
+
+	void _clear_data() {
+		uint32_t slot = _head;
+		while (slot != INVALID_SLOT) {
+			Element *element = _get_element(slot);
+			slot = element->next;
+			element->data.~KV();
+		}
+	}
+
+	template <typename C>
+	struct SlotSort {
+		const SmallHashMap *map = nullptr;
+		C compare;
+
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return compare(map->_get_element(p_a)->data, map->_get_element(p_b)->data);
+		}
+	};
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _get_slot_capacity(); }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_slot_count == 0) {
+			return;
+		}
+
+		_clear_data();
+		if (_index != nullptr) {
+			memset(_index, EMPTY_HASH, sizeof(IndexEntry) * (1u << _index_bits));
+		}
+		_slot_count = 0;
+		_size = 0;
+		_head = INVALID_SLOT;
+		_tail = INVALID_SLOT;
+		_free = INVALID_SLOT;
+	}
+
+	void sort() {
+		sort_custom<KeyValueSort<TKey, TValue>>();
+	}
+
+	template <typename C>
+	void sort_custom() {
+		if (size() < 2) {
+			return;
+		}
+
+		LocalVector<uint32_t> slots;
+		slots.reserve(_size);
+		for (uint32_t slot = _head; slot != INVALID_SLOT; slot = _get_element(slot)->next) {
+			slots.push_back(slot);
+		}
+
+		SortArray<uint32_t, SlotSort<C>> sorter;
+		sorter.compare.map = this;
+		sorter.sort(slots.ptr(), slots.size());
+
+		_head = slots[0];
+		_tail = slots[slots.size() - 1];
+		for (uint32_t i = 0; i < slots.size(); i++) {
+			Element *element = _get_element(slots[i]);
+			element->prev = i > 0 ? slots[i - 1] : INVALID_SLOT;
+			element->next = i + 1 < slots.size() ? slots[i + 1] : INVALID_SLOT;
+		}
+	}
+
+	TValue &get(const TKey &p_key) _LIFETIME_BOUND_ {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		CRASH_COND_MSG(slot == INVALID_SLOT, "SmallHashMap key not found.");
+		return _get_element(slot)->data.value;
+	}
+
+	const TValue &get(const TKey &p_key) const _LIFETIME_BOUND_ {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		CRASH_COND_MSG(slot == INVALID_SLOT, "SmallHashMap key not found.");
+		return _get_element(slot)->data.value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const _LIFETIME_BOUND_ {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot != INVALID_SLOT) {
+			return &_get_element(slot)->data.value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) _LIFETIME_BOUND_ {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		if (slot != INVALID_SLOT) {
+			return &_get_element(slot)->data.value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return _lookup_slot(p_key, _hash(p_key)) != INVALID_SLOT;
+	}
+
+	bool erase(const TKey &p_key) {
+		if (_size == 0) {
+			return false;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		uint32_t slot = INVALID_SLOT;
+		if (_index != nullptr) {
+			const uint32_t pos = _lookup_index_pos(p_key, hash);
+			if (pos == INVALID_SLOT) {
+				return false;
+			}
+			slot = _index[pos].slot;
+			_index_erase(pos);
+		} else {
+			slot = _lookup_slot(p_key, hash);
+			if (slot == INVALID_SLOT) {
+				return false;
+			}
+		}
+
+		_remove_slot(slot);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		ERR_FAIL_COND_MSG(p_new_capacity > MAX_SIZE, "Hash table maximum capacity reached.");
+		if (p_new_capacity <= INLINE_CAPACITY) {
+			return;
+		}
+
+		_rebuild_index(MAX(p_new_capacity, _size));
+		while (_get_slot_capacity() < p_new_capacity) {
+			_add_segment();
+		}
+	}
+
+	/** Iterator API **/
+
+	_FORCE_INLINE_ Iterator begin() _LIFETIME_BOUND_ {
+		return Iterator(this, _get_element_or_null(_head));
+	}
+	_FORCE_INLINE_ Iterator end() _LIFETIME_BOUND_ {
+		return Iterator(this, nullptr);
+	}
+	_FORCE_INLINE_ Iterator last() _LIFETIME_BOUND_ {
+		return Iterator(this, _get_element_or_null(_tail));
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) _LIFETIME_BOUND_ {
+		return Iterator(this, _get_element_or_null(_lookup_slot(p_key, _hash(p_key))));
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const _LIFETIME_BOUND_ {
+		return ConstIterator(this, _get_element_or_null(_head));
+	}
+	_FORCE_INLINE_ ConstIterator end() const _LIFETIME_BOUND_ {
+		return ConstIterator(this, nullptr);
+	}
+	_FORCE_INLINE_ ConstIterator last() const _LIFETIME_BOUND_ {
+		return ConstIterator(this, _get_element_or_null(_tail));
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const _LIFETIME_BOUND_ {
+		return ConstIterator(this, _get_element_or_null(_lookup_slot(p_key, _hash(p_key))));
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const _LIFETIME_BOUND_ {
+		const uint32_t slot = _lookup_slot(p_key, _hash(p_key));
+		CRASH_COND(slot == INVALID_SLOT);
+		return _get_element(slot)->data.value;
+	}
+
+	TValue &operator[](const TKey &p_key) _LIFETIME_BOUND_ {
+		const uint32_t hash = _hash(p_key);
+		const uint32_t slot = _lookup_slot(p_key, hash);
+		if (slot == INVALID_SLOT) {
+			return _insert(p_key, TValue(), hash)->data.value;
+		} else {
+			return _get_element(slot)->data.value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
+		const uint32_t hash = _hash(p_key);
+		const uint32_t slot = _lookup_slot(p_key, hash);
+		if (slot == INVALID_SLOT) {
+			return Iterator(this, _insert(p_key, p_value, hash, p_front_insert));
+		} else {
+			Element *element = _get_element(slot);
+			element->data.value = p_value;
+			return Iterator(this, element);
+		}
+	}
+
+	/* Constructors */
+
+	explicit SmallHashMap(const SmallHashMap &p_other) {
+		reserve(p_other._size);
+
+		for (uint32_t slot = p_other._head; slot != INVALID_SLOT;) {
+			const Element *element = p_other._get_element(slot);
+			// Keys are known to be unique, reuse the cached hashes.
+			_insert(element->data.key, element->data.value, element->hash);
+			slot = element->next;
+		}
+	}
+
+	void operator=(const SmallHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+
+		reserve(p_other._size);
+
+		for (uint32_t slot = p_other._head; slot != INVALID_SLOT;) {
+			const Element *element = p_other._get_element(slot);
+			_insert(element->data.key, element->data.value, element->hash);
+			slot = element->next;
+		}
+	}
+
+	SmallHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SmallHashMap() {}
+
+	SmallHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	~SmallHashMap() {
+		_clear_data();
+
+		for (uint32_t i = 0; i < _segment_count; i++) {
+			Memory::free_static(_segments[i]);
+		}
+		if (_segments != nullptr) {
+			Memory::free_static(_segments);
+		}
+		if (_index != nullptr) {
+			Memory::free_static(_index);
+		}
+	}
+};
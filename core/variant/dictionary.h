@@ -30,9 +30,10 @@
 
 #pragma once
 
-#include "core/templates/hash_map.h"
+#include "core/templates/hash_map.h" // IWYU pragma: keep. Used to be the backend, still expected through `variant.h`.
 #include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/small_hash_map.h"
 #include "core/variant/variant_deep_duplicate.h"
 
 class Array;
@@ -44,9 +45,10 @@ struct DictionaryPrivate;
 struct StringLikeVariantComparator;
 
 /**
- * Key-value Variant container (aka hash table or dictionary) using robin-hood hashing.
+ * Key-value Variant container (aka hash table or dictionary) using open addressing.
  *
- * Uses `HashMap` internally, thus remembers insertion order and is pointer-stable.
+ * Uses `SmallHashMap` internally, thus remembers insertion order and is pointer-stable.
+ * Dictionaries with up to `DICTIONARY_INLINE_CAPACITY` entries don't allocate per entry.
  *
  * Core container guidance:
  * https://docs.godotengine.org/en/latest/engine_details/architecture/core_types.html#containers
@@ -58,7 +60,12 @@ class _WARN_UNUSED_ Dictionary {
 	void _unref() const;
 
 public:
-	using ConstIterator = HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator;
+	// Covers the 3 to 8 keys of typical messages and component data without any allocation past the
+	// dictionary itself. Every dictionary pays for these slots, empty or not, so don't raise it further.
+	static constexpr uint32_t DICTIONARY_INLINE_CAPACITY = 8;
+	using Map = SmallHashMap<Variant, Variant, DICTIONARY_INLINE_CAPACITY, HashMapHasherDefault, StringLikeVariantComparator>;
+	// Spelled out, since `Map` can't be instantiated while `Variant` is incomplete.
+	using ConstIterator = SmallHashMapIterator<const Map, const SmallHashMapElement<Variant, Variant>, const KeyValue<Variant, Variant>>;
 
 	ConstIterator begin() const;
 	ConstIterator end() const;
@@ -44,7 +44,8 @@ struct PtrToArgDirect {
 	}
 	typedef T EncodeT;
 	_FORCE_INLINE_ static void encode(T p_val, void *p_ptr) {
-		*((T *)p_ptr) = p_val;
+		// `p_val` is our own copy, so ref-counted types can hand their data over.
+		*((T *)p_ptr) = std::move(p_val);
 	}
 };
 
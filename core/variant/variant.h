@@ -231,6 +231,9 @@ private:
 		static _FORCE_INLINE_ PackedArrayRef<T> *create(const Vector<T> &p_from) {
 			return memnew(PackedArrayRef<T>(p_from));
 		}
+		static _FORCE_INLINE_ PackedArrayRef<T> *create(Vector<T> &&p_from) {
+			return memnew(PackedArrayRef<T>(std::move(p_from)));
+		}
 
 		static _FORCE_INLINE_ const Vector<T> &get_array(PackedArrayRefBase *p_base) {
 			return static_cast<PackedArrayRef<T> *>(p_base)->array;
@@ -243,6 +246,10 @@ private:
 			array = p_from;
 			refcount.init();
 		}
+		_FORCE_INLINE_ PackedArrayRef(Vector<T> &&p_from) :
+				array(std::move(p_from)) {
+			refcount.init();
+		}
 		_FORCE_INLINE_ PackedArrayRef() {
 			refcount.init();
 		}
@@ -543,6 +550,17 @@ public:
 	Variant(const PackedVector3Array &p_vector3_array);
 	Variant(const PackedColorArray &p_color_array);
 	Variant(const PackedVector4Array &p_vector4_array);
+	// Take over the buffer of an array that is handed off, saving a reference count round trip.
+	Variant(PackedByteArray &&p_byte_array);
+	Variant(PackedInt32Array &&p_int32_array);
+	Variant(PackedInt64Array &&p_int64_array);
+	Variant(PackedFloat32Array &&p_float32_array);
+	Variant(PackedFloat64Array &&p_float64_array);
+	Variant(PackedStringArray &&p_string_array);
+	Variant(PackedVector2Array &&p_vector2_array);
+	Variant(PackedVector3Array &&p_vector3_array);
+	Variant(PackedColorArray &&p_color_array);
+	Variant(PackedVector4Array &&p_vector4_array);
 
 	Variant(const Vector<::RID> &p_array); // helper
 	Variant(const Vector<Plane> &p_array); // helper
@@ -31,6 +31,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/packed_array_ops.h"
 #include "core/os/os.h"
 #include "core/templates/a_hash_map.h"
 #include "core/templates/local_vector.h"
@@ -1166,6 +1167,72 @@ struct _VariantCall {
 		return ret;
 	}
 
+	// Element-wise operations on numeric packed arrays, see PackedArrayOps.
+	template <typename T>
+	static Vector<T> func_packed_array_elementwise(Vector<T> *p_instance, const Vector<T> &p_array, void (*p_kernel)(const T *, const T *, T *, int64_t)) {
+		Vector<T> ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_array.size(), ret, vformat("Array sizes must match (%d != %d).", p_instance->size(), p_array.size()));
+		ret.resize(p_instance->size());
+		if (ret.is_empty()) {
+			return ret;
+		}
+		p_kernel(p_instance->ptr(), p_array.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	template <typename T>
+	static Vector<T> func_packed_array_elementwise_add(Vector<T> *p_instance, const Vector<T> &p_array) {
+		return func_packed_array_elementwise<T>(p_instance, p_array, PackedArrayOps::add);
+	}
+
+	template <typename T>
+	static Vector<T> func_packed_array_elementwise_multiply(Vector<T> *p_instance, const Vector<T> &p_array) {
+		return func_packed_array_elementwise<T>(p_instance, p_array, PackedArrayOps::multiply);
+	}
+
+	template <typename T>
+	static Vector<T> func_packed_array_elementwise_min(Vector<T> *p_instance, const Vector<T> &p_array) {
+		return func_packed_array_elementwise<T>(p_instance, p_array, PackedArrayOps::min);
+	}
+
+	template <typename T>
+	static Vector<T> func_packed_array_elementwise_max(Vector<T> *p_instance, const Vector<T> &p_array) {
+		return func_packed_array_elementwise<T>(p_instance, p_array, PackedArrayOps::max);
+	}
+
+	template <typename T>
+	static PackedByteArray func_packed_array_elementwise_greater(Vector<T> *p_instance, const PackedArrayOps::Wide<T> &p_value) {
+		PackedByteArray ret;
+		ret.resize(p_instance->size());
+		if (ret.is_empty()) {
+			return ret;
+		}
+		PackedArrayOps::greater(p_instance->ptr(), p_value, ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	template <typename T>
+	static PackedByteArray func_packed_array_elementwise_less(Vector<T> *p_instance, const PackedArrayOps::Wide<T> &p_value) {
+		PackedByteArray ret;
+		ret.resize(p_instance->size());
+		if (ret.is_empty()) {
+			return ret;
+		}
+		PackedArrayOps::less(p_instance->ptr(), p_value, ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	template <typename T>
+	static PackedArrayOps::Accumulator<T> func_packed_array_sum(Vector<T> *p_instance) {
+		return PackedArrayOps::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static PackedArrayOps::Accumulator<T> func_packed_array_dot(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_array.size(), 0, vformat("Array sizes must match (%d != %d).", p_instance->size(), p_array.size()));
+		return PackedArrayOps::dot(p_instance->ptr(), p_array.ptr(), p_instance->size());
+	}
+
 	static void func_Callable_call(Variant *p_variant, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = &VariantInternalAccessor<Callable>::get(p_variant);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2811,6 +2878,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedInt32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedInt32Array, count, sarray("value"), varray());
 	bind_method(PackedInt32Array, erase, sarray("value"), varray());
+	bind_function(PackedInt32Array, elementwise_add, _VariantCall::func_packed_array_elementwise_add<int32_t>, sarray("array"), varray());
+	bind_function(PackedInt32Array, elementwise_multiply, _VariantCall::func_packed_array_elementwise_multiply<int32_t>, sarray("array"), varray());
+	bind_function(PackedInt32Array, elementwise_min, _VariantCall::func_packed_array_elementwise_min<int32_t>, sarray("array"), varray());
+	bind_function(PackedInt32Array, elementwise_max, _VariantCall::func_packed_array_elementwise_max<int32_t>, sarray("array"), varray());
+	bind_function(PackedInt32Array, elementwise_greater, _VariantCall::func_packed_array_elementwise_greater<int32_t>, sarray("value"), varray());
+	bind_function(PackedInt32Array, elementwise_less, _VariantCall::func_packed_array_elementwise_less<int32_t>, sarray("value"), varray());
+	bind_function(PackedInt32Array, sum, _VariantCall::func_packed_array_sum<int32_t>, sarray(), varray());
+	bind_function(PackedInt32Array, dot, _VariantCall::func_packed_array_dot<int32_t>, sarray("array"), varray());
 
 	/* Int64 Array */
 
@@ -2839,6 +2914,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedInt64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedInt64Array, count, sarray("value"), varray());
 	bind_method(PackedInt64Array, erase, sarray("value"), varray());
+	bind_function(PackedInt64Array, elementwise_add, _VariantCall::func_packed_array_elementwise_add<int64_t>, sarray("array"), varray());
+	bind_function(PackedInt64Array, elementwise_multiply, _VariantCall::func_packed_array_elementwise_multiply<int64_t>, sarray("array"), varray());
+	bind_function(PackedInt64Array, elementwise_min, _VariantCall::func_packed_array_elementwise_min<int64_t>, sarray("array"), varray());
+	bind_function(PackedInt64Array, elementwise_max, _VariantCall::func_packed_array_elementwise_max<int64_t>, sarray("array"), varray());
+	bind_function(PackedInt64Array, elementwise_greater, _VariantCall::func_packed_array_elementwise_greater<int64_t>, sarray("value"), varray());
+	bind_function(PackedInt64Array, elementwise_less, _VariantCall::func_packed_array_elementwise_less<int64_t>, sarray("value"), varray());
+	bind_function(PackedInt64Array, sum, _VariantCall::func_packed_array_sum<int64_t>, sarray(), varray());
+	bind_function(PackedInt64Array, dot, _VariantCall::func_packed_array_dot<int64_t>, sarray("array"), varray());
 
 	/* Float32 Array */
 
@@ -2867,6 +2950,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat32Array, elementwise_add, _VariantCall::func_packed_array_elementwise_add<float>, sarray("array"), varray());
+	bind_function(PackedFloat32Array, elementwise_multiply, _VariantCall::func_packed_array_elementwise_multiply<float>, sarray("array"), varray());
+	bind_function(PackedFloat32Array, elementwise_min, _VariantCall::func_packed_array_elementwise_min<float>, sarray("array"), varray());
+	bind_function(PackedFloat32Array, elementwise_max, _VariantCall::func_packed_array_elementwise_max<float>, sarray("array"), varray());
+	bind_function(PackedFloat32Array, elementwise_greater, _VariantCall::func_packed_array_elementwise_greater<float>, sarray("value"), varray());
+	bind_function(PackedFloat32Array, elementwise_less, _VariantCall::func_packed_array_elementwise_less<float>, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_packed_array_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_packed_array_dot<float>, sarray("array"), varray());
 
 	/* Float64 Array */
 
@@ -2895,6 +2986,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
 	bind_method(PackedFloat64Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat64Array, elementwise_add, _VariantCall::func_packed_array_elementwise_add<double>, sarray("array"), varray());
+	bind_function(PackedFloat64Array, elementwise_multiply, _VariantCall::func_packed_array_elementwise_multiply<double>, sarray("array"), varray());
+	bind_function(PackedFloat64Array, elementwise_min, _VariantCall::func_packed_array_elementwise_min<double>, sarray("array"), varray());
+	bind_function(PackedFloat64Array, elementwise_max, _VariantCall::func_packed_array_elementwise_max<double>, sarray("array"), varray());
+	bind_function(PackedFloat64Array, elementwise_greater, _VariantCall::func_packed_array_elementwise_greater<double>, sarray("value"), varray());
+	bind_function(PackedFloat64Array, elementwise_less, _VariantCall::func_packed_array_elementwise_less<double>, sarray("value"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_packed_array_sum<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_packed_array_dot<double>, sarray("array"), varray());
 
 	/* String Array */
 
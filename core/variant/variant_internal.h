@@ -558,6 +558,11 @@ public:
 	_FORCE_INLINE_ static Variant make(const T &p_variant) {
 		return Variant(p_variant);
 	}
+	// Returned packed arrays are moved into the Variant instead of being referenced again.
+	template <typename T>
+	_FORCE_INLINE_ static Variant make(Vector<T> &&p_variant) {
+		return Variant(std::move(p_variant));
+	}
 	template <typename T>
 	_FORCE_INLINE_ static Variant make(const GDExtensionPtr<T> &p_variant) {
 		return p_variant.operator Variant();
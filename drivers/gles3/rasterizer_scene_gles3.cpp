@@ -207,7 +207,8 @@ void RasterizerSceneGLES3::_geometry_instance_dependency_changed(Dependency::Dep
 			static_cast<RenderGeometryInstance *>(p_tracker->userdata)->_mark_dirty();
 			static_cast<GeometryInstanceGLES3 *>(p_tracker->userdata)->data->dirty_dependencies = true;
 		} break;
-		case Dependency::DEPENDENCY_CHANGED_MULTIMESH_VISIBLE_INSTANCES: {
+		case Dependency::DEPENDENCY_CHANGED_MULTIMESH_VISIBLE_INSTANCES:
+		case Dependency::DEPENDENCY_CHANGED_MULTIMESH_CULLED_INSTANCES: {
 			GeometryInstanceGLES3 *ginstance = static_cast<GeometryInstanceGLES3 *>(p_tracker->userdata);
 			if (ginstance->data->base_type == RSE::INSTANCE_MULTIMESH) {
 				ginstance->instance_count = GLES3::MeshStorage::get_singleton()->multimesh_get_instances_to_draw(ginstance->data->base);
@@ -32,6 +32,7 @@
 
 #ifdef GLES3_ENABLED
 
+#include "core/config/project_settings.h"
 #include "drivers/gles3/storage/config.h"
 #include "drivers/gles3/storage/texture_storage.h"
 #include "drivers/gles3/storage/utilities.h"
@@ -49,6 +50,8 @@ MeshStorage *MeshStorage::get_singleton() {
 MeshStorage::MeshStorage() {
 	singleton = this;
 
+	multimesh_chunk_culling = GLOBAL_GET("rendering/limits/multimesh/chunk_culling");
+
 	{
 		skeleton_shader.shader.initialize();
 		skeleton_shader.shader_version = skeleton_shader.shader.version_create();
@@ -1626,6 +1629,9 @@ void MeshStorage::_multimesh_allocate_data(RID p_multimesh, int p_instances, RSE
 	multimesh->aabb = AABB();
 	multimesh->aabb_dirty = false;
 	multimesh->visible_instances = MIN(multimesh->visible_instances, multimesh->instances);
+	multimesh->chunk_aabbs.clear();
+	multimesh->chunk_uploaded.clear();
+	multimesh->chunk_cull_instances = -1;
 
 	if (multimesh->instances) {
 		uint32_t buffer_size = multimesh->instances * multimesh->stride_cache * sizeof(float);
@@ -1723,6 +1729,8 @@ void MeshStorage::_multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool
 		multimesh->aabb_dirty = true;
 	}
 
+	multimesh->chunk_cull_dirty = true;
+
 	if (!multimesh->dirty) {
 		multimesh->dirty_list = multimesh_dirty_list;
 		multimesh_dirty_list = multimesh;
@@ -1746,6 +1754,8 @@ void MeshStorage::_multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, b
 		multimesh->aabb_dirty = true;
 	}
 
+	multimesh->chunk_cull_dirty = true;
+
 	if (!multimesh->dirty) {
 		multimesh->dirty_list = multimesh_dirty_list;
 		multimesh_dirty_list = multimesh;
@@ -2047,53 +2057,52 @@ void MeshStorage::_multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_
 		old_stride += multimesh->uses_custom_data ? 4 : 0;
 		ERR_FAIL_COND(p_buffer.size() != (multimesh->instances * (int)old_stride));
 
-		multimesh->data_cache = p_buffer;
-
+		// Pack straight from the caller's buffer so it is never shared with, and then forked by, the cache.
+		const float *r = p_buffer.ptr();
 		float *w = multimesh->data_cache.ptrw();
 
 		for (int i = 0; i < multimesh->instances; i++) {
 			{
-				float *dataptr = w + i * old_stride;
+				const float *dataptr = r + i * old_stride;
 				float *newptr = w + i * multimesh->stride_cache;
 				float vals[8] = { dataptr[0], dataptr[1], dataptr[2], dataptr[3], dataptr[4], dataptr[5], dataptr[6], dataptr[7] };
 				memcpy(newptr, vals, 8 * 4);
 			}
 
 			if (multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_3D) {
-				float *dataptr = w + i * old_stride + 8;
+				const float *dataptr = r + i * old_stride + 8;
 				float *newptr = w + i * multimesh->stride_cache + 8;
 				float vals[8] = { dataptr[0], dataptr[1], dataptr[2], dataptr[3] };
 				memcpy(newptr, vals, 4 * 4);
 			}
 
 			if (multimesh->uses_colors) {
-				float *dataptr = w + i * old_stride + (multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_2D ? 8 : 12);
+				const float *dataptr = r + i * old_stride + (multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_2D ? 8 : 12);
 				float *newptr = w + i * multimesh->stride_cache + multimesh->color_offset_cache;
 				uint16_t val[4] = { Math::make_half_float(dataptr[0]), Math::make_half_float(dataptr[1]), Math::make_half_float(dataptr[2]), Math::make_half_float(dataptr[3]) };
 				memcpy(newptr, val, 2 * 4);
 			}
 			if (multimesh->uses_custom_data) {
-				float *dataptr = w + i * old_stride + (multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_2D ? 8 : 12) + (multimesh->uses_colors ? 4 : 0);
+				const float *dataptr = r + i * old_stride + (multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_2D ? 8 : 12) + (multimesh->uses_colors ? 4 : 0);
 				float *newptr = w + i * multimesh->stride_cache + multimesh->custom_data_offset_cache;
 				uint16_t val[4] = { Math::make_half_float(dataptr[0]), Math::make_half_float(dataptr[1]), Math::make_half_float(dataptr[2]), Math::make_half_float(dataptr[3]) };
 				memcpy(newptr, val, 2 * 4);
 			}
 		}
 
-		multimesh->data_cache.resize(multimesh->instances * (int)multimesh->stride_cache);
-		const float *r = multimesh->data_cache.ptr();
 		glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer[buffer_index]);
-		glBufferData(GL_ARRAY_BUFFER, multimesh->data_cache.size() * sizeof(float), r, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, multimesh->data_cache.size() * sizeof(float), multimesh->data_cache.ptr(), GL_STATIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	} else {
+		ERR_FAIL_COND(p_buffer.size() != (multimesh->instances * (int)multimesh->stride_cache));
+
 		// If we have a data cache, just update it.
 		if (multimesh->data_cache.size()) {
-			multimesh->data_cache = p_buffer;
+			memcpy(multimesh->data_cache.ptrw(), p_buffer.ptr(), p_buffer.size() * sizeof(float));
 		}
 
 		// Only Transform is being used, so we can upload directly.
-		ERR_FAIL_COND(p_buffer.size() != (multimesh->instances * (int)multimesh->stride_cache));
 		const float *r = p_buffer.ptr();
 		glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer[buffer_index]);
 		glBufferData(GL_ARRAY_BUFFER, p_buffer.size() * sizeof(float), r, GL_STATIC_DRAW);
@@ -2283,7 +2292,9 @@ void MeshStorage::_update_dirty_multimesh(MultiMesh *p_multimesh, bool p_uses_mo
 
 			GLint region_size = p_multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
 
-			if (p_multimesh->data_cache_used_dirty_regions > 32 || p_multimesh->data_cache_used_dirty_regions > visible_region_count / 2 || p_uses_motion_vectors) {
+			if (p_multimesh->chunk_cull_instances >= 0 && !p_uses_motion_vectors) {
+				// The buffer holds culled chunks, update_multimesh_chunks() uploads them again from the data cache.
+			} else if (p_multimesh->data_cache_used_dirty_regions > 32 || p_multimesh->data_cache_used_dirty_regions > visible_region_count / 2 || p_uses_motion_vectors) {
 				// If there are too many dirty regions, the dirty regions represent the majority of visible regions, or motion vectors are used:
 				// Just copy all, else transfer cost piles up too much.
 				glBindBuffer(GL_ARRAY_BUFFER, p_multimesh->buffer[p_multimesh->current_buffer]);
@@ -2313,14 +2324,158 @@ void MeshStorage::_update_dirty_multimesh(MultiMesh *p_multimesh, bool p_uses_mo
 
 		if (p_multimesh->aabb_dirty && p_multimesh->mesh.is_valid()) {
 			p_multimesh->aabb_dirty = false;
+			bool chunks = multimesh_chunk_culling && p_multimesh->xform_format == RSE::MULTIMESH_TRANSFORM_3D;
+			if (chunks) {
+				_multimesh_compute_chunk_aabbs(data, p_multimesh->stride_cache, visible_instances, mesh_get_aabb(p_multimesh->mesh), p_multimesh->chunk_aabbs);
+			}
 			if (p_multimesh->custom_aabb == AABB()) {
-				_multimesh_re_create_aabb(p_multimesh, data, visible_instances);
+				if (chunks) {
+					// Same result as recreating it from the instances.
+					p_multimesh->aabb = AABB();
+					for (uint32_t i = 0; i < p_multimesh->chunk_aabbs.size(); i++) {
+						if (i == 0) {
+							p_multimesh->aabb = p_multimesh->chunk_aabbs[i];
+						} else {
+							p_multimesh->aabb.merge_with(p_multimesh->chunk_aabbs[i]);
+						}
+					}
+				} else {
+					_multimesh_re_create_aabb(p_multimesh, data, visible_instances);
+				}
 				p_multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
 			}
 		}
 	}
 }
 
+void MeshStorage::multimesh_cull_chunks(RID p_multimesh, const Transform3D &p_transform, const Vector<Plane> &p_planes) {
+	if (!multimesh_chunk_culling) {
+		return;
+	}
+
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+
+	// Motion vectors read the previous buffer by instance index, so it can't be compacted.
+	if (multimesh->xform_format != RSE::MULTIMESH_TRANSFORM_3D || multimesh->mesh.is_null() || RSG::viewport->get_num_viewports_with_motion_vectors() > 0) {
+		return;
+	}
+
+	uint32_t visible_instances = multimesh->visible_instances >= 0 ? multimesh->visible_instances : multimesh->instances;
+	if (visible_instances <= MULTIMESH_CULL_CHUNK_SIZE) {
+		return;
+	}
+
+	if (multimesh->data_cache.is_empty()) {
+		// Chunks are compacted from the CPU copy of the instances, so keep one from now on.
+		_multimesh_make_local(multimesh);
+		_multimesh_mark_all_dirty(multimesh, false, true);
+	}
+
+	if (multimesh->dirty) {
+		_update_dirty_multimeshes();
+	}
+
+	if (multimesh->chunk_aabbs.size() != Math::division_round_up(visible_instances, MULTIMESH_CULL_CHUNK_SIZE)) {
+		return;
+	}
+
+	if (multimesh->chunk_cull_pass != multimesh_chunk_cull_pass) {
+		multimesh->chunk_cull_pass = multimesh_chunk_cull_pass;
+		multimesh->chunk_visible.resize_initialized(multimesh->chunk_aabbs.size());
+		memset(multimesh->chunk_visible.ptr(), 0, multimesh->chunk_visible.size());
+
+		if (!multimesh->chunk_cull_listed) {
+			multimesh->chunk_cull_listed = true;
+			multimesh_chunk_cull_list.push_back(p_multimesh);
+		}
+	}
+
+	_multimesh_cull_chunk_aabbs(multimesh->chunk_aabbs, p_transform, p_planes, multimesh->chunk_visible);
+}
+
+void MeshStorage::update_multimesh_chunks() {
+	for (uint32_t i = 0; i < multimesh_chunk_cull_list.size(); i++) {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(multimesh_chunk_cull_list[i]);
+
+		if (multimesh != nullptr && multimesh->chunk_cull_pass == multimesh_chunk_cull_pass) {
+			_multimesh_upload_chunks(multimesh);
+			continue;
+		}
+
+		if (multimesh != nullptr) {
+			// Not culled in this pass, so it may be drawn from anywhere.
+			_multimesh_restore_chunks(multimesh);
+			multimesh->chunk_cull_listed = false;
+		}
+
+		multimesh_chunk_cull_list.remove_at_unordered(i);
+		i--;
+	}
+
+	multimesh_chunk_cull_pass++;
+}
+
+void MeshStorage::_multimesh_upload_chunks(MultiMesh *multimesh) {
+	uint32_t chunk_count = multimesh->chunk_visible.size();
+	if (!multimesh->chunk_cull_dirty && multimesh->chunk_uploaded.size() == chunk_count && memcmp(multimesh->chunk_uploaded.ptr(), multimesh->chunk_visible.ptr(), chunk_count) == 0) {
+		return; // Same chunks as last time.
+	}
+
+	uint32_t visible_instances = multimesh->visible_instances >= 0 ? multimesh->visible_instances : multimesh->instances;
+	uint32_t stride = multimesh->stride_cache * sizeof(float);
+	const uint8_t *data = (const uint8_t *)multimesh->data_cache.ptr();
+	bool compacted = multimesh->chunk_cull_instances >= 0;
+	uint32_t instance_count = 0;
+
+	// Move the visible chunks to the front of the buffer, uploading consecutive chunks at once.
+	glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer[multimesh->current_buffer]);
+	uint32_t i = 0;
+	while (i < chunk_count) {
+		if (!multimesh->chunk_visible[i]) {
+			i++;
+			continue;
+		}
+
+		uint32_t from = i * MULTIMESH_CULL_CHUNK_SIZE;
+		while (i < chunk_count && multimesh->chunk_visible[i]) {
+			i++;
+		}
+		uint32_t count = MIN(i * MULTIMESH_CULL_CHUNK_SIZE, visible_instances) - from;
+
+		if (compacted || from != instance_count) { // Otherwise it's already in place.
+			glBufferSubData(GL_ARRAY_BUFFER, instance_count * stride, count * stride, data + from * stride);
+		}
+		instance_count += count;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	multimesh->chunk_uploaded = multimesh->chunk_visible;
+	multimesh->chunk_cull_dirty = false;
+
+	if (multimesh->chunk_cull_instances != int(instance_count)) {
+		multimesh->chunk_cull_instances = instance_count;
+		multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MULTIMESH_CULLED_INSTANCES);
+	}
+}
+
+void MeshStorage::_multimesh_restore_chunks(MultiMesh *multimesh) {
+	if (multimesh->chunk_cull_instances < 0) {
+		return;
+	}
+
+	uint32_t visible_instances = multimesh->visible_instances >= 0 ? multimesh->visible_instances : multimesh->instances;
+	if (!multimesh->data_cache.is_empty() && visible_instances > 0) {
+		glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer[multimesh->current_buffer]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, visible_instances * multimesh->stride_cache * sizeof(float), multimesh->data_cache.ptr());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	multimesh->chunk_uploaded.clear();
+	multimesh->chunk_cull_instances = -1;
+	multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MULTIMESH_CULLED_INSTANCES);
+}
+
 void GLES3::MeshStorage::multimesh_vertex_attrib_setup(GLuint p_instance_buffer, uint32_t p_stride, bool p_uses_format_2d, bool p_has_color_or_custom_data, int p_attrib_base_index) {
 	glBindBuffer(GL_ARRAY_BUFFER, p_instance_buffer);
 
@@ -215,6 +215,15 @@ struct MultiMesh {
 	int prev_buffer = 0;
 	uint64_t last_change = 0;
 
+	// Chunk culling, the buffer holds only the visible chunks when chunk_cull_instances is not -1.
+	LocalVector<AABB> chunk_aabbs;
+	LocalVector<uint8_t> chunk_visible;
+	LocalVector<uint8_t> chunk_uploaded;
+	uint64_t chunk_cull_pass = 0;
+	int chunk_cull_instances = -1;
+	bool chunk_cull_dirty = false;
+	bool chunk_cull_listed = false;
+
 	bool dirty = false;
 	MultiMesh *dirty_list = nullptr;
 
@@ -273,10 +282,16 @@ private:
 
 	MultiMesh *multimesh_dirty_list = nullptr;
 
+	bool multimesh_chunk_culling = false;
+	uint64_t multimesh_chunk_cull_pass = 1;
+	LocalVector<RID> multimesh_chunk_cull_list;
+
 	_FORCE_INLINE_ void _multimesh_make_local(MultiMesh *multimesh) const;
 	_FORCE_INLINE_ void _multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances);
+	void _multimesh_upload_chunks(MultiMesh *multimesh);
+	void _multimesh_restore_chunks(MultiMesh *multimesh);
 
 	/* Skeleton */
 
@@ -561,6 +576,10 @@ public:
 
 	virtual MultiMeshInterpolator *_multimesh_get_interpolator(RID p_multimesh) const override;
 
+	virtual bool multimesh_has_chunk_culling() const override { return true; }
+	virtual void multimesh_cull_chunks(RID p_multimesh, const Transform3D &p_transform, const Vector<Plane> &p_planes) override;
+	virtual void update_multimesh_chunks() override;
+
 	void _update_dirty_multimeshes();
 	void _update_dirty_multimesh(MultiMesh *p_multimesh, bool p_uses_motion_vectors);
 
@@ -587,6 +606,9 @@ public:
 	_FORCE_INLINE_ uint32_t multimesh_get_instances_to_draw(RID p_multimesh) const {
 		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 		ERR_FAIL_NULL_V(multimesh, 0);
+		if (multimesh->chunk_cull_instances >= 0) {
+			return multimesh->chunk_cull_instances;
+		}
 		if (multimesh->visible_instances >= 0) {
 			return multimesh->visible_instances;
 		}
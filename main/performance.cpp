@@ -32,8 +32,11 @@
 #include "performance.compat.inc"
 
 #include "core/config/engine.h"
+#include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/os/small_object_allocator.h"
+#include "core/templates/frame_arena.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -135,6 +138,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_HEAP_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_RESERVED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -230,6 +236,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/frame_arena_allocations"),
+		PNAME("memory/frame_arena_heap_allocations"),
+		PNAME("memory/frame_arena_reserved"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -454,6 +463,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case MEMORY_FRAME_ARENA_ALLOCATIONS:
+			return FrameArena::get_last_frame_allocation_count();
+		case MEMORY_FRAME_ARENA_HEAP_ALLOCATIONS:
+			return FrameArena::get_last_frame_block_allocation_count();
+		case MEMORY_FRAME_ARENA_RESERVED:
+			return FrameArena::get_reserved_bytes();
 
 		default: {
 		}
@@ -527,7 +542,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -603,12 +620,35 @@ uint64_t Performance::get_monitor_modification_time() {
 	return _monitor_modification_time;
 }
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+uint64_t Performance::_get_small_object_used_bytes(uint32_t p_size_class) const {
+	const SmallObjectAllocator::SizeClassStats stats = SmallObjectAllocator::get_size_class_stats(p_size_class);
+	return stats.used_blocks * stats.block_size;
+}
+
+uint64_t Performance::_get_small_object_reserved_bytes() const {
+	return SmallObjectAllocator::get_reserved_bytes();
+}
+
+void Performance::_add_small_object_monitors() {
+	add_custom_monitor("small_object_allocator/reserved", callable_mp(this, &Performance::_get_small_object_reserved_bytes), Vector<Variant>(), MONITOR_TYPE_MEMORY);
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		const SmallObjectAllocator::SizeClassStats stats = SmallObjectAllocator::get_size_class_stats(i);
+		add_custom_monitor(vformat("small_object_allocator/used_%d_bytes", (uint64_t)stats.block_size), callable_mp(this, &Performance::_get_small_object_used_bytes).bind(i), Vector<Variant>(), MONITOR_TYPE_MEMORY);
+	}
+}
+#endif
+
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_navigation_process_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	_add_small_object_monitors();
+#endif
 }
 
 Performance::MonitorCall::MonitorCall(Performance::MonitorType p_type, const Callable &p_callable, const Vector<Variant> &p_arguments) {
@@ -53,6 +53,11 @@ class Performance : public Object {
 
 	int _get_node_count() const;
 	int _get_orphan_node_count() const;
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	uint64_t _get_small_object_used_bytes(uint32_t p_size_class) const;
+	uint64_t _get_small_object_reserved_bytes() const;
+	void _add_small_object_monitors();
+#endif
 
 	double _process_time;
 	double _physics_process_time;
@@ -122,6 +127,9 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		MEMORY_FRAME_ARENA_ALLOCATIONS,
+		MEMORY_FRAME_ARENA_HEAP_ALLOCATIONS,
+		MEMORY_FRAME_ARENA_RESERVED,
 		MONITOR_MAX
 	};
 
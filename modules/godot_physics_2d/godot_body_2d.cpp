@@ -147,6 +147,9 @@ void GodotBody2D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// Sleeping rigid bodies are moved out of the dynamic broadphase tree.
+	_set_sleeping(!active && mode > PS2DE::BODY_MODE_KINEMATIC);
 }
 
 void GodotBody2D::set_param(PS2DE::BodyParameter p_param, const Variant &p_value) {
@@ -260,6 +263,7 @@ void GodotBody2D::set_mode(PS2DE::BodyMode p_mode) {
 			_set_inv_transform(get_transform().affine_inverse());
 			_inv_mass = 0;
 			_inv_inertia = 0;
+			_set_sleeping(false);
 			_set_static(p_mode == PS2DE::BODY_MODE_STATIC);
 			set_active(p_mode == PS2DE::BODY_MODE_KINEMATIC && contacts.size());
 			linear_velocity = Vector2();
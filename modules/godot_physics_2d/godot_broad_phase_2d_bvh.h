@@ -54,17 +54,22 @@ class GodotBroadPhase2DBVH : public GodotBroadPhase2D {
 		}
 	};
 
+	// Sleeping bodies are kept out of the dynamic tree, so it only contains objects that move
+	// and stays small and well balanced. Pairing masks still include the sleeping tree,
+	// so existing pairs (contacts, area overlaps) are preserved when a body falls asleep.
 	enum Tree {
 		TREE_STATIC = 0,
 		TREE_DYNAMIC = 1,
+		TREE_SLEEPING = 2,
 	};
 
 	enum TreeFlag {
 		TREE_FLAG_STATIC = 1 << TREE_STATIC,
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
+		TREE_FLAG_SLEEPING = 1 << TREE_SLEEPING,
 	};
 
-	BVH_Manager<GodotCollisionObject2D, 2, true, 128, UserPairTestFunction<GodotCollisionObject2D>, UserCullTestFunction<GodotCollisionObject2D>, Rect2, Vector2> bvh;
+	BVH_Manager<GodotCollisionObject2D, 3, true, 128, UserPairTestFunction<GodotCollisionObject2D>, UserCullTestFunction<GodotCollisionObject2D>, Rect2, Vector2> bvh;
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject2D *, int, uint32_t, GodotCollisionObject2D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject2D *, int, uint32_t, GodotCollisionObject2D *, int, void *);
@@ -79,6 +84,7 @@ public:
 	virtual ID create(GodotCollisionObject2D *p_object, int p_subindex = 0, const Rect2 &p_aabb = Rect2(), bool p_static = false) override;
 	virtual void move(ID p_id, const Rect2 &p_aabb) override;
 	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void set_sleeping(ID p_id, bool p_sleeping) override;
 	virtual void remove(ID p_id) override;
 
 	virtual GodotCollisionObject2D *get_object(ID p_id) const override;
@@ -188,6 +188,9 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// Sleeping rigid bodies are moved out of the dynamic broadphase tree.
+	_set_sleeping(!active && mode > PS3DE::BODY_MODE_KINEMATIC);
 }
 
 void GodotBody3D::set_param(PS3DE::BodyParameter p_param, const Variant &p_value) {
@@ -306,6 +309,7 @@ void GodotBody3D::set_mode(PS3DE::BodyMode p_mode) {
 			_set_inv_transform(get_transform().affine_inverse());
 			_inv_mass = 0;
 			_inv_inertia = Vector3();
+			_set_sleeping(false);
 			_set_static(p_mode == PS3DE::BODY_MODE_STATIC);
 			set_active(p_mode == PS3DE::BODY_MODE_KINEMATIC && contacts.size());
 			linear_velocity = Vector3();
@@ -737,6 +741,13 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody3D::set_time_of_impact_transform(const Transform3D &p_transform) {
+	_set_transform(p_transform);
+	_set_inv_transform(p_transform.inverse());
+
+	_update_transform_dependent();
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -319,6 +319,7 @@ public:
 
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void set_time_of_impact_transform(const Transform3D &p_transform);
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -299,6 +299,11 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	if (!collided) {
+		if (space->is_ccd_time_of_impact_enabled()) {
+			// Fast bodies are handled by the time of impact stage after integration.
+			return false;
+		}
+
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
 			return true;
@@ -34,7 +34,7 @@
 
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
@@ -47,10 +47,19 @@ void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
 }
 
+void GodotBroadPhase3DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	if (bvh.get_tree_id(p_id - 1) == TREE_STATIC) {
+		return; // Static objects stay in the static tree.
+	}
+	uint32_t tree_id = p_sleeping ? TREE_SLEEPING : TREE_DYNAMIC;
+	bvh.set_tree(p_id - 1, tree_id, TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING, false);
+}
+
 void GodotBroadPhase3DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
 	bvh.erase(p_id - 1);
@@ -74,6 +74,7 @@ private:
 	Transform3D transform;
 	Transform3D inv_transform;
 	bool _static = true;
+	bool _sleeping = false;
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
@@ -96,6 +97,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform3D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace3D *p_space);
@@ -576,6 +576,13 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		}
 
 		concave_B->cull(local_aabb, concave_distance_callback, &cinfo, false);
+		if (!cinfo.collided && !cinfo.tested) {
+			// No face near A, measure against the whole shape rather than returning no points.
+			concave_B->cull(concave_B->get_aabb(), concave_distance_callback, &cinfo, false);
+			if (!cinfo.collided && !cinfo.tested) {
+				return false;
+			}
+		}
 		if (!cinfo.collided) {
 			r_point_A = cinfo.close_A;
 			r_point_B = cinfo.close_B;
@@ -586,3 +593,96 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		return gjk_epa_calculate_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, r_point_A, r_point_B); //should pass sepaxis..
 	}
 }
+
+bool GodotCollisionSolver3D::concave_any_face_callback(void *p_userdata, GodotShape3D *p_convex) {
+	*static_cast<bool *>(p_userdata) = true;
+	return true; // Stop at the first face.
+}
+
+// Conservative advancement: shape A starts at `p_transform_A`, moves its pivot by `p_motion_A` and rotates
+// around it by `p_rotation_A` (axis scaled by angle) over the whole motion, while shape B moves linearly
+// by `p_motion_B`. Returns true if they come within `p_tolerance` of each other, `r_toi` being the fraction
+// of the motion at which it happens. Shapes which already overlap or touch at the start are ignored,
+// they are left to the contact solver.
+bool GodotCollisionSolver3D::solve_time_of_impact(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Vector3 &p_pivot_A, const Vector3 &p_motion_A, const Vector3 &p_rotation_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, const Vector3 &p_motion_B, real_t p_tolerance, real_t &r_toi) {
+	static const int max_iterations = 16;
+
+	if (p_shape_A->is_concave() || p_shape_A->get_type() == PS3DE::SHAPE_WORLD_BOUNDARY) {
+		return false;
+	}
+
+	// Rotation preserves distances to the pivot, so this bounds every point of A during the whole motion.
+	AABB aabb_A = p_transform_A.xform(p_shape_A->get_aabb());
+	real_t radius_A = 0.0;
+	for (int i = 0; i < 8; i++) {
+		radius_A = MAX(radius_A, aabb_A.get_endpoint(i).distance_to(p_pivot_A));
+	}
+
+	real_t angle_A = p_rotation_A.length();
+	Vector3 axis_A = angle_A > CMP_EPSILON ? p_rotation_A / angle_A : Vector3();
+	Vector3 relative_motion = p_motion_A - p_motion_B;
+
+	// Region swept by A relative to B, placed at B's start; it moves along with B during the iterations.
+	AABB concave_hint = AABB(p_pivot_A - Vector3(radius_A, radius_A, radius_A), Vector3(radius_A, radius_A, radius_A) * 2.0);
+	concave_hint.merge_with(AABB(concave_hint.position + relative_motion, concave_hint.size));
+
+	if (p_shape_B->is_concave()) {
+		// Nothing to hit when no face lies in the swept region. This also avoids measuring against the whole shape.
+		bool has_faces = false;
+		static_cast<const GodotConcaveShape3D *>(p_shape_B)->cull(p_transform_B.affine_inverse().xform(concave_hint), concave_any_face_callback, &has_faces, false);
+		if (!has_faces) {
+			return false;
+		}
+	}
+
+	Vector3 offset_A = p_transform_A.origin - p_pivot_A;
+	Vector3 sep_axis = relative_motion.normalized();
+
+	real_t toi = 0.0;
+	for (int i = 0; i < max_iterations; i++) {
+		Transform3D xform_A = p_transform_A;
+		if (angle_A > CMP_EPSILON) {
+			Basis rot(axis_A, angle_A * toi);
+			xform_A.basis = rot * p_transform_A.basis;
+			xform_A.origin = p_pivot_A + rot.xform(offset_A);
+		}
+		xform_A.origin += p_motion_A * toi;
+		Transform3D xform_B = p_transform_B.translated(p_motion_B * toi);
+		AABB xform_concave_hint = AABB(concave_hint.position + p_motion_B * toi, concave_hint.size);
+
+		Vector3 point_A, point_B;
+		if (!solve_distance(p_shape_A, xform_A, p_shape_B, xform_B, point_A, point_B, xform_concave_hint, &sep_axis)) {
+			if (i == 0) {
+				return false; // Initial overlap.
+			}
+			r_toi = toi;
+			return true;
+		}
+
+		Vector3 delta = point_B - point_A;
+		real_t distance = delta.length();
+		if (distance <= p_tolerance) {
+			if (i == 0) {
+				return false; // Already touching.
+			}
+			r_toi = toi;
+			return true;
+		}
+
+		// Upper bound of the speed at which any point of A approaches B along the separating direction.
+		real_t approach_speed = relative_motion.dot(delta / distance) + angle_A * radius_A;
+		if (approach_speed <= CMP_EPSILON) {
+			return false; // Moving apart.
+		}
+
+		// Never step past the point where they could get closer than half the tolerance.
+		toi += (distance - p_tolerance * 0.5) / approach_speed;
+		if (toi >= 1.0) {
+			return false;
+		}
+	}
+
+	// Didn't converge, the time reached so far is still guaranteed to be free of collisions.
+	r_toi = toi;
+	return true;
+}
@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1688,6 +1690,11 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 
 void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
+	step_spaces_in_parallel = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	space_steppers[p_index]->step(spaces_to_step[p_index], parallel_step_delta);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1700,8 +1707,38 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
-	for (GodotSpace3D *E : active_spaces) {
-		stepper->step(E, p_step);
+
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	if (step_spaces_in_parallel && active_spaces.size() > 1 && thread_count > 1) {
+		spaces_to_step.clear();
+		for (GodotSpace3D *E : active_spaces) {
+			spaces_to_step.push_back(E);
+		}
+
+		const uint32_t space_count = spaces_to_step.size();
+		while (space_steppers.size() < space_count) {
+			space_steppers.push_back(memnew(GodotStep3D));
+		}
+
+		// Throttle the parallelism inside each space, so the threads blocked waiting on a space's
+		// internal stages always leave free threads to process them.
+		const int space_tasks = MIN((int)space_count, thread_count);
+		const int free_threads = thread_count - space_tasks;
+		const int tasks_per_space = free_threads / space_tasks;
+		for (uint32_t i = 0; i < space_count; i++) {
+			space_steppers[i]->set_max_tasks(tasks_per_space);
+		}
+
+		parallel_step_delta = p_step;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, (void *)nullptr, space_count, space_tasks, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (GodotSpace3D *E : active_spaces) {
+			stepper->step(E, p_step);
+		}
+	}
+
+	for (const GodotSpace3D *E : active_spaces) {
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1768,6 +1805,10 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *space_stepper : space_steppers) {
+		memdelete(space_stepper);
+	}
+	space_steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(PS3DE::ProcessInfo p_info) {
@@ -1781,6 +1822,10 @@ int GodotPhysicsServer3D::get_process_info(PS3DE::ProcessInfo p_info) {
 		case PS3DE::INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case PS3DE::INFO_TEMP_MEMORY_PEAK:
+		case PS3DE::INFO_TEMP_MEMORY_CAPACITY: {
+			return 0;
+		} break;
 	}
 
 	return 0;
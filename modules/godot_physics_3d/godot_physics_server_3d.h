@@ -55,6 +55,13 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GodotStep3D *stepper = nullptr;
 	HashSet<GodotSpace3D *> active_spaces;
 
+	// Independent spaces can be stepped concurrently, each with its own stepper.
+	bool step_spaces_in_parallel = false;
+	LocalVector<GodotStep3D *> space_steppers;
+	LocalVector<GodotSpace3D *> spaces_to_step;
+	real_t parallel_step_delta = 0.0;
+	void _step_space(uint32_t p_index, void *p_userdata);
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
@@ -1734,18 +1734,23 @@ _FORCE_INLINE_ bool _heightmap_face_cull_segment(_HeightmapSegmentCullParams &p_
 }
 
 _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
+	Vector3 points[4];
+	if (!p_params.heightmap->_get_cell_points(p_state.x, p_state.z, points)) {
+		return false;
+	}
+
 	// First triangle.
-	p_params.heightmap->_get_point(p_state.x, p_state.z, p_params.face->vertex[0]);
-	p_params.heightmap->_get_point(p_state.x + 1, p_state.z, p_params.face->vertex[1]);
-	p_params.heightmap->_get_point(p_state.x, p_state.z + 1, p_params.face->vertex[2]);
+	p_params.face->vertex[0] = points[0];
+	p_params.face->vertex[1] = points[1];
+	p_params.face->vertex[2] = points[2];
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
 		return true;
 	}
 
 	// Second triangle.
-	p_params.face->vertex[0] = p_params.face->vertex[1];
-	p_params.heightmap->_get_point(p_state.x + 1, p_state.z + 1, p_params.face->vertex[1]);
+	p_params.face->vertex[0] = points[1];
+	p_params.face->vertex[1] = points[3];
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
 		return true;
@@ -1755,6 +1760,10 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 }
 
 _FORCE_INLINE_ bool _heightmap_chunk_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
+	if (!p_params.heightmap->_is_chunk_loaded(p_state.x, p_state.z)) {
+		return false;
+	}
+
 	const GodotHeightMapShape3D::Range &chunk = p_params.heightmap->_get_bounds_chunk(p_state.x, p_state.z);
 
 	Vector3 enter_pos;
@@ -1774,8 +1783,8 @@ _FORCE_INLINE_ bool _heightmap_chunk_cull_segment(_HeightmapSegmentCullParams &p
 	}
 
 	// Transform positions to heightmap space.
-	enter_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
-	exit_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
+	enter_pos *= p_params.heightmap->bounds_chunk_size;
+	exit_pos *= p_params.heightmap->bounds_chunk_size;
 
 	// We did enter the flat projection of the AABB,
 	// but we have to check if we intersect it on the vertical axis.
@@ -1931,7 +1940,7 @@ bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process,
 }
 
 bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
-	if (heights.is_empty()) {
+	if (heights.is_empty() && tiles.is_empty()) {
 		return false;
 	}
 
@@ -1972,14 +1981,14 @@ bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vect
 	} else {
 		Vector3 ray_diff = (p_end - p_begin);
 		real_t length_flat_sqr = ray_diff.x * ray_diff.x + ray_diff.z * ray_diff.z;
-		if (length_flat_sqr < BOUNDS_CHUNK_SIZE * BOUNDS_CHUNK_SIZE) {
+		if (length_flat_sqr < bounds_chunk_size * bounds_chunk_size) {
 			// Don't use chunks, the ray is too short in the plane.
 			return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin, p_end, width, depth, local_origin, r_point, r_normal);
 		} else {
 			// The ray is long, run raycast on a higher-level grid.
-			Vector3 bounds_from = p_begin / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_to = p_end / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_offset = local_origin / BOUNDS_CHUNK_SIZE;
+			Vector3 bounds_from = p_begin / bounds_chunk_size;
+			Vector3 bounds_to = p_end / bounds_chunk_size;
+			Vector3 bounds_offset = local_origin / bounds_chunk_size;
 			// Plus 1 here to width and depth of the chunk because _intersect_grid_segment() is used by cell level as well,
 			// and in _intersect_grid_segment() the loop will exit 1 early because for cell point triangle lookup, it dose x + 1, z + 1 etc for the vertex.
 			int bounds_width = bounds_grid_width + 1;
@@ -2013,7 +2022,7 @@ void GodotHeightMapShape3D::_get_cell(const Vector3 &p_point, int &r_x, int &r_y
 }
 
 void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
-	if (heights.is_empty()) {
+	if (heights.is_empty() && tiles.is_empty()) {
 		return;
 	}
 
@@ -2042,20 +2051,26 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
+	Vector3 points[4];
+
 	for (int z = start_z; z < end_z; z++) {
 		for (int x = start_x; x < end_x; x++) {
+			if (!_get_cell_points(x, z, points)) {
+				continue;
+			}
+
 			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
+			face.vertex[0] = points[0];
+			face.vertex[1] = points[1];
+			face.vertex[2] = points[2];
 			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
 			if (p_callback(p_userdata, &face)) {
 				return;
 			}
 
 			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
+			face.vertex[0] = points[1];
+			face.vertex[1] = points[3];
 			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
 			if (p_callback(p_userdata, &face)) {
 				return;
@@ -2076,6 +2091,7 @@ Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 
 void GodotHeightMapShape3D::_build_accelerator() {
 	bounds_grid.clear();
+	bounds_chunk_size = BOUNDS_CHUNK_SIZE;
 
 	bounds_grid_width = width / BOUNDS_CHUNK_SIZE;
 	bounds_grid_depth = depth / BOUNDS_CHUNK_SIZE;
@@ -2143,15 +2159,63 @@ void GodotHeightMapShape3D::_build_accelerator() {
 	}
 }
 
-void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
-	heights = p_heights;
-	width = p_width;
-	depth = p_depth;
+void GodotHeightMapShape3D::_build_tile_accelerator(const LocalVector<Vector<real_t>> &p_previous_heights, const LocalVector<Range> &p_previous_ranges) {
+	// Every tile is its own chunk, so rays can skip tiles that are not loaded as well.
+	bounds_chunk_size = tile_size;
+	bounds_grid_width = tiles_width;
+	bounds_grid_depth = tiles_depth;
+	bounds_grid.resize(tiles.size());
+
+	const int stride = tile_size + 1;
+
+	for (int tz = 0; tz < tiles_depth; ++tz) {
+		for (int tx = 0; tx < tiles_width; ++tx) {
+			const uint32_t index = tz * tiles_width + tx;
+			const Vector<real_t> &tile_heights = tiles[index].heights;
+
+			Range r;
+
+			if (tile_heights.is_empty()) {
+				bounds_grid[index] = r;
+				continue;
+			}
+
+			// Tiles that are still backed by the same buffer haven't changed, so streaming in
+			// a few tiles doesn't require going over the whole map again.
+			if (index < p_previous_heights.size() && p_previous_heights[index].ptr() == tile_heights.ptr()) {
+				bounds_grid[index] = p_previous_ranges[index];
+				continue;
+			}
+
+			// Tiles on the far edges can extend past the map, the samples out there are ignored.
+			const int x_max = MIN(stride, width - tx * tile_size);
+			const int z_max = MIN(stride, depth - tz * tile_size);
+			const real_t *tile_ptr = tile_heights.ptr();
 
+			r.min = tile_ptr[0];
+			r.max = r.min;
+
+			for (int z = 0; z < z_max; ++z) {
+				for (int x = 0; x < x_max; ++x) {
+					real_t height = tile_ptr[z * stride + x];
+					if (height < r.min) {
+						r.min = height;
+					} else if (height > r.max) {
+						r.max = height;
+					}
+				}
+			}
+
+			bounds_grid[index] = r;
+		}
+	}
+}
+
+void GodotHeightMapShape3D::_configure_heights(real_t p_min_height, real_t p_max_height) {
 	// Initialize aabb.
 	AABB aabb_new;
 	aabb_new.position = Vector3(0.0, p_min_height, 0.0);
-	aabb_new.size = Vector3(p_width - 1, p_max_height - p_min_height, p_depth - 1);
+	aabb_new.size = Vector3(width - 1, p_max_height - p_min_height, depth - 1);
 
 	// Initialize origin as the aabb center.
 	local_origin = aabb_new.position + 0.5 * aabb_new.size;
@@ -2159,9 +2223,105 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 
 	aabb_new.position -= local_origin;
 
+	configure(aabb_new);
+}
+
+void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
+	heights = p_heights;
+	width = p_width;
+	depth = p_depth;
+
+	tiles.clear();
+	tile_size = 0;
+	tiles_width = 0;
+	tiles_depth = 0;
+
 	_build_accelerator();
 
-	configure(aabb_new);
+	_configure_heights(p_min_height, p_max_height);
+}
+
+void GodotHeightMapShape3D::_setup_tiles(const Array &p_tiles, int p_width, int p_depth, int p_tile_size, const Variant &p_min_height, const Variant &p_max_height) {
+	const int tiles_width_new = (p_width - 2) / p_tile_size + 1;
+	const int tiles_depth_new = (p_depth - 2) / p_tile_size + 1;
+	ERR_FAIL_COND_MSG(p_tiles.size() != tiles_width_new * tiles_depth_new, vformat("Expected %d heightmap tiles, got %d.", tiles_width_new * tiles_depth_new, p_tiles.size()));
+
+	const int tile_sample_count = (p_tile_size + 1) * (p_tile_size + 1);
+
+	for (int i = 0; i < p_tiles.size(); ++i) {
+		const Variant &tile_variant = p_tiles[i];
+		if (tile_variant.get_type() == Variant::NIL) {
+			continue;
+		}
+
+#ifdef REAL_T_IS_DOUBLE
+		ERR_FAIL_COND_MSG(tile_variant.get_type() != Variant::PACKED_FLOAT64_ARRAY, "Expected PackedFloat64Array or null for each heightmap tile.");
+#else
+		ERR_FAIL_COND_MSG(tile_variant.get_type() != Variant::PACKED_FLOAT32_ARRAY, "Expected PackedFloat32Array or null for each heightmap tile.");
+#endif
+
+		const Vector<real_t> tile_heights = tile_variant;
+		ERR_FAIL_COND_MSG(!tile_heights.is_empty() && tile_heights.size() != tile_sample_count, vformat("Heightmap tile %d must have %d heights.", i, tile_sample_count));
+	}
+
+	const bool has_height_range = p_min_height.get_type() != Variant::NIL && p_max_height.get_type() != Variant::NIL;
+	ERR_FAIL_COND(has_height_range && (real_t)p_min_height > (real_t)p_max_height);
+
+	LocalVector<Vector<real_t>> previous_heights;
+	LocalVector<Range> previous_ranges;
+	if (tile_size == p_tile_size && width == p_width && depth == p_depth) {
+		previous_heights.resize(tiles.size());
+		for (uint32_t i = 0; i < tiles.size(); ++i) {
+			previous_heights[i] = tiles[i].heights;
+		}
+		previous_ranges = bounds_grid;
+	}
+
+	heights.clear();
+	width = p_width;
+	depth = p_depth;
+
+	tile_size = p_tile_size;
+	tiles_width = tiles_width_new;
+	tiles_depth = tiles_depth_new;
+
+	// Recreating the tiles also clears their usage since the last update.
+	tiles.clear();
+	tiles.resize(p_tiles.size());
+	for (uint32_t i = 0; i < tiles.size(); ++i) {
+		const Variant &tile_variant = p_tiles[i];
+		if (tile_variant.get_type() != Variant::NIL) {
+			tiles[i].heights = tile_variant;
+		}
+	}
+
+	_build_tile_accelerator(previous_heights, previous_ranges);
+
+	// Compute min and max heights from the loaded tiles or use precomputed values.
+	real_t min_height = 0.0;
+	real_t max_height = 0.0;
+	if (has_height_range) {
+		min_height = p_min_height;
+		max_height = p_max_height;
+	} else {
+		// Start from the first loaded tile, so terrain entirely above or below zero keeps a tight AABB.
+		bool has_heights = false;
+		for (uint32_t i = 0; i < tiles.size(); ++i) {
+			if (tiles[i].heights.is_empty()) {
+				continue;
+			}
+			if (!has_heights) {
+				min_height = bounds_grid[i].min;
+				max_height = bounds_grid[i].max;
+				has_heights = true;
+			} else {
+				min_height = MIN(min_height, bounds_grid[i].min);
+				max_height = MAX(max_height, bounds_grid[i].max);
+			}
+		}
+	}
+
+	_configure_heights(min_height, max_height);
 }
 
 void GodotHeightMapShape3D::set_data(const Variant &p_data) {
@@ -2170,7 +2330,6 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	Dictionary d = p_data;
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
-	ERR_FAIL_COND(!d.has("heights"));
 
 	int width_new = d["width"];
 	int depth_new = d["depth"];
@@ -2178,6 +2337,21 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(width_new <= 0.0);
 	ERR_FAIL_COND(depth_new <= 0.0);
 
+	if (d.has("tile_size")) {
+		// Paged heightmap, heights are passed per tile instead of in a single array.
+		ERR_FAIL_COND(!d.has("tiles"));
+		ERR_FAIL_COND(d["tiles"].get_type() != Variant::ARRAY);
+
+		int tile_size_new = d["tile_size"];
+		ERR_FAIL_COND(tile_size_new <= 0);
+		ERR_FAIL_COND(width_new < 2 || depth_new < 2);
+
+		_setup_tiles(d["tiles"], width_new, depth_new, tile_size_new, d.get("min_height", Variant()), d.get("max_height", Variant()));
+		return;
+	}
+
+	ERR_FAIL_COND(!d.has("heights"));
+
 	Variant heights_variant = d["heights"];
 	Vector<real_t> heights_buffer;
 #ifdef REAL_T_IS_DOUBLE
@@ -2245,7 +2419,34 @@ Variant GodotHeightMapShape3D::get_data() const {
 	d["min_height"] = shape_aabb.position.y;
 	d["max_height"] = shape_aabb.position.y + shape_aabb.size.y;
 
-	d["heights"] = heights;
+	if (!_is_paged()) {
+		d["heights"] = heights;
+		return d;
+	}
+
+	Array tiles_array;
+	PackedInt32Array requested_tiles;
+	PackedInt32Array unused_tiles;
+
+	tiles_array.resize(tiles.size());
+	for (uint32_t i = 0; i < tiles.size(); ++i) {
+		const Tile &tile = tiles[i];
+		if (tile.heights.is_empty()) {
+			if (tile.used.is_set()) {
+				requested_tiles.push_back(i);
+			}
+		} else {
+			tiles_array[i] = tile.heights;
+			if (!tile.used.is_set()) {
+				unused_tiles.push_back(i);
+			}
+		}
+	}
+
+	d["tile_size"] = tile_size;
+	d["tiles"] = tiles_array;
+	d["requested_tiles"] = requested_tiles;
+	d["unused_tiles"] = unused_tiles;
 
 	return d;
 }
@@ -34,6 +34,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/physics_3d/physics_server_3d_enums.h"
 
@@ -391,6 +392,18 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	int depth = 0;
 	Vector3 local_origin;
 
+	// Paged heights, stored in square tiles of `tile_size` cells which repeat the samples of their shared edges.
+	// Tiles without heights are not loaded and don't collide. Tiles touched by a collision or query are flagged,
+	// so the user can tell which tiles to load or unload next.
+	struct Tile {
+		Vector<real_t> heights;
+		mutable SafeFlag used;
+	};
+	LocalVector<Tile> tiles;
+	int tile_size = 0;
+	int tiles_width = 0;
+	int tiles_depth = 0;
+
 	// Accelerator.
 	struct Range {
 		real_t min = 0.0;
@@ -399,6 +412,7 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	LocalVector<Range> bounds_grid;
 	int bounds_grid_width = 0;
 	int bounds_grid_depth = 0;
+	int bounds_chunk_size = BOUNDS_CHUNK_SIZE;
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
@@ -410,20 +424,67 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 		return heights[(p_z * width) + p_x];
 	}
 
-	_FORCE_INLINE_ void _get_point(int p_x, int p_z, Vector3 &r_point) const {
-		r_point.x = p_x - 0.5 * (width - 1.0);
-		r_point.y = _get_height(p_x, p_z);
-		r_point.z = p_z - 0.5 * (depth - 1.0);
+	_FORCE_INLINE_ bool _is_paged() const {
+		return tile_size > 0;
+	}
+
+	_FORCE_INLINE_ bool _is_chunk_loaded(int p_x, int p_z) const {
+		if (!_is_paged()) {
+			return true;
+		}
+
+		const Tile &tile = tiles[(p_z * tiles_width) + p_x];
+		if (!tile.used.is_set()) {
+			tile.used.set();
+		}
+		return !tile.heights.is_empty();
+	}
+
+	// Gets the four corners of a cell, ordered as (x, z), (x + 1, z), (x, z + 1), (x + 1, z + 1).
+	// Returns false if the cell belongs to a tile that is not loaded.
+	_FORCE_INLINE_ bool _get_cell_points(int p_x, int p_z, Vector3 *r_points) const {
+		const real_t *cell_heights = nullptr;
+		int stride = width;
+
+		if (_is_paged()) {
+			const int tile_x = p_x / tile_size;
+			const int tile_z = p_z / tile_size;
+			const Tile &tile = tiles[(tile_z * tiles_width) + tile_x];
+			if (!tile.used.is_set()) {
+				tile.used.set();
+			}
+			if (tile.heights.is_empty()) {
+				return false;
+			}
+
+			stride = tile_size + 1;
+			cell_heights = tile.heights.ptr() + ((p_z - tile_z * tile_size) * stride) + (p_x - tile_x * tile_size);
+		} else {
+			cell_heights = heights.ptr() + (p_z * width) + p_x;
+		}
+
+		const real_t x = p_x - 0.5 * (width - 1.0);
+		const real_t z = p_z - 0.5 * (depth - 1.0);
+
+		r_points[0] = Vector3(x, cell_heights[0], z);
+		r_points[1] = Vector3(x + 1.0, cell_heights[1], z);
+		r_points[2] = Vector3(x, cell_heights[stride], z + 1.0);
+		r_points[3] = Vector3(x + 1.0, cell_heights[stride + 1], z + 1.0);
+
+		return true;
 	}
 
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
 	void _build_accelerator();
+	void _build_tile_accelerator(const LocalVector<Vector<real_t>> &p_previous_heights, const LocalVector<Range> &p_previous_ranges);
+	void _configure_heights(real_t p_min_height, real_t p_max_height);
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
 	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _setup_tiles(const Array &p_tiles, int p_width, int p_depth, int p_tile_size, const Variant &p_min_height, const Variant &p_max_height);
 
 public:
 	Vector<real_t> get_heights() const;
@@ -30,6 +30,7 @@
 
 #include "godot_step_3d.h"
 
+#include "godot_collision_solver_3d.h"
 #include "godot_constraint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
@@ -40,6 +41,9 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define CCD_CULL_MAX 128
+
+SafeNumeric<uint64_t> GodotStep3D::step_counter;
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -182,9 +186,135 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+void GodotStep3D::_collect_ccd_candidates(CCDBody &p_ccd_body, GodotSpace3D *p_space) {
+	GodotBody3D *body = p_ccd_body.body;
+	const Transform3D &from = p_ccd_body.from;
+
+	// Same motion as in `GodotBody3D::integrate_velocities`: rotation around the center of mass, then translation.
+	p_ccd_body.pivot = from.xform(body->get_center_of_mass_local());
+	p_ccd_body.motion = body->get_transform().xform(body->get_center_of_mass_local()) - p_ccd_body.pivot;
+	p_ccd_body.rotation = (body->get_angular_velocity() + body->get_biased_angular_velocity()) * delta;
+	p_ccd_body.candidates_begin = ccd_candidates.size();
+
+	GodotCollisionObject3D *cull_results[CCD_CULL_MAX];
+	int cull_subindices[CCD_CULL_MAX];
+
+	for (int shape_idx = 0; shape_idx < body->get_shape_count(); shape_idx++) {
+		if (body->is_shape_disabled(shape_idx)) {
+			continue;
+		}
+
+		const GodotShape3D *shape = body->get_shape(shape_idx);
+		Transform3D shape_xform = from * body->get_shape_transform(shape_idx);
+
+		// Bounding sphere around the center of mass, swept along the motion.
+		AABB shape_aabb = shape_xform.xform(shape->get_aabb());
+		real_t radius = 0.0;
+		for (int i = 0; i < 8; i++) {
+			radius = MAX(radius, shape_aabb.get_endpoint(i).distance_to(p_ccd_body.pivot));
+		}
+		AABB swept_aabb = AABB(p_ccd_body.pivot - Vector3(radius, radius, radius), Vector3(radius, radius, radius) * 2.0);
+		swept_aabb.merge_with(AABB(swept_aabb.position + p_ccd_body.motion, swept_aabb.size));
+
+		int amount = p_space->get_broadphase()->cull_aabb(swept_aabb, cull_results, CCD_CULL_MAX, cull_subindices);
+
+		for (int i = 0; i < amount; i++) {
+			GodotCollisionObject3D *col_obj = cull_results[i];
+			if (col_obj == body || col_obj->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+				continue;
+			}
+
+			GodotBody3D *other = static_cast<GodotBody3D *>(col_obj);
+			if (!body->collides_with(other) || !body->interacts_with(other) || body->has_exception(other->get_self()) || other->has_exception(body->get_self())) {
+				continue;
+			}
+
+			int other_shape_idx = cull_subindices[i];
+			if (other->is_shape_disabled(other_shape_idx)) {
+				continue;
+			}
+
+			CCDCandidate candidate;
+			candidate.shape_idx = shape_idx;
+			candidate.other = other;
+			candidate.other_shape_idx = other_shape_idx;
+			ccd_candidates.push_back(candidate);
+		}
+	}
+
+	p_ccd_body.candidates_end = ccd_candidates.size();
+}
+
+void GodotStep3D::_solve_ccd_body(uint32_t p_index, void *p_userdata) {
+	CCDBody &ccd_body = ccd_bodies[p_index];
+	GodotBody3D *body = ccd_body.body;
+	const Transform3D &from = ccd_body.from;
+	const Vector3 &pivot = ccd_body.pivot;
+	const Vector3 &motion = ccd_body.motion;
+	const Vector3 &rotation = ccd_body.rotation;
+
+	real_t tolerance = ccd_space->get_contact_max_allowed_penetration();
+
+	real_t toi = 1.0;
+	for (uint32_t i = ccd_body.candidates_begin; i < ccd_body.candidates_end; i++) {
+		const CCDCandidate &candidate = ccd_candidates[i];
+		GodotBody3D *other = candidate.other;
+
+		const GodotShape3D *shape = body->get_shape(candidate.shape_idx);
+		Transform3D shape_xform = from * body->get_shape_transform(candidate.shape_idx);
+
+		// Other bodies are already integrated, assume they moved linearly during this step.
+		Vector3 other_motion = other->get_mode() == PS3DE::BODY_MODE_STATIC ? Vector3() : other->get_linear_velocity() * delta;
+		Transform3D other_xform = other->get_transform().translated(-other_motion) * other->get_shape_transform(candidate.other_shape_idx);
+
+		real_t shape_toi = 1.0;
+		if (GodotCollisionSolver3D::solve_time_of_impact(shape, shape_xform, pivot, motion, rotation, other->get_shape(candidate.other_shape_idx), other_xform, other_motion, tolerance, shape_toi)) {
+			toi = MIN(toi, shape_toi);
+		}
+	}
+
+	if (toi >= 1.0) {
+		ccd_body.toi = 1.0;
+		return;
+	}
+
+	// Move slightly past the impact, so the contact is picked up by the solver on the next step.
+	real_t motion_length = motion.length();
+	if (motion_length > CMP_EPSILON) {
+		toi = MIN(toi + tolerance * 2.0 / motion_length, (real_t)1.0);
+	}
+
+	Transform3D impact_transform = from;
+	real_t angle = rotation.length();
+	if (angle > CMP_EPSILON) {
+		Basis rot(rotation / angle, angle * toi);
+		impact_transform.basis = rot * from.basis;
+		impact_transform.origin = pivot + rot.xform(from.origin - pivot);
+	}
+	impact_transform.origin += motion * toi;
+
+	ccd_body.toi = toi;
+	ccd_body.impact_transform = impact_transform;
+}
+
+void GodotStep3D::_run_parallel(void (GodotStep3D::*p_method)(uint32_t, void *), uint32_t p_elements, const StringName &p_name) {
+	if (max_tasks == 0) {
+		// Already running inside a worker task, don't block more threads.
+		for (uint32_t i = 0; i < p_elements; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, (void *)nullptr, p_elements, max_tasks, true, p_name);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
+	_step = step_counter.increment();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -344,8 +474,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_parallel(&GodotStep3D::_setup_constraint, total_constraint_count, SNAME("Physics3DConstraintSetup"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +493,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_parallel(&GodotStep3D::_solve_island, island_count, SNAME("Physics3DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,6 +503,21 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
+	ccd_bodies.clear();
+	if (p_space->is_ccd_time_of_impact_enabled()) {
+		b = body_list->first();
+		while (b) {
+			GodotBody3D *body = b->self();
+			if (body->is_continuous_collision_detection_enabled() && body->get_mode() > PS3DE::BODY_MODE_KINEMATIC) {
+				CCDBody ccd_body;
+				ccd_body.body = body;
+				ccd_body.from = body->get_transform();
+				ccd_bodies.push_back(ccd_body);
+			}
+			b = b->next();
+		}
+	}
+
 	b = body_list->first();
 	while (b) {
 		const SelfList<GodotBody3D> *n = b->next();
@@ -382,6 +525,27 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		b = n;
 	}
 
+	/* CONTINUOUS COLLISION DETECTION */
+
+	if (!ccd_bodies.is_empty()) {
+		// Broadphase queries are done up front, so that the parallel stage only runs narrowphase queries.
+		ccd_candidates.clear();
+		for (CCDBody &ccd_body : ccd_bodies) {
+			_collect_ccd_candidates(ccd_body, p_space);
+		}
+
+		// Times of impact are computed against the integrated state of all bodies, and applied afterwards.
+		ccd_space = p_space;
+		_run_parallel(&GodotStep3D::_solve_ccd_body, ccd_bodies.size(), SNAME("Physics3DContinuousCollision"));
+		ccd_space = nullptr;
+
+		for (const CCDBody &ccd_body : ccd_bodies) {
+			if (ccd_body.toi < 1.0) {
+				ccd_body.body->set_time_of_impact_transform(ccd_body.impact_transform);
+			}
+		}
+	}
+
 	/* SLEEP / WAKE UP ISLANDS */
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
@@ -405,7 +569,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
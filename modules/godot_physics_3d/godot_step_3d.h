@@ -33,10 +33,17 @@
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
+	// Shared between all steppers, so island step markers stay unique when bodies move between spaces.
+	static SafeNumeric<uint64_t> step_counter;
 	uint64_t _step = 1;
 
+	// Number of worker tasks used for the internal parallel stages, -1 to use all threads,
+	// 0 to run them on the calling thread.
+	int max_tasks = -1;
+
 	int iterations = 0;
 	real_t delta = 0.0;
 
@@ -44,14 +51,41 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	struct CCDBody {
+		GodotBody3D *body = nullptr;
+		Transform3D from;
+		Vector3 pivot;
+		Vector3 motion;
+		Vector3 rotation;
+		uint32_t candidates_begin = 0;
+		uint32_t candidates_end = 0;
+		real_t toi = 1.0;
+		Transform3D impact_transform;
+	};
+	struct CCDCandidate {
+		int shape_idx = 0;
+		GodotBody3D *other = nullptr;
+		int other_shape_idx = 0;
+	};
+	LocalVector<CCDBody> ccd_bodies;
+	LocalVector<CCDCandidate> ccd_candidates;
+	GodotSpace3D *ccd_space = nullptr;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _collect_ccd_candidates(CCDBody &p_ccd_body, GodotSpace3D *p_space);
+	void _solve_ccd_body(uint32_t p_index, void *p_userdata = nullptr);
+
+	void _run_parallel(void (GodotStep3D::*p_method)(uint32_t, void *), uint32_t p_elements, const StringName &p_name);
 
 public:
+	void set_max_tasks(int p_max_tasks) { max_tasks = p_max_tasks; }
+	int get_max_tasks() const { return max_tasks; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
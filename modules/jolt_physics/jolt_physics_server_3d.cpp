@@ -51,7 +51,6 @@
 #include "spaces/jolt_job_system.h"
 #include "spaces/jolt_physics_direct_space_state_3d.h"
 #include "spaces/jolt_space_3d.h"
-#include "spaces/jolt_temp_allocator.h"
 
 JoltPhysicsServer3D::JoltPhysicsServer3D(bool p_on_separate_thread) :
 		on_separate_thread(p_on_separate_thread) {
@@ -181,7 +180,7 @@ real_t JoltPhysicsServer3D::shape_get_custom_solver_bias(RID p_shape) const {
 }
 
 RID JoltPhysicsServer3D::space_create() {
-	JoltSpace3D *space = memnew(JoltSpace3D(job_system, temp_allocator));
+	JoltSpace3D *space = memnew(JoltSpace3D(job_system));
 	RID rid = space_owner.make_rid(space);
 	space->set_rid(rid);
 
@@ -1625,15 +1624,9 @@ void JoltPhysicsServer3D::set_active(bool p_active) {
 
 void JoltPhysicsServer3D::init() {
 	job_system = new JoltJobSystem();
-	temp_allocator = new JoltTempAllocator();
 }
 
 void JoltPhysicsServer3D::finish() {
-	if (temp_allocator != nullptr) {
-		delete temp_allocator;
-		temp_allocator = nullptr;
-	}
-
 	if (job_system != nullptr) {
 		delete job_system;
 		job_system = nullptr;
@@ -1685,7 +1678,25 @@ bool JoltPhysicsServer3D::is_flushing_queries() const {
 }
 
 int JoltPhysicsServer3D::get_process_info(PS3DE::ProcessInfo p_process_info) {
-	return 0;
+	switch (p_process_info) {
+		case PS3DE::INFO_TEMP_MEMORY_PEAK: {
+			uint64_t peak = 0;
+			for (const JoltSpace3D *space : active_spaces) {
+				peak = MAX(peak, space->get_temp_memory_peak());
+			}
+			return (int)MIN(peak, (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_TEMP_MEMORY_CAPACITY: {
+			uint64_t capacity = 0;
+			for (const JoltSpace3D *space : active_spaces) {
+				capacity += space->get_temp_memory_capacity();
+			}
+			return (int)MIN(capacity, (uint64_t)INT32_MAX);
+		} break;
+		default: {
+			return 0;
+		} break;
+	}
 }
 
 void JoltPhysicsServer3D::free_space(JoltSpace3D *p_space) {
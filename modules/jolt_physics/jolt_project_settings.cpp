@@ -71,6 +71,7 @@ void JoltProjectSettings::register_settings() {
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_bodies", PROPERTY_HINT_RANGE, U"1,10240,or_greater"), 10240);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_body_pairs", PROPERTY_HINT_RANGE, U"8,65536,or_greater"), 65536);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_contact_constraints", PROPERTY_HINT_RANGE, U"8,20480,or_greater"), 20480);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/jolt_physics_3d/limits/max_job_concurrency", PROPERTY_HINT_RANGE, U"0,64,or_greater"), 0);
 
 	read_settings();
 
@@ -119,4 +120,5 @@ void JoltProjectSettings::read_settings() {
 	max_bodies = GLOBAL_GET("physics/jolt_physics_3d/limits/max_bodies");
 	max_body_pairs = GLOBAL_GET("physics/jolt_physics_3d/limits/max_body_pairs");
 	max_contact_constraints = GLOBAL_GET("physics/jolt_physics_3d/limits/max_contact_constraints");
+	max_job_concurrency = GLOBAL_GET("physics/jolt_physics_3d/limits/max_job_concurrency");
 }
@@ -77,6 +77,7 @@ public:
 	inline static int max_bodies;
 	inline static int max_body_pairs;
 	inline static int max_contact_constraints;
+	inline static int max_job_concurrency;
 
 	static void register_settings();
 	static void read_settings();
@@ -32,9 +32,13 @@
 
 #include "../jolt_project_settings.h"
 #include "../misc/jolt_type_conversions.h"
+#include "../objects/jolt_shaped_object_3d.h"
+#include "../spaces/jolt_space_3d.h"
 
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
 #include <Jolt/Physics/Collision/Shape/HeightFieldShape.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
 
 namespace {
 
@@ -50,6 +54,10 @@ bool _is_triangle_hole(const JPH::VertexList &p_vertices, int p_index0, int p_in
 } // namespace
 
 JPH::ShapeRefC JoltHeightMapShape3D::_build() const {
+	if (_is_paged()) {
+		return _build_tiles();
+	}
+
 	const int height_count = (int)heights.size();
 	if (unlikely(height_count == 0)) {
 		return nullptr;
@@ -58,23 +66,73 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build() const {
 	ERR_FAIL_COND_V_MSG(height_count != width * depth, nullptr, vformat("Failed to build Jolt Physics height map shape with %s. Height count must be the product of width and depth. This shape belongs to %s.", to_string(), _owners_to_string()));
 	ERR_FAIL_COND_V_MSG(width < 2 || depth < 2, nullptr, vformat("Failed to build Jolt Physics height map shape with %s. The height map must be at least 2x2. This shape belongs to %s.", to_string(), _owners_to_string()));
 
-	if (width != depth) {
-		return JoltShape3D::with_double_sided(_build_mesh(), true);
+	return JoltShape3D::with_double_sided(_build_grid(heights.ptr(), width, width, depth), true);
+}
+
+JPH::ShapeRefC JoltHeightMapShape3D::_build_tiles() const {
+	JPH::StaticCompoundShapeSettings shape_settings;
+
+	const float offset_x = (float)-(width - 1) / 2.0f;
+	const float offset_z = (float)-(depth - 1) / 2.0f;
+
+	const int stride = tile_size + 1;
+
+	for (int tz = 0; tz < tiles_depth; ++tz) {
+		for (int tx = 0; tx < tiles_width; ++tx) {
+			const Tile &tile = tiles[tz * tiles_width + tx];
+			if (tile.heights.is_empty()) {
+				continue;
+			}
+
+			// Tiles on the far edges can extend past the map, the samples out there are ignored.
+			const int tile_width = MIN(stride, width - tx * tile_size);
+			const int tile_depth = MIN(stride, depth - tz * tile_size);
+
+			if (tile.jolt_ref == nullptr) {
+				tile.jolt_ref = _build_grid(tile.heights.ptr(), stride, tile_width, tile_depth);
+				if (tile.jolt_ref == nullptr) {
+					continue;
+				}
+			}
+
+			// The shape of each tile is centered on its own samples.
+			const JPH::Vec3 tile_center(
+					offset_x + (float)(tx * tile_size) + (float)(tile_width - 1) / 2.0f,
+					0.0f,
+					offset_z + (float)(tz * tile_size) + (float)(tile_depth - 1) / 2.0f);
+
+			shape_settings.AddShape(tile_center, JPH::Quat::sIdentity(), tile.jolt_ref);
+		}
+	}
+
+	if (shape_settings.mSubShapes.empty()) {
+		return nullptr;
+	}
+
+	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
+	ERR_FAIL_COND_V_MSG(shape_result.HasError(), nullptr, vformat("Failed to build Jolt Physics height map shape (as tiles) with %s. It returned the following error: '%s'. This shape belongs to %s.", to_string(), to_godot(shape_result.GetError()), _owners_to_string()));
+
+	return JoltShape3D::with_double_sided(shape_result.Get(), true);
+}
+
+JPH::ShapeRefC JoltHeightMapShape3D::_build_grid(const real_t *p_heights, int p_stride, int p_width, int p_depth) const {
+	if (p_width != p_depth) {
+		return _build_mesh(p_heights, p_stride, p_width, p_depth);
 	}
 
 	const int block_size = 2; // Default of JPH::HeightFieldShapeSettings::mBlockSize
-	const int block_count = width / block_size;
+	const int block_count = p_width / block_size;
 
 	if (block_count < 2) {
-		return JoltShape3D::with_double_sided(_build_mesh(), true);
+		return _build_mesh(p_heights, p_stride, p_width, p_depth);
 	}
 
-	return JoltShape3D::with_double_sided(_build_height_field(), true);
+	return _build_height_field(p_heights, p_stride, p_width, p_depth);
 }
 
-JPH::ShapeRefC JoltHeightMapShape3D::_build_height_field() const {
-	const int quad_count_x = width - 1;
-	const int quad_count_y = depth - 1;
+JPH::ShapeRefC JoltHeightMapShape3D::_build_height_field(const real_t *p_heights, int p_stride, int p_width, int p_depth) const {
+	const int quad_count_x = p_width - 1;
+	const int quad_count_y = p_depth - 1;
 
 	const float offset_x = (float)-quad_count_x / 2.0f;
 	const float offset_y = (float)-quad_count_y / 2.0f;
@@ -83,18 +141,17 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_height_field() const {
 	// Z-axis to get the desired triangulation and reverse the rows to undo the mirroring.
 
 	LocalVector<float> heights_rev;
-	heights_rev.resize(heights.size());
+	heights_rev.resize(p_width * p_depth);
 
-	const real_t *heights_ptr = heights.ptr();
 	float *heights_rev_ptr = heights_rev.ptr();
 
-	for (int z = 0; z < depth; ++z) {
-		const int z_rev = (depth - 1) - z;
+	for (int z = 0; z < p_depth; ++z) {
+		const int z_rev = (p_depth - 1) - z;
 
-		const real_t *row = heights_ptr + ptrdiff_t(z * width);
-		float *row_rev = heights_rev_ptr + ptrdiff_t(z_rev * width);
+		const real_t *row = p_heights + ptrdiff_t(z * p_stride);
+		float *row_rev = heights_rev_ptr + ptrdiff_t(z_rev * p_width);
 
-		for (int x = 0; x < width; ++x) {
+		for (int x = 0; x < p_width; ++x) {
 			const real_t height = row[x];
 
 			// Godot has undocumented (accidental?) support for holes by passing NaN as the height value, whereas Jolt
@@ -103,7 +160,7 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_height_field() const {
 		}
 	}
 
-	JPH::HeightFieldShapeSettings shape_settings(heights_rev.ptr(), JPH::Vec3(offset_x, 0, offset_y), JPH::Vec3::sOne(), (JPH::uint32)width);
+	JPH::HeightFieldShapeSettings shape_settings(heights_rev.ptr(), JPH::Vec3(offset_x, 0, offset_y), JPH::Vec3::sOne(), (JPH::uint32)p_width);
 
 	shape_settings.mBitsPerSample = shape_settings.CalculateBitsPerSampleForError(0.0f);
 	shape_settings.mActiveEdgeCosThresholdAngle = JoltProjectSettings::active_edge_threshold_cos;
@@ -114,11 +171,11 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_height_field() const {
 	return with_scale(shape_result.Get(), Vector3(1, 1, -1));
 }
 
-JPH::ShapeRefC JoltHeightMapShape3D::_build_mesh() const {
-	const int height_count = (int)heights.size();
+JPH::ShapeRefC JoltHeightMapShape3D::_build_mesh(const real_t *p_heights, int p_stride, int p_width, int p_depth) const {
+	const int height_count = p_width * p_depth;
 
-	const int quad_count_x = width - 1;
-	const int quad_count_z = depth - 1;
+	const int quad_count_x = p_width - 1;
+	const int quad_count_z = p_depth - 1;
 
 	const int quad_count = quad_count_x * quad_count_z;
 	const int triangle_count = quad_count * 2;
@@ -132,10 +189,10 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_mesh() const {
 	const float offset_x = (float)-quad_count_x / 2.0f;
 	const float offset_z = (float)-quad_count_z / 2.0f;
 
-	for (int z = 0; z < depth; ++z) {
-		for (int x = 0; x < width; ++x) {
+	for (int z = 0; z < p_depth; ++z) {
+		for (int x = 0; x < p_width; ++x) {
 			const float vertex_x = offset_x + (float)x;
-			const float vertex_y = (float)heights[z * width + x];
+			const float vertex_y = (float)p_heights[z * p_stride + x];
 			const float vertex_z = offset_z + (float)z;
 
 			vertices.emplace_back(vertex_x, vertex_y, vertex_z);
@@ -144,10 +201,10 @@ JPH::ShapeRefC JoltHeightMapShape3D::_build_mesh() const {
 
 	for (int z = 0; z < quad_count_z; ++z) {
 		for (int x = 0; x < quad_count_x; ++x) {
-			const int index_lower_right = z * width + x;
-			const int index_lower_left = z * width + (x + 1);
-			const int index_upper_right = (z + 1) * width + x;
-			const int index_upper_left = (z + 1) * width + (x + 1);
+			const int index_lower_right = z * p_width + x;
+			const int index_lower_left = z * p_width + (x + 1);
+			const int index_upper_right = (z + 1) * p_width + x;
+			const int index_upper_left = (z + 1) * p_width + (x + 1);
 
 			if (!_is_triangle_hole(vertices, index_lower_right, index_upper_right, index_lower_left)) {
 				indices.emplace_back(index_lower_right, index_upper_right, index_lower_left);
@@ -192,11 +249,223 @@ AABB JoltHeightMapShape3D::_calculate_aabb() const {
 	return result;
 }
 
+AABB JoltHeightMapShape3D::_calculate_tiles_aabb() const {
+	float min_height = 0.0f;
+	float max_height = 0.0f;
+	bool has_heights = false;
+
+	const int stride = tile_size + 1;
+
+	for (int tz = 0; tz < tiles_depth; ++tz) {
+		for (int tx = 0; tx < tiles_width; ++tx) {
+			const Tile &tile = tiles[tz * tiles_width + tx];
+			if (tile.heights.is_empty()) {
+				continue;
+			}
+
+			const int tile_width = MIN(stride, width - tx * tile_size);
+			const int tile_depth = MIN(stride, depth - tz * tile_size);
+			const real_t *tile_ptr = tile.heights.ptr();
+
+			for (int z = 0; z < tile_depth; ++z) {
+				for (int x = 0; x < tile_width; ++x) {
+					const float height = (float)tile_ptr[z * stride + x];
+
+					if (!has_heights) {
+						min_height = height;
+						max_height = height;
+						has_heights = true;
+					} else {
+						min_height = MIN(min_height, height);
+						max_height = MAX(max_height, height);
+					}
+				}
+			}
+		}
+	}
+
+	const float extent_x = (float)(width - 1);
+	const float extent_z = (float)(depth - 1);
+
+	return AABB(Vector3(-extent_x / 2.0f, min_height, -extent_z / 2.0f), Vector3(extent_x, max_height - min_height, extent_z));
+}
+
+void JoltHeightMapShape3D::_set_tiles_data(const Dictionary &p_data) {
+	const Variant maybe_width = p_data.get("width", Variant());
+	ERR_FAIL_COND(maybe_width.get_type() != Variant::INT);
+
+	const Variant maybe_depth = p_data.get("depth", Variant());
+	ERR_FAIL_COND(maybe_depth.get_type() != Variant::INT);
+
+	const Variant maybe_tile_size = p_data.get("tile_size", Variant());
+	ERR_FAIL_COND(maybe_tile_size.get_type() != Variant::INT);
+
+	const Variant maybe_tiles = p_data.get("tiles", Variant());
+	ERR_FAIL_COND(maybe_tiles.get_type() != Variant::ARRAY);
+
+	const int width_new = maybe_width;
+	const int depth_new = maybe_depth;
+	const int tile_size_new = maybe_tile_size;
+
+	ERR_FAIL_COND(width_new < 2 || depth_new < 2);
+	ERR_FAIL_COND(tile_size_new <= 0);
+
+	const int tiles_width_new = (width_new - 2) / tile_size_new + 1;
+	const int tiles_depth_new = (depth_new - 2) / tile_size_new + 1;
+
+	const Array tiles_array = maybe_tiles;
+	ERR_FAIL_COND_MSG(tiles_array.size() != tiles_width_new * tiles_depth_new, vformat("Expected %d height map tiles, got %d.", tiles_width_new * tiles_depth_new, tiles_array.size()));
+
+	const int tile_sample_count = (tile_size_new + 1) * (tile_size_new + 1);
+
+	for (int i = 0; i < tiles_array.size(); ++i) {
+		const Variant &maybe_tile_heights = tiles_array[i];
+		if (maybe_tile_heights.get_type() == Variant::NIL) {
+			continue;
+		}
+
+#ifdef REAL_T_IS_DOUBLE
+		ERR_FAIL_COND(maybe_tile_heights.get_type() != Variant::PACKED_FLOAT64_ARRAY);
+		const PackedFloat64Array tile_heights = maybe_tile_heights;
+#else
+		ERR_FAIL_COND(maybe_tile_heights.get_type() != Variant::PACKED_FLOAT32_ARRAY);
+		const PackedFloat32Array tile_heights = maybe_tile_heights;
+#endif
+
+		ERR_FAIL_COND_MSG(!tile_heights.is_empty() && tile_heights.size() != tile_sample_count, vformat("Height map tile %d must have %d heights.", i, tile_sample_count));
+	}
+
+	// Tiles that are still backed by the same buffer haven't changed, so their shapes can be kept.
+	const bool same_layout = tile_size == tile_size_new && width == width_new && depth == depth_new;
+	const LocalVector<Tile> previous_tiles = std::move(tiles);
+
+	tiles.clear();
+	tiles.resize(tiles_array.size());
+
+	for (uint32_t i = 0; i < tiles.size(); ++i) {
+		const Variant &maybe_tile_heights = tiles_array[i];
+		if (maybe_tile_heights.get_type() == Variant::NIL) {
+			continue;
+		}
+
+		Tile &tile = tiles[i];
+		tile.heights = maybe_tile_heights;
+
+		if (same_layout && !tile.heights.is_empty() && previous_tiles[i].heights.ptr() == tile.heights.ptr()) {
+			tile.jolt_ref = previous_tiles[i].jolt_ref;
+		}
+	}
+
+	heights.clear();
+	width = width_new;
+	depth = depth_new;
+	tile_size = tile_size_new;
+	tiles_width = tiles_width_new;
+	tiles_depth = tiles_depth_new;
+
+	aabb = _calculate_tiles_aabb();
+
+	destroy();
+}
+
+void JoltHeightMapShape3D::_get_tiles_usage(PackedInt32Array &r_requested_tiles, PackedInt32Array &r_unused_tiles) const {
+	// Jolt doesn't tell us which parts of a shape were touched, so instead any tile overlapped by the bounds
+	// of another body in the same space counts as used.
+	LocalVector<uint8_t> used;
+	used.resize_initialized(tiles.size());
+
+	const real_t grid_offset_x = (width - 1) / 2.0f;
+	const real_t grid_offset_z = (depth - 1) / 2.0f;
+
+	for (const KeyValue<JoltShapedObject3D *, int> &E : ref_counts_by_owner) {
+		const JoltShapedObject3D *owner = E.key;
+		if (!owner->in_space()) {
+			continue;
+		}
+
+		const JoltSpace3D *space = owner->get_space();
+
+		for (int i = 0; i < owner->get_shape_count(); ++i) {
+			if (owner->get_shape(i) != this) {
+				continue;
+			}
+
+			const Transform3D shape_transform = owner->get_transform_scaled() * owner->get_shape_transform_scaled(i);
+			const Transform3D shape_transform_inv = shape_transform.affine_inverse();
+
+			// The heights of tiles that aren't loaded are unknown, so bodies within a tile's distance count as nearby.
+			const AABB shape_aabb = shape_transform.xform(aabb.grow(tile_size));
+
+			JPH::AllHitCollisionCollector<JPH::CollideShapeBodyCollector> collector;
+			space->get_broad_phase_query().CollideAABox(to_jolt(shape_aabb), collector);
+
+			for (const JPH::BodyID &other_jolt_id : collector.mHits) {
+				if (other_jolt_id == owner->get_jolt_id()) {
+					continue;
+				}
+
+				const JPH::Body *other_jolt_body = space->try_get_jolt_body(other_jolt_id);
+				if (other_jolt_body == nullptr) {
+					continue;
+				}
+
+				const AABB other_aabb = shape_transform_inv.xform(to_godot(other_jolt_body->GetWorldSpaceBounds()));
+
+				const int begin_x = MAX(0, (int)Math::floor((other_aabb.position.x + grid_offset_x) / tile_size));
+				const int begin_z = MAX(0, (int)Math::floor((other_aabb.position.z + grid_offset_z) / tile_size));
+				const int end_x = MIN(tiles_width - 1, (int)Math::floor((other_aabb.position.x + other_aabb.size.x + grid_offset_x) / tile_size));
+				const int end_z = MIN(tiles_depth - 1, (int)Math::floor((other_aabb.position.z + other_aabb.size.z + grid_offset_z) / tile_size));
+
+				for (int tz = begin_z; tz <= end_z; ++tz) {
+					for (int tx = begin_x; tx <= end_x; ++tx) {
+						used[tz * tiles_width + tx] = 1;
+					}
+				}
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < tiles.size(); ++i) {
+		if (tiles[i].heights.is_empty()) {
+			if (used[i]) {
+				r_requested_tiles.push_back(i);
+			}
+		} else if (!used[i]) {
+			r_unused_tiles.push_back(i);
+		}
+	}
+}
+
 Variant JoltHeightMapShape3D::get_data() const {
 	Dictionary data;
 	data["width"] = width;
 	data["depth"] = depth;
-	data["heights"] = heights;
+
+	if (!_is_paged()) {
+		data["heights"] = heights;
+		return data;
+	}
+
+	Array tiles_array;
+	tiles_array.resize(tiles.size());
+
+	for (uint32_t i = 0; i < tiles.size(); ++i) {
+		if (!tiles[i].heights.is_empty()) {
+			tiles_array[i] = tiles[i].heights;
+		}
+	}
+
+	PackedInt32Array requested_tiles;
+	PackedInt32Array unused_tiles;
+	_get_tiles_usage(requested_tiles, unused_tiles);
+
+	data["min_height"] = aabb.position.y;
+	data["max_height"] = aabb.position.y + aabb.size.y;
+	data["tile_size"] = tile_size;
+	data["tiles"] = tiles_array;
+	data["requested_tiles"] = requested_tiles;
+	data["unused_tiles"] = unused_tiles;
+
 	return data;
 }
 
@@ -205,6 +474,12 @@ void JoltHeightMapShape3D::set_data(const Variant &p_data) {
 
 	const Dictionary data = p_data;
 
+	if (data.has("tile_size")) {
+		// Paged height map, heights are passed per tile instead of in a single array.
+		_set_tiles_data(data);
+		return;
+	}
+
 	const Variant maybe_heights = data.get("heights", Variant());
 
 #ifdef REAL_T_IS_DOUBLE
@@ -223,6 +498,11 @@ void JoltHeightMapShape3D::set_data(const Variant &p_data) {
 	width = maybe_width;
 	depth = maybe_depth;
 
+	tiles.clear();
+	tile_size = 0;
+	tiles_width = 0;
+	tiles_depth = 0;
+
 	aabb = _calculate_aabb();
 
 	destroy();
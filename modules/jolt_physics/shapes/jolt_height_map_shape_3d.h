@@ -32,6 +32,8 @@
 
 #include "jolt_shape_3d.h"
 
+#include "core/templates/local_vector.h"
+
 class JoltHeightMapShape3D final : public JoltShape3D {
 	AABB aabb;
 
@@ -44,11 +46,35 @@ class JoltHeightMapShape3D final : public JoltShape3D {
 	int width = 0;
 	int depth = 0;
 
+	// Paged heights, stored in square tiles of `tile_size` cells which repeat the samples of their shared edges.
+	// Each loaded tile is built as its own shape, which is kept for as long as its heights don't change.
+	struct Tile {
+#ifdef REAL_T_IS_DOUBLE
+		PackedFloat64Array heights;
+#else
+		PackedFloat32Array heights;
+#endif
+		mutable JPH::ShapeRefC jolt_ref;
+	};
+
+	LocalVector<Tile> tiles;
+	int tile_size = 0;
+	int tiles_width = 0;
+	int tiles_depth = 0;
+
 	virtual JPH::ShapeRefC _build() const override;
-	JPH::ShapeRefC _build_height_field() const;
-	JPH::ShapeRefC _build_mesh() const;
+	JPH::ShapeRefC _build_tiles() const;
+	JPH::ShapeRefC _build_grid(const real_t *p_heights, int p_stride, int p_width, int p_depth) const;
+	JPH::ShapeRefC _build_height_field(const real_t *p_heights, int p_stride, int p_width, int p_depth) const;
+	JPH::ShapeRefC _build_mesh(const real_t *p_heights, int p_stride, int p_width, int p_depth) const;
 
 	AABB _calculate_aabb() const;
+	AABB _calculate_tiles_aabb() const;
+
+	void _set_tiles_data(const Dictionary &p_data);
+	void _get_tiles_usage(PackedInt32Array &r_requested_tiles, PackedInt32Array &r_unused_tiles) const;
+
+	bool _is_paged() const { return tile_size > 0; }
 
 public:
 	virtual ShapeType get_type() const override { return ShapeType::SHAPE_HEIGHTMAP; }
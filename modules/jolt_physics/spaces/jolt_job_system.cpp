@@ -30,6 +30,8 @@
 
 #include "jolt_job_system.h"
 
+#include "../jolt_project_settings.h"
+
 #include "core/debugger/engine_debugger.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
@@ -71,6 +73,10 @@ JoltJobSystem::Job::~Job() {
 	if (task_id != -1) {
 		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
 	}
+
+	if (batch != nullptr) {
+		batch->release();
+	}
 }
 
 void JoltJobSystem::Job::push_completed(Job *p_job) {
@@ -105,6 +111,26 @@ void JoltJobSystem::Job::queue() {
 	task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, this, true, task_name);
 }
 
+void JoltJobSystem::Job::queue(Batch *p_batch) {
+	AddRef();
+
+	batch = p_batch;
+}
+
+void JoltJobSystem::Batch::_execute(void *p_user_data, uint32_t p_index) {
+	Batch *batch = static_cast<Batch *>(p_user_data);
+	Job::_execute(batch->jobs[p_index]);
+}
+
+void JoltJobSystem::Batch::release() {
+	if (ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	memdelete(this);
+}
+
 int JoltJobSystem::GetMaxConcurrency() const {
 	return thread_count;
 }
@@ -142,9 +168,27 @@ void JoltJobSystem::QueueJob(JPH::JobSystem::Job *p_job) {
 }
 
 void JoltJobSystem::QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) {
+	if (p_job_count == 1) {
+		QueueJob(p_jobs[0]);
+		return;
+	}
+
+	static const String task_name("Jolt Physics");
+
+	Batch *batch = memnew(Batch);
+	batch->jobs.resize(p_job_count);
+
+	// One reference per job, plus one for us, so that the batch can't be released before we know its group.
+	batch->ref_count.store(p_job_count + 1, std::memory_order_relaxed);
+
 	for (JPH::uint i = 0; i < p_job_count; ++i) {
-		QueueJob(p_jobs[i]);
+		Job *job = static_cast<Job *>(p_jobs[i]);
+		job->queue(batch);
+		batch->jobs[i] = job;
 	}
+
+	batch->group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&Batch::_execute, batch, (int)p_job_count, MIN((int)p_job_count, thread_count), true, task_name);
+	batch->release();
 }
 
 void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
@@ -160,6 +204,10 @@ void JoltJobSystem::_reclaim_jobs() {
 JoltJobSystem::JoltJobSystem() :
 		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
+	if (JoltProjectSettings::max_job_concurrency > 0) {
+		thread_count = MIN(thread_count, JoltProjectSettings::max_job_concurrency);
+	}
+
 	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
 }
 
@@ -30,8 +30,10 @@
 
 #pragma once
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include <Jolt/Jolt.h>
 
@@ -41,7 +43,23 @@
 #include <atomic>
 
 class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+	class Job;
+
+	// Jobs queued together by Jolt are submitted as a single group task, which is released once
+	// every job in it has been destroyed and the queueing thread is done with it.
+	struct Batch {
+		LocalVector<Job *> jobs;
+		WorkerThreadPool::GroupID group_id = -1;
+		std::atomic<uint32_t> ref_count = 0;
+
+		static void _execute(void *p_user_data, uint32_t p_index);
+
+		void release();
+	};
+
 	class Job : public JPH::JobSystem::Job {
+		friend struct Batch;
+
 		inline static std::atomic<Job *> completed_head = nullptr;
 
 #ifdef DEBUG_ENABLED
@@ -49,6 +67,7 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 #endif
 
 		int64_t task_id = -1;
+		Batch *batch = nullptr;
 
 		std::atomic<Job *> completed_next = nullptr;
 
@@ -64,6 +83,7 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 		static Job *pop_completed();
 
 		void queue();
+		void queue(Batch *p_batch);
 
 		Job &operator=(const Job &p_other) = delete;
 		Job &operator=(Job &&p_other) = delete;
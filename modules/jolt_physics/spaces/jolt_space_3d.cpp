@@ -41,6 +41,7 @@
 #include "jolt_contact_listener_3d.h"
 #include "jolt_layers.h"
 #include "jolt_physics_direct_space_state_3d.h"
+#include "jolt_temp_allocator.h"
 
 #include "core/io/file_access.h"
 #include "core/os/time.h"
@@ -109,9 +110,9 @@ void JoltSpace3D::_post_step(float p_step) {
 	}
 }
 
-JoltSpace3D::JoltSpace3D(JPH::JobSystem *p_job_system, JPH::TempAllocator *p_temp_allocator) :
+JoltSpace3D::JoltSpace3D(JPH::JobSystem *p_job_system) :
 		job_system(p_job_system),
-		temp_allocator(p_temp_allocator),
+		temp_allocator(new JoltTempAllocator()),
 		layers(new JoltLayers()),
 		contact_listener(new JoltContactListener3D(this)),
 		body_activation_listener(new JoltBodyActivationListener3D()),
@@ -185,6 +186,11 @@ JoltSpace3D::~JoltSpace3D() {
 		delete layers;
 		layers = nullptr;
 	}
+
+	if (temp_allocator != nullptr) {
+		delete temp_allocator;
+		temp_allocator = nullptr;
+	}
 }
 
 void JoltSpace3D::step(float p_step) {
@@ -195,6 +201,8 @@ void JoltSpace3D::step(float p_step) {
 
 	const JPH::EPhysicsUpdateError update_error = physics_system->Update(p_step, 1, temp_allocator, job_system);
 
+	temp_allocator->compact();
+
 	if ((update_error & JPH::EPhysicsUpdateError::ManifoldCacheFull) != JPH::EPhysicsUpdateError::None) {
 		WARN_PRINT_ONCE(vformat("Jolt Physics manifold cache exceeded capacity and contacts were ignored. "
 								"Consider increasing maximum number of contact constraints in project settings. "
@@ -299,6 +307,18 @@ void JoltSpace3D::set_param(PS3DE::SpaceParameter p_param, double p_value) {
 	}
 }
 
+JPH::TempAllocator &JoltSpace3D::get_temp_allocator() const {
+	return *temp_allocator;
+}
+
+uint64_t JoltSpace3D::get_temp_memory_peak() const {
+	return temp_allocator->get_peak();
+}
+
+uint64_t JoltSpace3D::get_temp_memory_capacity() const {
+	return temp_allocator->get_capacity();
+}
+
 JPH::BodyInterface &JoltSpace3D::get_body_iface() {
 	return physics_system->GetBodyInterfaceNoLock();
 }
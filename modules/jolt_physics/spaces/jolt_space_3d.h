@@ -57,6 +57,7 @@ class JoltObject3D;
 class JoltPhysicsDirectSpaceState3D;
 class JoltShapedObject3D;
 class JoltSoftBody3D;
+class JoltTempAllocator;
 
 class JoltSpace3D {
 	Mutex pending_objects_mutex;
@@ -73,7 +74,7 @@ class JoltSpace3D {
 	RID rid;
 
 	JPH::JobSystem *job_system = nullptr;
-	JPH::TempAllocator *temp_allocator = nullptr;
+	JoltTempAllocator *temp_allocator = nullptr;
 	JoltLayers *layers = nullptr;
 	JoltContactListener3D *contact_listener = nullptr;
 	JoltBodyActivationListener3D *body_activation_listener = nullptr;
@@ -92,7 +93,7 @@ class JoltSpace3D {
 	void _post_step(float p_step);
 
 public:
-	explicit JoltSpace3D(JPH::JobSystem *p_job_system, JPH::TempAllocator *p_temp_allocator);
+	explicit JoltSpace3D(JPH::JobSystem *p_job_system);
 	~JoltSpace3D();
 
 	void step(float p_step);
@@ -112,7 +113,9 @@ public:
 
 	JPH::PhysicsSystem &get_physics_system() const { return *physics_system; }
 
-	JPH::TempAllocator &get_temp_allocator() const { return *temp_allocator; }
+	JPH::TempAllocator &get_temp_allocator() const;
+	uint64_t get_temp_memory_peak() const;
+	uint64_t get_temp_memory_capacity() const;
 
 	JPH::BodyInterface &get_body_iface();
 	const JPH::BodyInterface &get_body_iface() const;
@@ -50,6 +50,7 @@ ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WIT
 
 #include "../jolt_project_settings.h"
 
+#include "core/string/print_string.h"
 #include "core/variant/variant.h"
 
 #include <Jolt/Core/Memory.h>
@@ -63,13 +64,21 @@ constexpr TValue align_up(TValue p_value, TAlignment p_alignment) {
 
 } //namespace
 
-JoltTempAllocator::JoltTempAllocator() :
-		capacity((uint64_t)JoltProjectSettings::temp_memory_b),
-		base(static_cast<uint8_t *>(JPH::Allocate((size_t)capacity))) {
+JoltTempAllocator::Block JoltTempAllocator::_create_block(uint64_t p_capacity) {
+	Block block;
+	block.capacity = p_capacity;
+	block.base = static_cast<uint8_t *>(JPH::Allocate((size_t)p_capacity));
+	return block;
+}
+
+JoltTempAllocator::JoltTempAllocator() {
+	blocks.push_back(_create_block((uint64_t)JoltProjectSettings::temp_memory_b));
 }
 
 JoltTempAllocator::~JoltTempAllocator() {
-	JPH::Free(base);
+	for (const Block &block : blocks) {
+		JPH::Free(block.base);
+	}
 }
 
 void *JoltTempAllocator::Allocate(uint32_t p_size) {
@@ -79,22 +88,24 @@ void *JoltTempAllocator::Allocate(uint32_t p_size) {
 
 	p_size = align_up(p_size, 16U);
 
-	const uint64_t new_top = top + p_size;
+	if (blocks[current_block].top + p_size > blocks[current_block].capacity) {
+		// Blocks past the current one are always empty, so they can be reused or replaced freely.
+		current_block++;
 
-	void *ptr = nullptr;
-
-	if (new_top <= capacity) {
-		ptr = base + top;
-	} else {
-		WARN_PRINT_ONCE(vformat("Jolt Physics temporary memory allocator exceeded capacity of %d MiB. "
-								"Falling back to slower general-purpose allocator. "
-								"Consider increasing maximum temporary memory in project settings.",
-				JoltProjectSettings::temp_memory_mib));
-
-		ptr = JPH::Allocate(p_size);
+		if (current_block == blocks.size()) {
+			blocks.push_back(_create_block(MAX((uint64_t)p_size, blocks[current_block - 1].capacity)));
+		} else if (blocks[current_block].capacity < p_size) {
+			JPH::Free(blocks[current_block].base);
+			blocks[current_block] = _create_block(p_size);
+		}
 	}
 
-	top = new_top;
+	Block &block = blocks[current_block];
+	void *ptr = block.base + block.top;
+	block.top += p_size;
+
+	used += p_size;
+	peak = MAX(peak, used);
 
 	return ptr;
 }
@@ -106,15 +117,42 @@ void JoltTempAllocator::Free(void *p_ptr, uint32_t p_size) {
 
 	p_size = align_up(p_size, 16U);
 
-	const uint64_t new_top = top - p_size;
+	Block &block = blocks[current_block];
 
-	if (top <= capacity) {
-		if (base + new_top != p_ptr) {
-			CRASH_NOW_MSG("Jolt Physics temporary memory was freed in the wrong order.");
-		}
-	} else {
-		JPH::Free(p_ptr);
+	if (p_size > block.top || block.base + block.top - p_size != p_ptr) {
+		CRASH_NOW_MSG("Jolt Physics temporary memory was freed in the wrong order.");
+	}
+
+	block.top -= p_size;
+	used -= p_size;
+
+	while (current_block > 0 && blocks[current_block].top == 0) {
+		current_block--;
 	}
+}
+
+void JoltTempAllocator::compact() {
+	if (blocks.size() == 1 || used > 0) {
+		return;
+	}
+
+	const uint64_t capacity = get_capacity();
 
-	top = new_top;
+	for (const Block &block : blocks) {
+		JPH::Free(block.base);
+	}
+
+	blocks.clear();
+	blocks.push_back(_create_block(capacity));
+	current_block = 0;
+
+	print_verbose(vformat("Jolt Physics temporary memory allocator grew to %d MiB.", capacity / (1024 * 1024)));
+}
+
+uint64_t JoltTempAllocator::get_capacity() const {
+	uint64_t capacity = 0;
+	for (const Block &block : blocks) {
+		capacity += block.capacity;
+	}
+	return capacity;
 }
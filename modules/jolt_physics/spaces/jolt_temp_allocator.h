@@ -30,16 +30,31 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
+
 #include <Jolt/Jolt.h>
 
 #include <Jolt/Core/TempAllocator.h>
 
 #include <cstdint>
 
+// Stack allocator owned by each space. When the current block runs out, another block is chained
+// instead of falling back to the general-purpose allocator, and the blocks are merged into a single
+// larger one once the step is done, so the next steps fit in contiguous memory again.
 class JoltTempAllocator final : public JPH::TempAllocator {
-	uint64_t capacity = 0;
-	uint64_t top = 0;
-	uint8_t *base = nullptr;
+	struct Block {
+		uint8_t *base = nullptr;
+		uint64_t capacity = 0;
+		uint64_t top = 0;
+	};
+
+	LocalVector<Block> blocks;
+	uint32_t current_block = 0;
+
+	uint64_t used = 0;
+	uint64_t peak = 0;
+
+	static Block _create_block(uint64_t p_capacity);
 
 public:
 	explicit JoltTempAllocator();
@@ -47,4 +62,9 @@ public:
 
 	virtual void *Allocate(JPH::uint p_size) override;
 	virtual void Free(void *p_ptr, JPH::uint p_size) override;
+
+	void compact();
+
+	uint64_t get_capacity() const;
+	uint64_t get_peak() const { return peak; }
 };
@@ -528,71 +528,6 @@ void RaycastOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size)
 	buffers[p_buffer].resize(p_size);
 }
 
-Vector2 RaycastOcclusionCull::_get_jitter(const Rect2 &p_viewport_rect, const Size2i &p_buffer_size) {
-	if (!_jitter_enabled) {
-		return Vector2();
-	}
-
-	// Prevent divide by zero when using NULL viewport.
-	if ((p_buffer_size.x <= 0) || (p_buffer_size.y <= 0)) {
-		return Vector2();
-	}
-
-	int32_t frame = Engine::get_singleton()->get_frames_drawn();
-	frame %= 9;
-
-	Vector2 jitter;
-
-	switch (frame) {
-		default:
-			break;
-		case 1: {
-			jitter = Vector2(-1, -1);
-		} break;
-		case 2: {
-			jitter = Vector2(1, -1);
-		} break;
-		case 3: {
-			jitter = Vector2(-1, 1);
-		} break;
-		case 4: {
-			jitter = Vector2(1, 1);
-		} break;
-		case 5: {
-			jitter = Vector2(-0.5f, -0.5f);
-		} break;
-		case 6: {
-			jitter = Vector2(0.5f, -0.5f);
-		} break;
-		case 7: {
-			jitter = Vector2(-0.5f, 0.5f);
-		} break;
-		case 8: {
-			jitter = Vector2(0.5f, 0.5f);
-		} break;
-	}
-	Vector2 half_extents = p_viewport_rect.get_size() * 0.5;
-	jitter *= Vector2(half_extents.x / (float)p_buffer_size.x, half_extents.y / (float)p_buffer_size.y);
-
-	// The multiplier here determines the jitter magnitude in pixels.
-	// It seems like a value of 0.66 matches well the above jittering pattern as it generates subpixel samples at 0, 1/3 and 2/3
-	// Higher magnitude gives fewer false hidden, but more false shown.
-	// False hidden is obvious to viewer, false shown is not.
-	// False shown can lower percentage that are occluded, and therefore performance.
-	jitter *= 0.66f;
-
-	return jitter;
-}
-
-Rect2 _get_viewport_rect(const Projection &p_cam_projection) {
-	// NOTE: This assumes a rectangular projection plane, i.e. that:
-	// - the matrix is a projection across z-axis (i.e. is invertible and columns[0][1], [0][3], [1][0] and [1][3] == 0)
-	// - the projection plane is rectangular (i.e. columns[0][2] and [1][2] == 0 if columns[2][3] != 0)
-	Size2 half_extents = p_cam_projection.get_viewport_half_extents();
-	Point2 bottom_left = -half_extents * Vector2(p_cam_projection.columns[3][0] * p_cam_projection.columns[3][3] + p_cam_projection.columns[2][0] * p_cam_projection.columns[2][3] + 1, p_cam_projection.columns[3][1] * p_cam_projection.columns[3][3] + p_cam_projection.columns[2][1] * p_cam_projection.columns[2][3] + 1);
-	return Rect2(bottom_left, 2 * half_extents);
-}
-
 void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
 	if (!buffers.has(p_buffer)) {
 		return;
@@ -658,7 +593,6 @@ void RaycastOcclusionCull::_init_embree() {
 RaycastOcclusionCull::RaycastOcclusionCull() {
 	raycast_singleton = this;
 	int default_quality = GLOBAL_GET("rendering/occlusion_culling/bvh_build_quality");
-	_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 	build_quality = RSE::ViewportOcclusionCullingBuildQuality(default_quality);
 }
 
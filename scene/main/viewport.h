@@ -147,6 +147,7 @@ public:
 		RENDER_INFO_OBJECTS_IN_FRAME,
 		RENDER_INFO_PRIMITIVES_IN_FRAME,
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_CACHED_ITEMS_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
@@ -330,6 +330,7 @@ private:
 
 	_FORCE_INLINE_ void _create_if_empty() const;
 	void _recompute_aabb();
+	void _add_surface(const RenderingServerTypes::SurfaceData &p_surface);
 
 protected:
 	virtual bool _is_generated() const { return false; }
@@ -31,6 +31,7 @@
 #include "physics_direct_space_state_2d.h"
 
 #include "core/object/class_db.h"
+#include "core/templates/frame_arena.h"
 #include "core/variant/typed_array.h"
 
 Dictionary PhysicsDirectSpaceState2D::_intersect_ray(RequiredParam<PhysicsRayQueryParameters2D> rp_ray_query) {
@@ -57,10 +58,12 @@ Dictionary PhysicsDirectSpaceState2D::_intersect_ray(RequiredParam<PhysicsRayQue
 TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_point(RequiredParam<PhysicsPointQueryParameters2D> rp_point_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, TypedArray<Dictionary>());
 
-	Vector<PS2DT::ShapeResult> ret;
+	ERR_FAIL_COND_V(p_max_results < 0, TypedArray<Dictionary>());
+
+	FrameLocalVector<PS2DT::ShapeResult> ret;
 	ret.resize(p_max_results);
 
-	int rc = intersect_point(p_point_query->get_parameters(), ret.ptrw(), ret.size());
+	int rc = intersect_point(p_point_query->get_parameters(), ret.ptr(), ret.size());
 
 	if (rc == 0) {
 		return TypedArray<Dictionary>();
@@ -82,9 +85,11 @@ TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_point(RequiredParam
 TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_shape(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, TypedArray<Dictionary>());
 
-	Vector<PS2DT::ShapeResult> sr;
+	ERR_FAIL_COND_V(p_max_results < 0, TypedArray<Dictionary>());
+
+	FrameLocalVector<PS2DT::ShapeResult> sr;
 	sr.resize(p_max_results);
-	int rc = intersect_shape(p_shape_query->get_parameters(), sr.ptrw(), sr.size());
+	int rc = intersect_shape(p_shape_query->get_parameters(), sr.ptr(), sr.size());
 	TypedArray<Dictionary> ret;
 	ret.resize(rc);
 	for (int i = 0; i < rc; i++) {
@@ -117,10 +122,12 @@ Vector<real_t> PhysicsDirectSpaceState2D::_cast_motion(RequiredParam<PhysicsShap
 TypedArray<Vector2> PhysicsDirectSpaceState2D::_collide_shape(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, TypedArray<Vector2>());
 
-	Vector<Vector2> ret;
+	ERR_FAIL_COND_V(p_max_results < 0, TypedArray<Vector2>());
+
+	FrameLocalVector<Vector2> ret;
 	ret.resize(p_max_results * 2);
 	int rc = 0;
-	bool res = collide_shape(p_shape_query->get_parameters(), ret.ptrw(), p_max_results, rc);
+	bool res = collide_shape(p_shape_query->get_parameters(), ret.ptr(), p_max_results, rc);
 	if (!res) {
 		return TypedArray<Vector2>();
 	}
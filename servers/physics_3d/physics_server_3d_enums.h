@@ -256,7 +256,9 @@ enum AreaBodyStatus {
 enum ProcessInfo {
 	INFO_ACTIVE_OBJECTS,
 	INFO_COLLISION_PAIRS,
-	INFO_ISLAND_COUNT
+	INFO_ISLAND_COUNT,
+	INFO_TEMP_MEMORY_PEAK,
+	INFO_TEMP_MEMORY_CAPACITY
 };
 
 #ifndef DISABLE_DEPRECATED
@@ -31,6 +31,7 @@
 #include "material_storage.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 using namespace RendererDummy;
 
@@ -158,9 +159,7 @@ void MaterialStorage::shader_free(RID p_rid) {
 	shader_owner.free(p_rid);
 }
 
-void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
-	DummyShader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL(shader);
+void MaterialStorage::_shader_compile(DummyShader *p_shader, const String &p_code) {
 	if (p_code.is_empty()) {
 		return;
 	}
@@ -185,13 +184,53 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		ERR_FAIL_MSG("Shader type " + mode_string + " not supported in Dummy renderer.");
 	}
 	ShaderCompiler::IdentifierActions actions;
-	actions.uniforms = &shader->uniforms;
+	actions.uniforms = &p_shader->uniforms;
 	ShaderCompiler::GeneratedCode gen_code;
 
-	Error err = MaterialStorage::get_singleton()->dummy_compiler.compile(new_mode, p_code, &actions, "", gen_code);
+	Error err = dummy_compiler.compile(new_mode, p_code, &actions, "", gen_code);
 	ERR_FAIL_COND_MSG(err != OK, "Shader compilation failed.");
 }
 
+void MaterialStorage::_shader_compile_task(uint32_t p_index, ShaderCodeBatch *p_batch) {
+	_shader_compile(p_batch->shaders[p_index], p_batch->codes[p_index]);
+}
+
+void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
+	DummyShader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+	_shader_compile(shader, p_code);
+}
+
+void MaterialStorage::shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+
+	// Only the last code set for each shader matters.
+	HashMap<RID, int> last_index;
+	for (int i = 0; i < p_shaders.size(); i++) {
+		last_index[p_shaders[i]] = i;
+	}
+
+	// Shaders are still compiled here to know their uniforms, which is all parsing and no GPU work,
+	// so each one gets its own task. The owner isn't thread-safe, so look them up beforehand.
+	ShaderCodeBatch batch;
+	for (int i = 0; i < p_shaders.size(); i++) {
+		if (last_index[p_shaders[i]] != i) {
+			continue;
+		}
+		DummyShader *shader = shader_owner.get_or_null(p_shaders[i]);
+		ERR_CONTINUE(!shader);
+		batch.shaders.push_back(shader);
+		batch.codes.push_back(p_codes[i]);
+	}
+
+	if (batch.shaders.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MaterialStorage::_shader_compile_task, &batch, batch.shaders.size(), -1, true, SNAME("ShaderCompile"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
 	DummyShader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -52,6 +52,14 @@ private:
 
 	mutable RID_Owner<DummyShader> shader_owner;
 
+	struct ShaderCodeBatch {
+		LocalVector<DummyShader *> shaders;
+		LocalVector<String> codes;
+	};
+
+	void _shader_compile(DummyShader *p_shader, const String &p_code);
+	void _shader_compile_task(uint32_t p_index, ShaderCodeBatch *p_batch);
+
 	ShaderCompiler dummy_compiler;
 	HashSet<RID> dummy_embedded_set;
 
@@ -95,6 +103,7 @@ public:
 	virtual void shader_free(RID p_rid) override;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) override;
+	virtual void shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) override;
 	virtual void shader_set_path_hint(RID p_shader, const String &p_code) override {}
 
 	virtual String shader_get_code(RID p_shader) const override { return ""; }
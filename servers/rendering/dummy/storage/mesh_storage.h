@@ -218,6 +218,9 @@ public:
 
 	MultiMeshInterpolator *_multimesh_get_interpolator(RID p_multimesh) const override { return nullptr; }
 
+	virtual void multimesh_cull_chunks(RID p_multimesh, const Transform3D &p_transform, const Vector<Plane> &p_planes) override {}
+	virtual void update_multimesh_chunks() override {}
+
 	/* SKELETON API */
 
 	virtual RID skeleton_allocate() override { return RID(); }
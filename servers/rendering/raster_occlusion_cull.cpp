@@ -0,0 +1,684 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Four pixels of a row are processed at once. Every lane holds either an edge function
+// value or a depth key for one pixel.
+#if defined(__SSE2__)
+typedef __m128 Lanes;
+
+_FORCE_INLINE_ Lanes lanes_set(float p_value) {
+	return _mm_set1_ps(p_value);
+}
+
+_FORCE_INLINE_ Lanes lanes_ramp(float p_base, float p_step) {
+	return _mm_setr_ps(p_base, p_base + p_step, p_base + 2.0f * p_step, p_base + 3.0f * p_step);
+}
+
+_FORCE_INLINE_ Lanes lanes_add(Lanes p_a, Lanes p_b) {
+	return _mm_add_ps(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_load(const float *p_ptr) {
+	return _mm_loadu_ps(p_ptr);
+}
+
+_FORCE_INLINE_ void lanes_store(float *p_ptr, Lanes p_value) {
+	_mm_storeu_ps(p_ptr, p_value);
+}
+
+// Keeps the largest key in every lane that lies inside all three edges.
+_FORCE_INLINE_ Lanes lanes_max_inside(Lanes p_current, Lanes p_key, Lanes p_e0, Lanes p_e1, Lanes p_e2) {
+	const __m128 zero = _mm_setzero_ps();
+	__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(p_e0, zero), _mm_cmpge_ps(p_e1, zero)), _mm_cmpge_ps(p_e2, zero));
+	return _mm_or_ps(_mm_and_ps(inside, _mm_max_ps(p_current, p_key)), _mm_andnot_ps(inside, p_current));
+}
+#elif defined(__ARM_NEON)
+typedef float32x4_t Lanes;
+
+_FORCE_INLINE_ Lanes lanes_set(float p_value) {
+	return vdupq_n_f32(p_value);
+}
+
+_FORCE_INLINE_ Lanes lanes_ramp(float p_base, float p_step) {
+	const float values[4] = { p_base, p_base + p_step, p_base + 2.0f * p_step, p_base + 3.0f * p_step };
+	return vld1q_f32(values);
+}
+
+_FORCE_INLINE_ Lanes lanes_add(Lanes p_a, Lanes p_b) {
+	return vaddq_f32(p_a, p_b);
+}
+
+_FORCE_INLINE_ Lanes lanes_load(const float *p_ptr) {
+	return vld1q_f32(p_ptr);
+}
+
+_FORCE_INLINE_ void lanes_store(float *p_ptr, Lanes p_value) {
+	vst1q_f32(p_ptr, p_value);
+}
+
+// Keeps the largest key in every lane that lies inside all three edges.
+_FORCE_INLINE_ Lanes lanes_max_inside(Lanes p_current, Lanes p_key, Lanes p_e0, Lanes p_e1, Lanes p_e2) {
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(p_e0, zero), vcgeq_f32(p_e1, zero)), vcgeq_f32(p_e2, zero));
+	return vbslq_f32(inside, vmaxq_f32(p_current, p_key), p_current);
+}
+#else
+struct Lanes {
+	float v[4];
+};
+
+_FORCE_INLINE_ Lanes lanes_set(float p_value) {
+	return Lanes{ { p_value, p_value, p_value, p_value } };
+}
+
+_FORCE_INLINE_ Lanes lanes_ramp(float p_base, float p_step) {
+	return Lanes{ { p_base, p_base + p_step, p_base + 2.0f * p_step, p_base + 3.0f * p_step } };
+}
+
+_FORCE_INLINE_ Lanes lanes_add(const Lanes &p_a, const Lanes &p_b) {
+	return Lanes{ { p_a.v[0] + p_b.v[0], p_a.v[1] + p_b.v[1], p_a.v[2] + p_b.v[2], p_a.v[3] + p_b.v[3] } };
+}
+
+_FORCE_INLINE_ Lanes lanes_load(const float *p_ptr) {
+	return Lanes{ { p_ptr[0], p_ptr[1], p_ptr[2], p_ptr[3] } };
+}
+
+_FORCE_INLINE_ void lanes_store(float *p_ptr, const Lanes &p_value) {
+	memcpy(p_ptr, p_value.v, sizeof(p_value.v));
+}
+
+// Keeps the largest key in every lane that lies inside all three edges.
+_FORCE_INLINE_ Lanes lanes_max_inside(const Lanes &p_current, const Lanes &p_key, const Lanes &p_e0, const Lanes &p_e1, const Lanes &p_e2) {
+	Lanes result = p_current;
+	for (int i = 0; i < 4; i++) {
+		if (p_e0.v[i] >= 0.0f && p_e1.v[i] >= 0.0f && p_e2.v[i] >= 0.0f) {
+			result.v[i] = MAX(result.v[i], p_key.v[i]);
+		}
+	}
+	return result;
+}
+#endif
+
+} // namespace
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	keys.clear();
+	key_stride = 0;
+	bins.clear();
+	bin_count = 0;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	key_stride = (p_size.x + 3) & ~3;
+	keys.resize(key_stride * p_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Transform3D &p_cam_transform, const Vector2 &p_near_bottom_left, const Vector2 &p_near_extents, real_t p_z_near, real_t p_z_far, bool p_cam_orthogonal) {
+	RasterThreadData td;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.near_bottom_left = p_near_bottom_left;
+	td.near_extents = p_near_extents;
+	td.z_near = p_z_near;
+	td.z_far = p_z_far * 1.05f;
+	td.camera_orthogonal = p_cam_orthogonal;
+
+	debug_tex_range = td.z_far;
+
+	if (bin_count > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_triangles_threaded, &td, bin_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	int band_count = (sizes[0].y + BAND_HEIGHT - 1) / BAND_HEIGHT;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band_threaded, &td, band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangles_threaded(uint32_t p_bin, const RasterThreadData *p_data) {
+	Bin &bin = bins[p_bin];
+	bin.triangles.clear();
+
+	const OccluderInstance *instance = bin.instance;
+	uint32_t vertex_count = instance->xformed_vertices.size();
+	bin.view_vertices.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		bin.view_vertices[i] = p_data->cam_inv_transform.xform(instance->xformed_vertices[i]);
+	}
+
+	const real_t near_z = -p_data->z_near;
+	const uint32_t *indices = instance->indices.ptr();
+	uint32_t index_count = instance->indices.size() - instance->indices.size() % 3;
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) {
+			continue;
+		}
+
+		const Vector3 triangle[3] = { bin.view_vertices[indices[i]], bin.view_vertices[indices[i + 1]], bin.view_vertices[indices[i + 2]] };
+		int inside_count = (triangle[0].z <= near_z) + (triangle[1].z <= near_z) + (triangle[2].z <= near_z);
+
+		if (inside_count == 0) {
+			continue;
+		}
+
+		if (inside_count == 3) {
+			_add_triangle(bin, triangle, p_data);
+			continue;
+		}
+
+		// Clip against the near plane, this leaves either a triangle or a quad.
+		Vector3 polygon[4];
+		int polygon_size = 0;
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &a = triangle[j];
+			const Vector3 &b = triangle[(j + 1) % 3];
+			bool a_inside = a.z <= near_z;
+			if (a_inside) {
+				polygon[polygon_size++] = a;
+			}
+			if (a_inside != (b.z <= near_z)) {
+				polygon[polygon_size++] = a.lerp(b, (near_z - a.z) / (b.z - a.z));
+			}
+		}
+
+		_add_triangle(bin, polygon, p_data);
+		if (polygon_size == 4) {
+			const Vector3 second[3] = { polygon[0], polygon[2], polygon[3] };
+			_add_triangle(bin, second, p_data);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(Bin &r_bin, const Vector3 p_view[3], const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+	const float scale_x = buffer_size.x / p_data->near_extents.x;
+	const float scale_y = buffer_size.y / p_data->near_extents.y;
+
+	float sx[3];
+	float sy[3];
+	float key[3];
+
+	for (int i = 0; i < 3; i++) {
+		float x = p_view[i].x;
+		float y = p_view[i].y;
+		if (p_data->camera_orthogonal) {
+			key[i] = p_view[i].z;
+		} else {
+			// Project onto the near plane, 1/depth is linear in screen space.
+			float inv_depth = 1.0f / -p_view[i].z;
+			x *= p_data->z_near * inv_depth;
+			y *= p_data->z_near * inv_depth;
+			key[i] = inv_depth;
+		}
+		sx[i] = (x - p_data->near_bottom_left.x) * scale_x;
+		sy[i] = (y - p_data->near_bottom_left.y) * scale_y;
+	}
+
+	float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+	if (Math::abs(area) < 1e-6f) {
+		return;
+	}
+
+	if (area < 0.0f) {
+		// Make the winding counter-clockwise, occluders are double sided.
+		SWAP(sx[1], sx[2]);
+		SWAP(sy[1], sy[2]);
+		SWAP(key[1], key[2]);
+		area = -area;
+	}
+
+	float min_x = MIN(sx[0], MIN(sx[1], sx[2]));
+	float max_x = MAX(sx[0], MAX(sx[1], sx[2]));
+	float min_y = MIN(sy[0], MIN(sy[1], sy[2]));
+	float max_y = MAX(sy[0], MAX(sy[1], sy[2]));
+
+	if (max_x < 0.0f || max_y < 0.0f || min_x > buffer_size.x || min_y > buffer_size.y) {
+		return;
+	}
+
+	Triangle triangle;
+	triangle.min_x = CLAMP(Math::floor(min_x), 0.0f, buffer_size.x - 1.0f);
+	triangle.max_x = CLAMP(Math::ceil(max_x), 0.0f, buffer_size.x - 1.0f);
+	triangle.min_y = CLAMP(Math::floor(min_y), 0.0f, buffer_size.y - 1.0f);
+	triangle.max_y = CLAMP(Math::ceil(max_y), 0.0f, buffer_size.y - 1.0f);
+
+	// Edge functions and key plane are evaluated at pixel centers, so the half pixel offset is folded into c.
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		float a = sy[i] - sy[j];
+		float b = sx[j] - sx[i];
+		float c = -(a * sx[i] + b * sy[i]);
+		triangle.edges[i][0] = a;
+		triangle.edges[i][1] = b;
+		triangle.edges[i][2] = c + 0.5f * (a + b);
+	}
+
+	float dx1 = sx[1] - sx[0];
+	float dy1 = sy[1] - sy[0];
+	float dx2 = sx[2] - sx[0];
+	float dy2 = sy[2] - sy[0];
+	float dk1 = key[1] - key[0];
+	float dk2 = key[2] - key[0];
+	float key_a = (dk1 * dy2 - dk2 * dy1) / area;
+	float key_b = (dk2 * dx1 - dk1 * dx2) / area;
+	triangle.key[0] = key_a;
+	triangle.key[1] = key_b;
+	triangle.key[2] = key[0] - key_a * sx[0] - key_b * sy[0] + 0.5f * (key_a + key_b);
+
+	r_bin.triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band_threaded(uint32_t p_band, const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+	const int y_from = p_band * BAND_HEIGHT;
+	const int y_to = MIN(buffer_size.y, y_from + BAND_HEIGHT);
+
+	float *band_keys = keys.ptr();
+	for (uint32_t i = y_from * key_stride; i < y_to * key_stride; i++) {
+		band_keys[i] = -FLT_MAX;
+	}
+
+	for (uint32_t i = 0; i < bin_count; i++) {
+		for (const Triangle &triangle : bins[i].triangles) {
+			if (triangle.max_y < y_from || triangle.min_y >= y_to) {
+				continue;
+			}
+
+			const int row_from = MAX(triangle.min_y, y_from);
+			const int row_to = MIN(triangle.max_y + 1, y_to);
+			const int x_from = triangle.min_x & ~3;
+
+			const Lanes e0_step = lanes_set(4.0f * triangle.edges[0][0]);
+			const Lanes e1_step = lanes_set(4.0f * triangle.edges[1][0]);
+			const Lanes e2_step = lanes_set(4.0f * triangle.edges[2][0]);
+			const Lanes key_step = lanes_set(4.0f * triangle.key[0]);
+
+			for (int y = row_from; y < row_to; y++) {
+				float *row = &band_keys[y * key_stride];
+
+				Lanes e0 = lanes_ramp(triangle.edges[0][0] * x_from + triangle.edges[0][1] * y + triangle.edges[0][2], triangle.edges[0][0]);
+				Lanes e1 = lanes_ramp(triangle.edges[1][0] * x_from + triangle.edges[1][1] * y + triangle.edges[1][2], triangle.edges[1][0]);
+				Lanes e2 = lanes_ramp(triangle.edges[2][0] * x_from + triangle.edges[2][1] * y + triangle.edges[2][2], triangle.edges[2][0]);
+				Lanes key = lanes_ramp(triangle.key[0] * x_from + triangle.key[1] * y + triangle.key[2], triangle.key[0]);
+
+				for (int x = x_from; x <= triangle.max_x; x += 4) {
+					lanes_store(row + x, lanes_max_inside(lanes_load(row + x), key, e0, e1, e2));
+					e0 = lanes_add(e0, e0_step);
+					e1 = lanes_add(e1, e1_step);
+					e2 = lanes_add(e2, e2_step);
+					key = lanes_add(key, key_step);
+				}
+			}
+		}
+	}
+
+	// Resolve the keys into the same distances the raycast backend stores in mip 0.
+	const float z_far = p_data->z_far;
+	const float z_near_squared = p_data->z_near * p_data->z_near;
+	const float pixel_width = p_data->near_extents.x / buffer_size.x;
+	const float pixel_height = p_data->near_extents.y / buffer_size.y;
+
+	for (int y = y_from; y < y_to; y++) {
+		const float *row = &band_keys[y * key_stride];
+		float *depth = &mips[0][y * buffer_size.x];
+		float py = p_data->near_bottom_left.y + (y + 0.5f) * pixel_height;
+
+		for (int x = 0; x < buffer_size.x; x++) {
+			float key = row[x];
+			float distance = z_far;
+			if (key != -FLT_MAX) {
+				if (p_data->camera_orthogonal) {
+					distance = -key;
+				} else {
+					float px = p_data->near_bottom_left.x + (x + 0.5f) * pixel_width;
+					distance = Math::sqrt(px * px + py * py + z_near_squared) / (p_data->z_near * key);
+				}
+			}
+			depth[x] = MIN(distance, z_far);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+
+	for (KeyValue<RID, RasterHZBuffer> &E : buffers) {
+		if (E.value.scenario_rid == p_scenario) {
+			// The bins point into the scenario instances.
+			E.value.bin_count = 0;
+		}
+	}
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	// Disabled instances are skipped when rasterizing, no update needed.
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance_thread(int p_idx, RID *p_instances) {
+	_update_dirty_instance(p_idx, p_instances);
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(int p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		occ_inst->aabb = AABB();
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertices_size);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	AABB aabb;
+
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+		if (i == 0) {
+			aabb.position = write_ptr[i];
+		} else {
+			aabb.expand_to(write_ptr[i]);
+		}
+	}
+
+	occ_inst->aabb = aabb;
+	occ_inst->indices.resize(occ->indices.size());
+	memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	ERR_FAIL_NULL(raster_singleton);
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance_thread, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	} else {
+		for (unsigned int i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+	buffers[p_buffer].bin_count = 0;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	// Only occluders inside the camera frustum are rasterized.
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	buffer.bin_count = 0;
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.indices.is_empty()) {
+			continue;
+		}
+
+		bool inside = true;
+		for (const Plane &plane : planes) {
+			if (plane.distance_to(instance.aabb.get_support(-plane.normal)) > 0) {
+				inside = false;
+				break;
+			}
+		}
+
+		if (!inside) {
+			continue;
+		}
+
+		if (buffer.bin_count == buffer.bins.size()) {
+			buffer.bins.resize(buffer.bin_count + 1);
+		}
+		buffer.bins[buffer.bin_count++].instance = &instance;
+	}
+
+	Rect2 vp_rect = _get_viewport_rect(p_cam_projection);
+	Vector2 bottom_left = vp_rect.position;
+	bottom_left += _get_jitter(vp_rect, buffer.get_occlusion_buffer_size());
+
+	buffer.rasterize(p_cam_transform, bottom_left, vp_rect.get_size(), p_cam_projection.get_z_near(), p_cam_projection.get_z_far(), p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
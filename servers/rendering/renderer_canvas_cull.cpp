@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering/renderer_viewport.h"
 #include "servers/rendering/rendering_server_default.h"
 #include "servers/rendering/rendering_server_globals.h"
@@ -76,26 +77,75 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	// transform is normally concatenated with the item global transform.
 	_current_camera_transform = p_transform;
 
-	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	// Top-level subtrees are independent of each other, so they can be culled on multiple threads
+	// as long as the per-task buckets are merged in the original order.
+	uint32_t task_count = 1;
+	if (p_child_item_count > 1 && canvas_item_owner.get_rid_count() >= thread_cull_threshold) {
+		task_count = MIN((uint32_t)p_child_item_count, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	}
+
+	while (cull_buckets.size() < task_count) {
+		CullBuckets buckets;
+		buckets.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		buckets.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		cull_buckets.push_back(buckets);
+	}
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+	for (uint32_t i = 0; i < task_count; i++) {
+		memset(cull_buckets[i].z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		memset(cull_buckets[i].z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		cull_buckets[i].visible_notifiers.clear();
+		cull_buckets[i].redraw_requested = false;
+	}
+
+	if (task_count == 1) {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, cull_buckets[0], nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
+	} else {
+		CullThreadData td;
+		td.child_items = p_child_items;
+		td.child_item_count = p_child_item_count;
+		td.task_count = task_count;
+		td.transform = p_transform;
+		td.clip_rect = p_clip_rect;
+		td.canvas_cull_mask = p_canvas_cull_mask;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_tree_threaded, &td, task_count, -1, true, SNAME("RenderCanvasCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
 	RendererCanvasRender::Item *list_end = nullptr;
 
 	for (int i = 0; i < z_range; i++) {
-		if (!z_list[i]) {
-			continue;
+		for (uint32_t j = 0; j < task_count; j++) {
+			const CullBuckets &buckets = cull_buckets[j];
+			if (!buckets.z_list[i]) {
+				continue;
+			}
+			if (!list) {
+				list = buckets.z_list[i];
+				list_end = buckets.z_last_list[i];
+			} else {
+				list_end->next = buckets.z_list[i];
+				list_end = buckets.z_last_list[i];
+			}
 		}
-		if (!list) {
-			list = z_list[i];
-			list_end = z_last_list[i];
-		} else {
-			list_end->next = z_list[i];
-			list_end = z_last_list[i];
+	}
+
+	// Shared state is only touched once culling is done.
+	for (uint32_t i = 0; i < task_count; i++) {
+		CullBuckets &buckets = cull_buckets[i];
+		if (buckets.redraw_requested) {
+			RenderingServerDefault::redraw_request();
+		}
+
+		for (Item::VisibilityNotifierData *visibility_notifier : buckets.visible_notifiers) {
+			if (!visibility_notifier->visible_element.in_list()) {
+				visibility_notifier_list.add(&visibility_notifier->visible_element);
+				visibility_notifier->just_visible = true;
+			}
 		}
 	}
 
@@ -108,6 +158,15 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_item_tree_threaded(uint32_t p_task, const CullThreadData *p_data) {
+	int from = p_task * p_data->child_item_count / p_data->task_count;
+	int to = (p_task + 1 == p_data->task_count) ? p_data->child_item_count : ((p_task + 1) * p_data->child_item_count / p_data->task_count);
+
+	for (int i = from; i < to; i++) {
+		_cull_canvas_item(p_data->child_items[i].item, p_data->transform, p_data->clip_rect, Color(1, 1, 1, 1), 0, cull_buckets[p_task], nullptr, nullptr, false, p_data->canvas_cull_mask, Point2(), 1, nullptr);
+	}
+}
+
 void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int &r_ysort_children_count, int p_z, uint32_t p_canvas_cull_mask) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
@@ -182,14 +241,64 @@ int RendererCanvasCull::_count_ysort_children(RendererCanvasCull::Item *p_canvas
 	return ysort_children_count;
 }
 
+void RendererCanvasCull::_sort_ysort_children(RendererCanvasCull::Item *p_ysort_root, RendererCanvasCull::Item **r_items, int p_item_count) {
+	LocalVector<Item *> &order = p_ysort_root->ysort_order;
+
+	// The previous order can only be reused if it holds exactly the items collected this time.
+	uint32_t stamp = ++p_ysort_root->ysort_order_stamp;
+	for (int i = 0; i < p_item_count; i++) {
+		r_items[i]->ysort_stamp = stamp;
+	}
+
+	bool sorted = false;
+	if (order.size() == (uint32_t)p_item_count) {
+		bool same_items = true;
+		for (const Item *item : order) {
+			if (item->ysort_stamp != stamp) {
+				same_items = false;
+				break;
+			}
+		}
+
+		if (same_items) {
+			// Starting from the previous order, only items that moved need to be shifted.
+			// Give up and do a full sort if too many of them did.
+			memcpy(r_items, order.ptr(), p_item_count * sizeof(Item *));
+
+			ItemYSort compare;
+			int shift_budget = p_item_count * 4;
+			for (int i = 1; i < p_item_count && shift_budget >= 0; i++) {
+				Item *item = r_items[i];
+				int j = i;
+				while (j > 0 && compare(item, r_items[j - 1])) {
+					r_items[j] = r_items[j - 1];
+					j--;
+					shift_budget--;
+				}
+				r_items[j] = item;
+			}
+			sorted = shift_budget >= 0;
+		}
+	}
+
+	if (!sorted) {
+		SortArray<Item *, ItemYSort> sorter;
+		sorter.sort(r_items, p_item_count);
+	}
+
+	order.resize(p_item_count);
+	memcpy(order.ptr(), r_items, p_item_count * sizeof(Item *));
+}
+
 void RendererCanvasCull::_mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
+		ysort_owner->ysort_order.clear();
 		ysort_owner = canvas_item_owner.owns(ysort_owner->parent) ? canvas_item_owner.get_or_null(ysort_owner->parent) : nullptr;
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
+void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, CullBuckets &r_buckets, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
 	}
@@ -198,7 +307,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
 		if (r_canvas_group_from == nullptr) {
 			// no list before processing this item, means must put stuff in group from the beginning of list.
-			r_canvas_group_from = r_z_list[zidx];
+			r_canvas_group_from = r_buckets.z_list[zidx];
 		} else {
 			// there was a list before processing, so begin group from this one.
 			r_canvas_group_from = r_canvas_group_from->next;
@@ -261,7 +370,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		// Something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			r_buckets.redraw_requested = true;
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -273,13 +382,13 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 			int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
 
-			if (r_z_last_list[zidx]) {
-				r_z_last_list[zidx]->next = ci;
-				r_z_last_list[zidx] = ci;
+			if (r_buckets.z_last_list[zidx]) {
+				r_buckets.z_last_list[zidx]->next = ci;
+				r_buckets.z_last_list[zidx] = ci;
 
 			} else {
-				r_z_list[zidx] = ci;
-				r_z_last_list[zidx] = ci;
+				r_buckets.z_list[zidx] = ci;
+				r_buckets.z_last_list[zidx] = ci;
 			}
 
 			ci->z_final = p_z;
@@ -288,11 +397,8 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 
 		if (ci->visibility_notifier) {
-			if (!ci->visibility_notifier->visible_element.in_list()) {
-				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
-				ci->visibility_notifier->just_visible = true;
-			}
-
+			// Added to the notifier list once culling is done, as it may run on multiple threads.
+			r_buckets.visible_notifiers.push_back(ci->visibility_notifier);
 			ci->visibility_notifier->visible_in_frame = RSG::rasterizer->get_frame_number();
 		}
 	} else if (ci->repeat_source) {
@@ -301,7 +407,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
-void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
+void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CullBuckets &r_buckets, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
 	Item *ci = p_canvas_item;
 
 	if (!ci->visible) {
@@ -452,42 +558,41 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			int i = 1;
 			_collect_ysort_children(ci, p_material_owner, Color(1, 1, 1, 1), child_items, i, child_item_count, p_z, p_canvas_cull_mask);
 
-			SortArray<Item *, ItemYSort> sorter;
-			sorter.sort(child_items, child_item_count);
+			_sort_ysort_children(ci, child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_buckets, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
 			bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 			if (use_canvas_group) {
 				int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
-				canvas_group_from = r_z_last_list[zidx];
+				canvas_group_from = r_buckets.z_last_list[zidx];
 			}
 
-			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_buckets, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		}
 	} else {
 		RendererCanvasRender::Item *canvas_group_from = nullptr;
 		bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 		if (use_canvas_group) {
 			int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
-			canvas_group_from = r_z_last_list[zidx];
+			canvas_group_from = r_buckets.z_last_list[zidx];
 		}
 
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_buckets, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
-		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_buckets, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		for (int i = 0; i < child_item_count; i++) {
 			if (child_items[i]->behind || use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_buckets, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 	}
 }
@@ -2826,17 +2931,17 @@ void RendererCanvasCull::InterpolationData::notify_free_canvas_light_occluder(RI
 RendererCanvasCull::RendererCanvasCull() {
 	_canvas_cull_singleton = this;
 
-	z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
-	z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
-
 	disable_scale = false;
+	thread_cull_threshold = GLOBAL_GET("rendering/2d/canvas_cull/threaded_cull_minimum_items");
 
 	debug_redraw_time = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "debug/canvas_items/debug_redraw_time", PROPERTY_HINT_RANGE, "0.1,2,0.001,or_greater"), 1.0);
 	debug_redraw_color = GLOBAL_DEF(PropertyInfo(Variant::COLOR, "debug/canvas_items/debug_redraw_color"), Color(1.0, 0.2, 0.2, 0.5));
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
-	memfree(z_list);
-	memfree(z_last_list);
+	for (CullBuckets &buckets : cull_buckets) {
+		memfree(buckets.z_list);
+		memfree(buckets.z_last_list);
+	}
 	_canvas_cull_singleton = nullptr;
 }
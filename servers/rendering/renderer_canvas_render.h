@@ -378,6 +378,15 @@ public:
 		Command *last_command = nullptr;
 		Vector<CommandBlock> blocks;
 		uint32_t current_block;
+		// Incremented every time the command list changes.
+		uint32_t commands_version = 0;
+
+		// Renderer specific data derived from the commands (such as recorded batches),
+		// owned by the item. Renderers must validate it against commands_version.
+		struct RenderCache {
+			virtual ~RenderCache() {}
+		};
+		mutable RenderCache *render_cache = nullptr;
 #ifdef DEBUG_ENABLED
 		mutable double debug_redraw_time = 0;
 #endif
@@ -426,6 +435,7 @@ public:
 			}
 
 			rect_dirty = true;
+			commands_version++;
 			return command;
 		}
 
@@ -454,6 +464,7 @@ public:
 			last_command = nullptr;
 			commands = nullptr;
 			current_block = 0;
+			commands_version++;
 			clip = false;
 			rect_dirty = true;
 			final_clip_owner = nullptr;
@@ -498,6 +509,7 @@ public:
 				memfree(blocks[i].memory);
 			}
 			memdelete(copy_back_buffer);
+			memdelete(render_cache);
 		}
 	};
 
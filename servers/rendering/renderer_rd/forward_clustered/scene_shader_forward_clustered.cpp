@@ -39,18 +39,24 @@
 using namespace RendererSceneRenderImplementation;
 
 void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
+	parse_code(p_code);
+	apply_parsed_code();
+}
+
+void SceneShaderForwardClustered::ShaderData::parse_code(const String &p_code) {
 	//compile
 
 	code = p_code;
 	ubo_size = 0;
 	uniforms.clear();
 	_clear_vertex_input_mask_cache();
+	parsed_code = ShaderCompiler::GeneratedCode();
 
 	if (code.is_empty()) {
 		return; //just invalid, but no error
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
+	ShaderCompiler::GeneratedCode &gen_code = parsed_code;
 
 	blend_mode = BLEND_MODE_MIX;
 	depth_test_disabledi = 0;
@@ -171,22 +177,9 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	Error err = OK;
-	{
-		MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
-		err = SceneShaderForwardClustered::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &actions, path, gen_code);
-	}
-
-	if (err != OK) {
-		if (version.is_valid()) {
-			SceneShaderForwardClustered::singleton->shader.version_free(version);
-			version = RID();
-		}
-		ERR_FAIL_MSG("Shader compilation failed.");
-	}
-
-	if (version.is_null()) {
-		version = SceneShaderForwardClustered::singleton->shader.version_create(false);
+	parse_error = SceneShaderForwardClustered::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &actions, path, gen_code);
+	if (parse_error != OK) {
+		return;
 	}
 
 	depth_draw = DepthDraw(depth_drawi);
@@ -214,6 +207,33 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	stencil_compare = StencilCompare(stencil_comparei);
 	stencil_reference = stencil_referencei;
 
+	// If any form of Alpha Antialiasing is enabled, set the blend mode to alpha to coverage.
+	if (alpha_antialiasing_mode != ALPHA_ANTIALIASING_OFF) {
+		blend_mode = BLEND_MODE_ALPHA_TO_COVERAGE;
+	}
+
+	uses_blend_alpha = blend_mode_uses_blend_alpha(BlendMode(blend_mode));
+}
+
+void SceneShaderForwardClustered::ShaderData::apply_parsed_code() {
+	if (code.is_empty()) {
+		return;
+	}
+
+	if (parse_error != OK) {
+		if (version.is_valid()) {
+			SceneShaderForwardClustered::singleton->shader.version_free(version);
+			version = RID();
+		}
+		ERR_FAIL_MSG("Shader compilation failed.");
+	}
+
+	if (version.is_null()) {
+		version = SceneShaderForwardClustered::singleton->shader.version_create(false);
+	}
+
+	const ShaderCompiler::GeneratedCode &gen_code = parsed_code;
+
 #if 0
 	print_line("**compiling shader:");
 	print_line("**defines:\n");
@@ -239,12 +259,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 	pipeline_hash_map.clear_pipelines();
 
-	// If any form of Alpha Antialiasing is enabled, set the blend mode to alpha to coverage.
-	if (alpha_antialiasing_mode != ALPHA_ANTIALIASING_OFF) {
-		blend_mode = BLEND_MODE_ALPHA_TO_COVERAGE;
-	}
-
-	uses_blend_alpha = blend_mode_uses_blend_alpha(BlendMode(blend_mode));
+	parsed_code = ShaderCompiler::GeneratedCode();
 }
 
 bool SceneShaderForwardClustered::ShaderData::is_animated() const {
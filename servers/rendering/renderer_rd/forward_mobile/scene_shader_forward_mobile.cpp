@@ -41,18 +41,24 @@ using namespace RendererSceneRenderImplementation;
 /* ShaderData */
 
 void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
+	parse_code(p_code);
+	apply_parsed_code();
+}
+
+void SceneShaderForwardMobile::ShaderData::parse_code(const String &p_code) {
 	//compile
 
 	code = p_code;
 	ubo_size = 0;
 	uniforms.clear();
 	_clear_vertex_input_mask_cache();
+	parsed_code = ShaderCompiler::GeneratedCode();
 
 	if (code.is_empty()) {
 		return; //just invalid, but no error
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
+	ShaderCompiler::GeneratedCode &gen_code = parsed_code;
 
 	blend_mode = BLEND_MODE_MIX;
 	depth_test_disabledi = 0;
@@ -169,19 +175,9 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	MutexLock lock(SceneShaderForwardMobile::singleton_mutex);
-	Error err = SceneShaderForwardMobile::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &actions, path, gen_code);
-
-	if (err != OK) {
-		if (version.is_valid()) {
-			SceneShaderForwardMobile::singleton->shader.version_free(version);
-			version = RID();
-		}
-		ERR_FAIL_MSG("Shader compilation failed.");
-	}
-
-	if (version.is_null()) {
-		version = SceneShaderForwardMobile::singleton->shader.version_create(false);
+	parse_error = SceneShaderForwardMobile::singleton->compiler.compile(RSE::SHADER_SPATIAL, code, &actions, path, gen_code);
+	if (parse_error != OK) {
+		return;
 	}
 
 	depth_draw = DepthDraw(depth_drawi);
@@ -218,6 +214,35 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 	}
 #endif
 
+	// If any form of Alpha Antialiasing is enabled, set the blend mode to alpha to coverage.
+	if (alpha_antialiasing_mode != ALPHA_ANTIALIASING_OFF) {
+		blend_mode = BLEND_MODE_ALPHA_TO_COVERAGE;
+	}
+
+	uses_blend_alpha = blend_mode_uses_blend_alpha(BlendMode(blend_mode));
+}
+
+void SceneShaderForwardMobile::ShaderData::apply_parsed_code() {
+	if (code.is_empty()) {
+		return;
+	}
+
+	MutexLock lock(SceneShaderForwardMobile::singleton_mutex);
+
+	if (parse_error != OK) {
+		if (version.is_valid()) {
+			SceneShaderForwardMobile::singleton->shader.version_free(version);
+			version = RID();
+		}
+		ERR_FAIL_MSG("Shader compilation failed.");
+	}
+
+	if (version.is_null()) {
+		version = SceneShaderForwardMobile::singleton->shader.version_create(false);
+	}
+
+	const ShaderCompiler::GeneratedCode &gen_code = parsed_code;
+
 #if 0
 	print_line("**compiling shader:");
 	print_line("**defines:\n");
@@ -244,12 +269,7 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 
 	pipeline_hash_map.clear_pipelines();
 
-	// If any form of Alpha Antialiasing is enabled, set the blend mode to alpha to coverage.
-	if (alpha_antialiasing_mode != ALPHA_ANTIALIASING_OFF) {
-		blend_mode = BLEND_MODE_ALPHA_TO_COVERAGE;
-	}
-
-	uses_blend_alpha = blend_mode_uses_blend_alpha(BlendMode(blend_mode));
+	parsed_code = ShaderCompiler::GeneratedCode();
 }
 
 bool SceneShaderForwardMobile::ShaderData::is_animated() const {
@@ -229,6 +229,9 @@ public:
 		std::atomic<uint64_t> vertex_input_masks[VERTEX_INPUT_MASKS_SIZE] = {};
 
 		Vector<ShaderCompiler::GeneratedCode::Texture> texture_uniforms;
+		// Result of parse_code(), until apply_parsed_code() consumes it.
+		Error parse_error = OK;
+		ShaderCompiler::GeneratedCode parsed_code;
 
 		Vector<uint32_t> ubo_offsets;
 		uint32_t ubo_size = 0;
@@ -304,6 +307,9 @@ public:
 		}
 
 		virtual void set_code(const String &p_Code);
+		virtual bool supports_parse_code() const { return true; }
+		virtual void parse_code(const String &p_code);
+		virtual void apply_parsed_code();
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RenderingServerTypes::ShaderNativeSourceCode get_native_source_code() const;
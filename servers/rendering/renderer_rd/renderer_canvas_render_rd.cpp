@@ -1540,6 +1540,11 @@ void RendererCanvasRenderRD::CanvasShaderData::_create_pipeline(PipelineKey p_pi
 }
 
 void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
+	parse_code(p_code);
+	apply_parsed_code();
+}
+
+void RendererCanvasRenderRD::CanvasShaderData::parse_code(const String &p_code) {
 	//compile
 
 	code = p_code;
@@ -1550,12 +1555,13 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 	uses_sdf = false;
 	uses_time = false;
 	_clear_vertex_input_mask_cache();
+	parsed_code = ShaderCompiler::GeneratedCode();
 
 	if (code.is_empty()) {
 		return; //just invalid, but no error
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
+	ShaderCompiler::GeneratedCode &gen_code = parsed_code;
 
 	blend_mode = BLEND_MODE_MIX;
 
@@ -1578,10 +1584,23 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 	actions.uniforms = &uniforms;
 
 	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
-	MutexLock lock(canvas_singleton->shader.mutex);
+	parse_error = canvas_singleton->shader.compiler.compile(RSE::SHADER_CANVAS_ITEM, code, &actions, path, gen_code);
+	if (parse_error != OK) {
+		return;
+	}
+
+	uses_screen_texture_mipmaps = gen_code.uses_screen_texture_mipmaps;
+	uses_screen_texture = gen_code.uses_screen_texture;
+}
 
-	Error err = canvas_singleton->shader.compiler.compile(RSE::SHADER_CANVAS_ITEM, code, &actions, path, gen_code);
-	if (err != OK) {
+void RendererCanvasRenderRD::CanvasShaderData::apply_parsed_code() {
+	if (code.is_empty()) {
+		return;
+	}
+
+	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
+	MutexLock lock(canvas_singleton->shader.mutex);
+	if (parse_error != OK) {
 		if (version.is_valid()) {
 			canvas_singleton->shader.canvas_shader.version_free(version);
 			version = RID();
@@ -1589,8 +1608,7 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 		ERR_FAIL_MSG("Shader compilation failed.");
 	}
 
-	uses_screen_texture_mipmaps = gen_code.uses_screen_texture_mipmaps;
-	uses_screen_texture = gen_code.uses_screen_texture;
+	const ShaderCompiler::GeneratedCode &gen_code = parsed_code;
 
 	pipeline_hash_map.clear_pipelines();
 
@@ -1620,6 +1638,8 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
+
+	parsed_code = ShaderCompiler::GeneratedCode();
 }
 
 bool RendererCanvasRenderRD::CanvasShaderData::is_animated() const {
@@ -2234,7 +2254,13 @@ void RendererCanvasRenderRD::_render_batch_items(RenderTarget p_to_render_target
 
 			if (ci->repeat_source_item == nullptr || ci->repeat_size == Vector2()) {
 				Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
-				_record_item_commands(ci, p_to_render_target, base_transform, current_clip, p_lights, batch_broken, r_sdf_used, current_batch);
+				if (_replay_item_commands(ci, p_to_render_target, base_transform, p_lights, batch_broken, current_batch)) {
+					if (r_render_info) {
+						r_render_info->info[RSE::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RSE::VIEWPORT_RENDER_INFO_CACHED_ITEMS_IN_FRAME]++;
+					}
+				} else {
+					_record_item_commands(ci, p_to_render_target, base_transform, current_clip, p_lights, batch_broken, r_sdf_used, current_batch, true);
+				}
 			} else {
 				Point2 start_pos = ci->repeat_size * -(ci->repeat_times / 2);
 				Point2 offset;
@@ -2341,7 +2367,145 @@ void RendererCanvasRenderRD::_render_batch_items(RenderTarget p_to_render_target
 	state.canvas_instance_batches.clear();
 }
 
-void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Item *&r_current_clip, Light *p_lights, bool &r_batch_broken, bool &r_sdf_used, Batch *&r_current_batch) {
+uint16_t RendererCanvasRenderRD::_fill_item_lights(const Item *p_item, Light *p_lights, InstanceData &r_instance) const {
+	uint16_t light_count = 0;
+	uint16_t shadow_mask = 0;
+
+	Light *light = p_lights;
+
+	while (light) {
+		if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects(light->rect_cache)) {
+			uint32_t light_index = light->render_index_cache;
+			// TODO: consider making lights a per-batch property and then baking light operations in the shader for better performance.
+			r_instance.lights[light_count >> 2] |= light_index << ((light_count & 3) * 8);
+
+			if (p_item->light_mask & light->item_shadow_mask) {
+				shadow_mask |= 1 << light_count;
+			}
+
+			light_count++;
+
+			if (light_count == MAX_LIGHTS_PER_ITEM - 1) {
+				break;
+			}
+		}
+		light = light->next_ptr;
+	}
+
+	r_instance.flags |= light_count << INSTANCE_FLAGS_LIGHT_COUNT_SHIFT;
+	r_instance.flags |= shadow_mask << INSTANCE_FLAGS_SHADOW_MASKED_SHIFT;
+
+	return light_count;
+}
+
+void RendererCanvasRenderRD::_cache_item_instance(ItemRecordCache *p_cache, const Batch &p_batch, const Item::Command *p_command) {
+	if (p_cache->runs.is_empty() || !p_cache->runs[p_cache->runs.size() - 1].matches(p_batch) || p_cache->runs[p_cache->runs.size() - 1].tex_state != p_batch.tex_info->state) {
+		ItemRecordCache::Run run;
+		run.tex_state = p_batch.tex_info->state;
+		run.texpixel_size = p_batch.tex_info->texpixel_size;
+		// The batch may have been started by another item, so refer to our own command.
+		run.command = p_command;
+		run.modulate = p_batch.modulate;
+		run.msdf_pix_range = p_batch.msdf_pix_range;
+		run.msdf_outline = p_batch.msdf_outline;
+		run.command_type = p_batch.command_type;
+		run.shader_variant = p_batch.shader_variant;
+		run.render_primitive = p_batch.render_primitive;
+		run.primitive_points = p_batch.command_type == Item::Command::TYPE_PRIMITIVE ? p_batch.primitive_points : 0;
+		run.flags = p_batch.flags;
+		run.use_msdf = p_batch.use_msdf;
+		run.use_lcd = p_batch.use_lcd;
+		run.has_blend = p_batch.has_blend;
+		p_cache->runs.push_back(run);
+	}
+
+	p_cache->runs[p_cache->runs.size() - 1].instance_count++;
+	p_cache->instances.push_back(state.intermediary_instance_data);
+}
+
+bool RendererCanvasRenderRD::_replay_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Light *p_lights, bool &r_batch_broken, Batch *&r_current_batch) {
+	ItemRecordCache *cache = static_cast<ItemRecordCache *>(p_item->render_cache);
+	if (!cache || !cache->valid || cache->commands_version != p_item->commands_version) {
+		return false;
+	}
+
+#ifdef DEBUG_ENABLED
+	if (debug_redraw && p_item->debug_redraw_time > 0.0) {
+		return false;
+	}
+#endif
+
+	const RSE::CanvasItemTextureFilter texture_filter = p_item->texture_filter == RSE::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? default_filter : p_item->texture_filter;
+	const RSE::CanvasItemTextureRepeat texture_repeat = p_item->texture_repeat == RSE::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? default_repeat : p_item->texture_repeat;
+
+	if (cache->base_transform != p_base_transform || cache->final_modulate != p_item->final_modulate || cache->texture_filter != texture_filter || cache->texture_repeat != texture_repeat || cache->use_linear_colors != p_render_target.use_linear_colors || cache->instance_uniforms_ofs != static_cast<uint32_t>(p_item->instance_allocated_shader_uniforms_offset)) {
+		return false;
+	}
+
+	// Lights are assigned every frame, so the recorded indices must still match.
+	InstanceData light_data;
+	memset(&light_data, 0, sizeof(InstanceData));
+	uint16_t light_count = _fill_item_lights(p_item, p_lights, light_data);
+	bool use_lighting = (light_count > 0 || using_directional_lights);
+	if (cache->use_lighting != use_lighting || cache->flags != light_data.flags || memcmp(cache->lights, light_data.lights, sizeof(light_data.lights)) != 0) {
+		return false;
+	}
+
+	// Texture info is rebuilt every frame, and the recorded UVs depend on the texture size.
+	state.replay_tex_infos.resize(cache->runs.size());
+	for (uint32_t i = 0; i < cache->runs.size(); i++) {
+		const ItemRecordCache::Run &run = cache->runs[i];
+		TextureState tex_state = run.tex_state;
+		TextureInfo *tex_info = texture_info_map.getptr(tex_state);
+		if (!tex_info) {
+			tex_info = &texture_info_map.insert(tex_state, TextureInfo())->value;
+			_prepare_batch_texture_info(tex_state.texture, tex_state, tex_info);
+		}
+		if (tex_info->texpixel_size != run.texpixel_size) {
+			return false;
+		}
+		state.replay_tex_infos[i] = tex_info;
+	}
+
+	if (use_lighting != r_current_batch->use_lighting) {
+		r_current_batch = _new_batch(r_batch_broken);
+		r_current_batch->use_lighting = use_lighting;
+	}
+
+	const InstanceData *instance = cache->instances.ptr();
+	for (uint32_t i = 0; i < cache->runs.size(); i++) {
+		const ItemRecordCache::Run &run = cache->runs[i];
+		TextureInfo *tex_info = state.replay_tex_infos[i];
+
+		if (!run.matches(*r_current_batch) || r_current_batch->tex_info != tex_info) {
+			r_current_batch = _new_batch(r_batch_broken);
+			r_current_batch->command_type = run.command_type;
+			r_current_batch->command = run.command;
+			r_current_batch->shader_variant = run.shader_variant;
+			r_current_batch->render_primitive = run.render_primitive;
+			r_current_batch->flags = run.flags;
+			r_current_batch->has_blend = run.has_blend;
+			r_current_batch->modulate = run.modulate;
+			r_current_batch->use_msdf = run.use_msdf;
+			r_current_batch->msdf_pix_range = run.msdf_pix_range;
+			r_current_batch->msdf_outline = run.msdf_outline;
+			r_current_batch->use_lcd = run.use_lcd;
+			r_current_batch->primitive_points = run.primitive_points;
+			r_current_batch->tex_info = tex_info;
+		}
+
+		for (uint32_t j = 0; j < run.instance_count; j++) {
+			memcpy(&state.intermediary_instance_data, instance++, sizeof(InstanceData));
+			_add_to_batch(r_batch_broken, r_current_batch);
+		}
+
+		r_batch_broken = false;
+	}
+
+	return true;
+}
+
+void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Item *&r_current_clip, Light *p_lights, bool &r_batch_broken, bool &r_sdf_used, Batch *&r_current_batch, bool p_use_cache) {
 	const RSE::CanvasItemTextureFilter texture_filter = p_item->texture_filter == RSE::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? default_filter : p_item->texture_filter;
 	const RSE::CanvasItemTextureRepeat texture_repeat = p_item->texture_repeat == RSE::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? default_repeat : p_item->texture_repeat;
 
@@ -2361,34 +2525,7 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 
 	bool skipping = false;
 
-	uint16_t light_count = 0;
-	uint16_t shadow_mask = 0;
-
-	{
-		Light *light = p_lights;
-
-		while (light) {
-			if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects(light->rect_cache)) {
-				uint32_t light_index = light->render_index_cache;
-				// TODO: consider making lights a per-batch property and then baking light operations in the shader for better performance.
-				template_instance.lights[light_count >> 2] |= light_index << ((light_count & 3) * 8);
-
-				if (p_item->light_mask & light->item_shadow_mask) {
-					shadow_mask |= 1 << light_count;
-				}
-
-				light_count++;
-
-				if (light_count == MAX_LIGHTS_PER_ITEM - 1) {
-					break;
-				}
-			}
-			light = light->next_ptr;
-		}
-
-		template_instance.flags |= light_count << INSTANCE_FLAGS_LIGHT_COUNT_SHIFT;
-		template_instance.flags |= shadow_mask << INSTANCE_FLAGS_SHADOW_MASKED_SHIFT;
-	}
+	uint16_t light_count = _fill_item_lights(p_item, p_lights, template_instance);
 
 	bool use_lighting = (light_count > 0 || using_directional_lights);
 
@@ -2397,6 +2534,39 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 		r_current_batch->use_lighting = use_lighting;
 	}
 
+	// Only keep a copy of the generated instances once the commands have stayed
+	// the same for more than one frame, so items redrawn every frame don't pay for it.
+	ItemRecordCache *cache = nullptr;
+	if (p_use_cache) {
+		cache = static_cast<ItemRecordCache *>(p_item->render_cache);
+		if (!cache) {
+			cache = memnew(ItemRecordCache);
+			cache->commands_version = p_item->commands_version;
+			p_item->render_cache = cache;
+			cache = nullptr;
+		} else if (cache->commands_version != p_item->commands_version) {
+			cache->commands_version = p_item->commands_version;
+			cache->cacheable = true;
+			cache->valid = false;
+			cache = nullptr;
+		} else if (!cache->cacheable) {
+			cache = nullptr;
+		} else {
+			cache->valid = false;
+			cache->base_transform = p_base_transform;
+			cache->final_modulate = p_item->final_modulate;
+			cache->texture_filter = texture_filter;
+			cache->texture_repeat = texture_repeat;
+			cache->use_linear_colors = use_linear_colors;
+			cache->use_lighting = use_lighting;
+			cache->instance_uniforms_ofs = template_instance.instance_uniforms_ofs;
+			cache->flags = template_instance.flags;
+			memcpy(cache->lights, template_instance.lights, sizeof(template_instance.lights));
+			cache->runs.clear();
+			cache->instances.clear();
+		}
+	}
+
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		if (skipping && c->type != Item::Command::TYPE_ANIMATION_SLICE) {
@@ -2404,6 +2574,14 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 			continue;
 		}
 
+		if (cache && c->type != Item::Command::TYPE_RECT && c->type != Item::Command::TYPE_NINEPATCH && c->type != Item::Command::TYPE_PRIMITIVE && c->type != Item::Command::TYPE_TRANSFORM) {
+			// Depends on state that can't be replayed from instance data alone.
+			cache->cacheable = false;
+			cache->runs.clear();
+			cache->instances.clear();
+			cache = nullptr;
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
@@ -2529,6 +2707,9 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 				instance_data->dst_rect[2] = dst_rect.size.width;
 				instance_data->dst_rect[3] = dst_rect.size.height;
 
+				if (cache) {
+					_cache_item_instance(cache, *r_current_batch, c);
+				}
 				_add_to_batch(r_batch_broken, r_current_batch);
 			} break;
 
@@ -2607,6 +2788,9 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 				instance_data->ninepatch_margins[2] = np->margin[SIDE_RIGHT];
 				instance_data->ninepatch_margins[3] = np->margin[SIDE_BOTTOM];
 
+				if (cache) {
+					_cache_item_instance(cache, *r_current_batch, c);
+				}
 				_add_to_batch(r_batch_broken, r_current_batch);
 			} break;
 
@@ -2715,6 +2899,9 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 					instance_data->colors[j * 2 + 1] = (uint32_t(Math::make_half_float(col.a)) << 16) | Math::make_half_float(col.b);
 				}
 
+				if (cache) {
+					_cache_item_instance(cache, *r_current_batch, c);
+				}
 				_add_to_batch(r_batch_broken, r_current_batch);
 
 				if (primitive->point_count == 4) {
@@ -2735,6 +2922,9 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 						instance_data->colors[j * 2 + 1] = (uint32_t(Math::make_half_float(col.a)) << 16) | Math::make_half_float(col.b);
 					}
 
+					if (cache) {
+						_cache_item_instance(cache, *r_current_batch, c);
+					}
 					_add_to_batch(r_batch_broken, r_current_batch);
 				}
 			} break;
@@ -2892,6 +3082,10 @@ void RendererCanvasRenderRD::_record_item_commands(const Item *p_item, RenderTar
 		r_batch_broken = false;
 	}
 
+	if (cache) {
+		cache->valid = true;
+	}
+
 #ifdef DEBUG_ENABLED
 	if (debug_redraw && p_item->debug_redraw_time > 0.0) {
 		Color dc = debug_redraw_color;
@@ -148,6 +148,9 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	struct CanvasShaderData : public RendererRD::MaterialStorage::ShaderData {
 		Vector<ShaderCompiler::GeneratedCode::Texture> texture_uniforms;
+		// Result of parse_code(), until apply_parsed_code() consumes it.
+		Error parse_error = OK;
+		ShaderCompiler::GeneratedCode parsed_code;
 		int blend_mode = 0;
 
 		Vector<uint32_t> ubo_offsets;
@@ -168,6 +171,9 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		void _clear_vertex_input_mask_cache();
 		void _create_pipeline(PipelineKey p_pipeline_key);
 		virtual void set_code(const String &p_Code);
+		virtual bool supports_parse_code() const { return true; }
+		virtual void parse_code(const String &p_code);
+		virtual void apply_parsed_code();
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RenderingServerTypes::ShaderNativeSourceCode get_native_source_code() const;
@@ -579,6 +585,62 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	HashMap<TextureState, TextureInfo, HashMapHasherDefault, HashMapComparatorDefault<TextureState>, PagedAllocator<HashMapElement<TextureState, TextureInfo>>> texture_info_map;
 
+	/// Instance data recorded for an item made only of batchable commands, so it can be
+	/// replayed on later frames without processing the commands again.
+	struct ItemRecordCache : public Item::RenderCache {
+		/// Consecutive instances that share the same batch state.
+		struct Run {
+			TextureState tex_state;
+			Vector2 texpixel_size;
+			const Item::Command *command = nullptr;
+			Color modulate;
+			float msdf_pix_range = 0.0;
+			float msdf_outline = 0.0;
+			Item::Command::Type command_type = Item::Command::TYPE_RECT;
+			ShaderVariant shader_variant = SHADER_VARIANT_QUAD;
+			RD::RenderPrimitive render_primitive = RD::RENDER_PRIMITIVE_TRIANGLES;
+			uint32_t primitive_points = 0;
+			uint32_t flags = 0;
+			bool use_msdf = false;
+			bool use_lcd = false;
+			bool has_blend = false;
+			uint32_t instance_count = 0;
+
+			_FORCE_INLINE_ bool matches(const Batch &p_batch) const {
+				return command_type == p_batch.command_type &&
+						shader_variant == p_batch.shader_variant &&
+						render_primitive == p_batch.render_primitive &&
+						flags == p_batch.flags &&
+						has_blend == p_batch.has_blend &&
+						(!has_blend || modulate == p_batch.modulate) &&
+						use_msdf == p_batch.use_msdf &&
+						msdf_pix_range == p_batch.msdf_pix_range &&
+						msdf_outline == p_batch.msdf_outline &&
+						use_lcd == p_batch.use_lcd &&
+						(command_type != Item::Command::TYPE_PRIMITIVE || primitive_points == p_batch.primitive_points);
+			}
+		};
+
+		/// Commands version the cache was last recorded (or rejected) for.
+		uint32_t commands_version = 0;
+		bool cacheable = true;
+		bool valid = false;
+
+		// Everything else the recorded instances depend on.
+		Transform2D base_transform;
+		Color final_modulate;
+		RSE::CanvasItemTextureFilter texture_filter = RSE::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
+		RSE::CanvasItemTextureRepeat texture_repeat = RSE::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+		bool use_linear_colors = false;
+		bool use_lighting = false;
+		uint32_t instance_uniforms_ofs = 0;
+		uint32_t flags = 0;
+		uint32_t lights[4] = {};
+
+		LocalVector<Run> runs;
+		LocalVector<InstanceData> instances;
+	};
+
 	struct State {
 		//state buffer
 		struct Buffer {
@@ -617,6 +679,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		uint32_t prev_instance_data_index = 0;
 
 		InstanceData intermediary_instance_data;
+		/// Texture info resolved for each run of the item cache being replayed.
+		LocalVector<TextureInfo *> replay_tex_infos;
 
 		uint32_t max_instances_per_buffer = 16384;
 		uint32_t max_instance_buffer_size = 16384 * sizeof(InstanceData);
@@ -674,7 +738,10 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	inline RID _get_pipeline_specialization_or_ubershader(CanvasShaderData *p_shader_data, PipelineKey &r_pipeline_key, PushConstant &r_push_constant, RID p_mesh_instance = RID(), void *p_surface = nullptr, uint32_t p_surface_index = 0, RID *r_vertex_array = nullptr);
 	void _render_batch_items(RenderTarget p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer = false, RenderingServerTypes::RenderInfo *r_render_info = nullptr);
-	void _record_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Item *&r_current_clip, Light *p_lights, bool &r_batch_broken, bool &r_sdf_used, Batch *&r_current_batch);
+	uint16_t _fill_item_lights(const Item *p_item, Light *p_lights, InstanceData &r_instance) const;
+	void _record_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Item *&r_current_clip, Light *p_lights, bool &r_batch_broken, bool &r_sdf_used, Batch *&r_current_batch, bool p_use_cache = false);
+	bool _replay_item_commands(const Item *p_item, RenderTarget p_render_target, const Transform2D &p_base_transform, Light *p_lights, bool &r_batch_broken, Batch *&r_current_batch);
+	void _cache_item_instance(ItemRecordCache *p_cache, const Batch &p_batch, const Item::Command *p_command);
 	void _render_batch(RD::DrawListID p_draw_list, CanvasShaderData *p_shader_data, RenderingDevice::FramebufferFormatID p_framebuffer_format, Light *p_lights, const Batch *p_batch, RenderingServerTypes::RenderInfo *r_render_info = nullptr);
 	void _prepare_batch_texture_info(RID p_texture, TextureState &p_state, TextureInfo *p_info);
 
@@ -31,6 +31,7 @@
 #include "shader_rd.h"
 
 #include "core/config/engine.h"
+#include "core/crypto/crypto_core.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/object/worker_thread_pool.h"
@@ -41,6 +42,9 @@
 
 #define ENABLE_SHADER_CACHE 1
 
+// Once the binaries kept for deduplication exceed this size, the cache starts over, even if compilations are still pending.
+#define DEDUPLICATION_CACHE_MAX_SIZE (64 * 1024 * 1024)
+
 void ShaderRD::_add_stage(const char *p_code, StageType p_stage_type) {
 	Vector<String> lines = String(p_code).split("\n");
 
@@ -404,6 +408,45 @@ Vector<String> ShaderRD::_build_variant_stage_sources(uint32_t p_variant, Compil
 	return stage_sources;
 }
 
+String ShaderRD::_get_source_deduplication_key(const Vector<String> &p_stage_sources) {
+	// Indentation and trailing whitespace don't change the result of the compilation, but they do vary a lot
+	// in generated code. Line breaks, including empty lines, are kept as they matter to the preprocessor.
+	// Whitespace is kept around anything that looks like a `\` line continuation, as lines are joined as they are
+	// and `\ ` is not a continuation at all.
+	StringBuilder builder;
+	for (int i = 0; i < p_stage_sources.size(); i++) {
+		builder.append(itos(i));
+		builder.append(":\n");
+		bool continued = false;
+		for (const String &line : p_stage_sources[i].split("\n")) {
+			String key_line = continued ? line : line.strip_edges(true, false);
+			continued = key_line.ends_with("\\");
+			const String right_stripped = key_line.strip_edges(false, true);
+			if (!right_stripped.ends_with("\\")) {
+				key_line = right_stripped;
+			}
+			builder.append(key_line);
+			builder.append("\n");
+		}
+	}
+	return builder.as_string().sha256_text();
+}
+
+String ShaderRD::_get_spirv_deduplication_key(const Vector<RD::ShaderStageSPIRVData> &p_stages) {
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	for (const RD::ShaderStageSPIRVData &stage : p_stages) {
+		uint32_t stage_type = stage.shader_stage;
+		uint32_t spirv_size = stage.spirv.size();
+		ctx.update((const uint8_t *)&stage_type, sizeof(uint32_t));
+		ctx.update((const uint8_t *)&spirv_size, sizeof(uint32_t));
+		ctx.update(stage.spirv.ptr(), stage.spirv.size());
+	}
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
 void ShaderRD::_compile_variant(uint32_t p_variant, CompileData p_data) {
 	uint32_t variant = group_to_variant_map[p_data.group][p_variant];
 	if (!variants_enabled[variant]) {
@@ -411,11 +454,47 @@ void ShaderRD::_compile_variant(uint32_t p_variant, CompileData p_data) {
 	}
 
 	Vector<String> variant_stage_sources = _build_variant_stage_sources(variant, p_data);
-	Vector<RD::ShaderStageSPIRVData> variant_stages = compile_stages(variant_stage_sources, dynamic_buffers);
-	ERR_FAIL_COND(variant_stages.is_empty());
+	const String source_key = _get_source_deduplication_key(variant_stage_sources);
+
+	Vector<uint8_t> shader_data;
+	{
+		MutexLock lock(deduplication_cache.mutex);
+		const Vector<uint8_t> *cached = deduplication_cache.by_source.getptr(source_key);
+		if (cached) {
+			shader_data = *cached;
+		}
+	}
+
+	if (shader_data.is_empty()) {
+		Vector<RD::ShaderStageSPIRVData> variant_stages = compile_stages(variant_stage_sources, dynamic_buffers);
+		ERR_FAIL_COND(variant_stages.is_empty());
 
-	Vector<uint8_t> shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(variant_stages, name + ":" + itos(variant));
-	ERR_FAIL_COND(shader_data.is_empty());
+		// Different sources can still compile to the same SPIR-V, in which case the binary can be reused as is.
+		const String spirv_key = _get_spirv_deduplication_key(variant_stages);
+		{
+			MutexLock lock(deduplication_cache.mutex);
+			const Vector<uint8_t> *cached = deduplication_cache.by_spirv.getptr(spirv_key);
+			if (cached) {
+				shader_data = *cached;
+				deduplication_cache.by_source[source_key] = shader_data;
+			}
+		}
+
+		if (shader_data.is_empty()) {
+			shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(variant_stages, name + ":" + itos(variant));
+			ERR_FAIL_COND(shader_data.is_empty());
+
+			MutexLock lock(deduplication_cache.mutex);
+			if (deduplication_cache.size + shader_data.size() > DEDUPLICATION_CACHE_MAX_SIZE) {
+				deduplication_cache.by_source.clear();
+				deduplication_cache.by_spirv.clear();
+				deduplication_cache.size = 0;
+			}
+			deduplication_cache.by_source[source_key] = shader_data;
+			deduplication_cache.by_spirv[spirv_key] = shader_data;
+			deduplication_cache.size += shader_data.size();
+		}
+	}
 
 	{
 		p_data.version->variants.write[variant] = RD::get_singleton()->shader_create_from_bytecode_with_samplers(shader_data, p_data.version->variants[variant], immutable_samplers);
@@ -729,6 +808,11 @@ void ShaderRD::_compile_version_start(Version *p_version, int p_group) {
 	compile_data.version = p_version;
 	compile_data.group = p_group;
 
+	{
+		MutexLock lock(deduplication_cache.mutex);
+		deduplication_cache.pending_compilations++;
+	}
+
 	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, compile_data, group_to_variant_map[p_group].size(), -1, true, SNAME("ShaderCompilation"));
 	p_version->group_compilation_tasks.write[p_group] = group_task;
 	p_version->group_loaded_from_cache.write[p_group] = false;
@@ -742,6 +826,16 @@ void ShaderRD::_compile_version_end(Version *p_version, int p_group) {
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	p_version->group_compilation_tasks.write[p_group] = 0;
 
+	if (!p_version->group_loaded_from_cache[p_group]) {
+		MutexLock lock(deduplication_cache.mutex);
+		deduplication_cache.pending_compilations--;
+		if (deduplication_cache.pending_compilations == 0) {
+			deduplication_cache.by_source.clear();
+			deduplication_cache.by_spirv.clear();
+			deduplication_cache.size = 0;
+		}
+	}
+
 	bool all_valid = true;
 
 	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
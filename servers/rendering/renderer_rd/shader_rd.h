@@ -98,6 +98,23 @@ private:
 		int group = 0;
 	};
 
+	// Generated shaders often end up with the same code for different versions (e.g. materials that only differ
+	// in code paths that get removed). Compiled binaries are shared between them, keyed by the normalized source
+	// and by the resulting SPIR-V, so the same code is only compiled once and identical binaries share memory.
+	// The cache only lives while compilations are pending, it's released once all of them are done.
+	struct DeduplicationCache {
+		Mutex mutex;
+		HashMap<String, Vector<uint8_t>> by_source;
+		HashMap<String, Vector<uint8_t>> by_spirv;
+		uint64_t size = 0;
+		uint32_t pending_compilations = 0;
+	};
+
+	DeduplicationCache deduplication_cache;
+
+	static String _get_source_deduplication_key(const Vector<String> &p_stage_sources);
+	static String _get_spirv_deduplication_key(const Vector<RD::ShaderStageSPIRVData> &p_stages);
+
 	// Vector will have the size of SHADER_STAGE_MAX and unused stages will have empty strings.
 	void _compile_variant(uint32_t p_variant, CompileData p_data);
 
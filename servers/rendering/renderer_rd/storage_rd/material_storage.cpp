@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/resource_loader.h"
 #include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "servers/rendering/renderer_rd/forward_clustered/scene_shader_forward_clustered.h"
 #include "servers/rendering/renderer_rd/forward_mobile/scene_shader_forward_mobile.h"
@@ -2213,13 +2214,8 @@ void MaterialStorage::shader_free(RID p_rid) {
 	shader_owner.free(p_rid);
 }
 
-void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
-	Shader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL(shader);
-
-	MutexLock lock(*shader->mutex);
-
-	shader->code = p_code;
+void MaterialStorage::_shader_set_code_begin(Shader *p_shader, const String &p_code) {
+	p_shader->code = p_code;
 	String mode_string = ShaderLanguage::get_shader_type(p_code);
 
 	ShaderType new_type;
@@ -2239,13 +2235,13 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		new_type = SHADER_TYPE_MAX;
 	}
 
-	if (new_type != shader->type) {
-		if (shader->data) {
-			memdelete(shader->data);
-			shader->data = nullptr;
+	if (new_type != p_shader->type) {
+		if (p_shader->data) {
+			memdelete(p_shader->data);
+			p_shader->data = nullptr;
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
 			material->shader_type = new_type;
 			if (material->data) {
@@ -2254,18 +2250,18 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			}
 		}
 
-		shader->type = new_type;
+		p_shader->type = new_type;
 
 		if (new_type < SHADER_TYPE_MAX && shader_data_request_func[new_type]) {
-			shader->data = shader_data_request_func[new_type]();
+			p_shader->data = shader_data_request_func[new_type]();
 		} else {
-			shader->type = SHADER_TYPE_MAX; //invalid
+			p_shader->type = SHADER_TYPE_MAX; //invalid
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
-			if (shader->data) {
-				material->data = material_get_data_request_function(new_type)(shader->data);
+			if (p_shader->data) {
+				material->data = material_get_data_request_function(new_type)(p_shader->data);
 				material->data->self = material->self;
 				material->data->set_next_pass(material->next_pass);
 				material->data->set_render_priority(material->priority);
@@ -2273,27 +2269,95 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			material->shader_type = new_type;
 		}
 
-		if (shader->data) {
-			for (const KeyValue<StringName, HashMap<int, RID>> &E : shader->default_texture_parameter) {
+		if (p_shader->data) {
+			for (const KeyValue<StringName, HashMap<int, RID>> &E : p_shader->default_texture_parameter) {
 				for (const KeyValue<int, RID> &E2 : E.value) {
-					shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
+					p_shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
 				}
 			}
 		}
 	}
 
-	if (shader->data) {
-		shader->data->set_path_hint(shader->path_hint);
-		shader->data->set_code(p_code);
+	if (p_shader->data) {
+		p_shader->data->set_path_hint(p_shader->path_hint);
 	}
+}
 
-	for (Material *E : shader->owners) {
+void MaterialStorage::_shader_set_code_end(Shader *p_shader) {
+	for (Material *E : p_shader->owners) {
 		Material *material = E;
 		material->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MATERIAL);
 		_material_queue_update(material, true, true);
 	}
 }
 
+void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+
+	MutexLock lock(*shader->mutex);
+
+	_shader_set_code_begin(shader, p_code);
+	if (shader->data) {
+		shader->data->set_code(p_code);
+	}
+	_shader_set_code_end(shader);
+}
+
+void MaterialStorage::_shader_parse_code_task(uint32_t p_index, ShaderCodeBatch *p_batch) {
+	p_batch->shaders[p_index]->data->parse_code(p_batch->codes[p_index]);
+}
+
+void MaterialStorage::shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+
+	// Only the last code set for each shader matters.
+	HashMap<RID, int> last_index;
+	for (int i = 0; i < p_shaders.size(); i++) {
+		last_index[p_shaders[i]] = i;
+	}
+
+	// Shader data that can split set_code() is parsed in parallel, the rest is set right away.
+	// Locks are held for the whole batch, so nothing else sees a shader half updated.
+	ShaderCodeBatch batch;
+	for (int i = 0; i < p_shaders.size(); i++) {
+		if (last_index[p_shaders[i]] != i) {
+			continue;
+		}
+
+		Shader *shader = shader_owner.get_or_null(p_shaders[i]);
+		ERR_CONTINUE(!shader);
+
+		shader->mutex->lock();
+		_shader_set_code_begin(shader, p_codes[i]);
+		if (shader->data && shader->data->supports_parse_code()) {
+			batch.shaders.push_back(shader);
+			batch.codes.push_back(p_codes[i]);
+			continue;
+		}
+
+		if (shader->data) {
+			shader->data->set_code(p_codes[i]);
+		}
+		_shader_set_code_end(shader);
+		shader->mutex->unlock();
+	}
+
+	if (batch.shaders.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MaterialStorage::_shader_parse_code_task, &batch, batch.shaders.size(), -1, true, SNAME("ShaderParseCode"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Creating versions and clearing pipelines goes through the renderers' shared state, so it's done serially.
+	for (Shader *shader : batch.shaders) {
+		shader->data->apply_parsed_code();
+		_shader_set_code_end(shader);
+		shader->mutex->unlock();
+	}
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -79,6 +79,12 @@ public:
 		virtual bool is_parameter_texture(const StringName &p_param) const;
 
 		virtual void set_code(const String &p_Code) = 0;
+		// set_code() split in two, for shader data that supports it. parse_code() only parses the code and generates
+		// the stage sources into this shader data, so it can run on a worker thread. apply_parsed_code() then creates
+		// or frees the version and clears the pipelines, and must run on the thread that called parse_code() after it.
+		virtual bool supports_parse_code() const { return false; }
+		virtual void parse_code(const String &p_code) {}
+		virtual void apply_parsed_code() {}
 		virtual bool is_animated() const = 0;
 		virtual bool casts_shadows() const = 0;
 		virtual RenderingServerTypes::ShaderNativeSourceCode get_native_source_code() const = 0;
@@ -279,6 +285,15 @@ private:
 	ShaderDataRequestFunction shader_data_request_func[SHADER_TYPE_MAX];
 
 	mutable RID_Owner<Shader, true> shader_owner;
+
+	struct ShaderCodeBatch {
+		LocalVector<Shader *> shaders;
+		LocalVector<String> codes;
+	};
+
+	void _shader_set_code_begin(Shader *p_shader, const String &p_code);
+	void _shader_set_code_end(Shader *p_shader);
+	void _shader_parse_code_task(uint32_t p_index, ShaderCodeBatch *p_batch);
 	HashSet<RID> embedded_set;
 	Mutex embedded_set_mutex;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
@@ -465,6 +480,7 @@ public:
 	virtual void shader_free(RID p_rid) override;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) override;
+	virtual void shaders_set_code(const Vector<RID> &p_shaders, const Vector<String> &p_codes) override;
 	virtual void shader_set_path_hint(RID p_shader, const String &p_path) override;
 	virtual String shader_get_code(RID p_shader) const override;
 	virtual void get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const override;
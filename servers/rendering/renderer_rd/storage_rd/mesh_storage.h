@@ -694,6 +694,10 @@ public:
 
 	virtual MultiMeshInterpolator *_multimesh_get_interpolator(RID p_multimesh) const override;
 
+	// Chunk culling would need a compute compaction pass with indirect draws, so multimeshes are always drawn in full.
+	virtual void multimesh_cull_chunks(RID p_multimesh, const Transform3D &p_transform, const Vector<Plane> &p_planes) override {}
+	virtual void update_multimesh_chunks() override {}
+
 	void _update_dirty_multimeshes();
 	void _multimesh_get_motion_vectors_offsets(RID p_multimesh, uint32_t &r_current_offset, uint32_t &r_prev_offset);
 	bool _multimesh_uses_motion_vectors_offsets(RID p_multimesh);
@@ -35,6 +35,8 @@
 #include "core/math/geometry_3d.h"
 #include "core/object/callable_mp.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/frame_arena.h"
+#include "servers/rendering/raster_occlusion_cull.h"
 #include "servers/rendering/rendering_light_culler.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/rendering_server_default.h"
@@ -445,6 +447,8 @@ void RendererSceneCull::scenario_initialize(RID p_rid) {
 
 	scenario->reflection_atlas = RSG::light_storage->reflection_atlas_create();
 
+	scenario->light_grid.cell_size = light_grid_cell_size;
+
 	scenario->instance_aabbs.set_page_pool(&instance_aabb_page_pool);
 	scenario->instance_data.set_page_pool(&instance_data_page_pool);
 	scenario->instance_visibility.set_page_pool(&instance_visibility_data_page_pool);
@@ -603,6 +607,13 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 			case RSE::INSTANCE_PARTICLES: {
 				InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
 				scene_render->geometry_instance_free(geom->geometry_instance);
+
+				if (instance->base_type == RSE::INSTANCE_MULTIMESH) {
+					HashMap<RID, uint32_t>::Iterator E = multimesh_instance_counts.find(instance->base);
+					if (E && --E->value == 0) {
+						multimesh_instance_counts.remove(E);
+					}
+				}
 			} break;
 			case RSE::INSTANCE_LIGHT: {
 				InstanceLightData *light = static_cast<InstanceLightData *>(instance->base_data);
@@ -725,6 +736,10 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 
 				ERR_FAIL_NULL(geom->geometry_instance);
 
+				if (instance->base_type == RSE::INSTANCE_MULTIMESH) {
+					multimesh_instance_counts[p_base]++;
+				}
+
 				geom->geometry_instance->set_skeleton(instance->skeleton);
 				geom->geometry_instance->set_material_override(instance->material_override);
 				geom->geometry_instance->set_material_overlay(instance->material_overlay);
@@ -1757,12 +1772,15 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		}
 	}
 
+	bool repair = true;
+
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RSE::INSTANCE_GEOMETRY_MASK) {
 			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(bvh_aabb, p_instance);
 		} else {
 			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(bvh_aabb, p_instance);
 		}
+		p_instance->pair_aabb = bvh_aabb;
 
 		p_instance->array_index = p_instance->scenario->instance_data.size();
 		InstanceData idata;
@@ -1846,12 +1864,18 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
+	} else if (bvh_aabb == p_instance->pair_aabb && !p_instance->update_dependencies) {
+		// Moved within the volume it is indexed with, so the indexer doesn't need updating.
+		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		// Pairing uses the exact bounds, so pairs only stay valid if those are unchanged too.
+		repair = p_instance->transformed_aabb != p_instance->prev_transformed_aabb;
 	} else {
 		if ((1 << p_instance->base_type) & RSE::INSTANCE_GEOMETRY_MASK) {
 			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
+		p_instance->pair_aabb = bvh_aabb;
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
 
@@ -1859,15 +1883,33 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		p_instance->scenario->instance_visibility[p_instance->visibility_index].position = p_instance->transformed_aabb.get_center();
 	}
 
-	//move instance and repair
-	pair_pass++;
+	if (p_instance->base_type == RSE::INSTANCE_LIGHT) {
+		if (_update_light_grid(p_instance)) {
+			// Moved in or out of the grid, so its geometry pairs need to be rebuilt.
+			repair = true;
+		}
+	} else if (((1 << p_instance->base_type) & RSE::INSTANCE_GEOMETRY_MASK) && (geometry_instance_pair_mask & (1 << RSE::INSTANCE_LIGHT)) && p_instance->scenario->light_grid.light_count) {
+		// Lights in the grid are not paired, so they must be gathered again once this moves.
+		p_instance->scenario->instance_data[p_instance->array_index].flags |= InstanceData::FLAG_GEOM_LIGHTING_DIRTY;
+	}
+
+	if (repair && !p_instance->pair_item.in_list()) {
+		// Repairing is deferred to _update_instance_pairs(), so it can be batched with the rest of the dirty list.
+		_instance_pair_list.add(&p_instance->pair_item);
+	}
+
+	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
+}
 
-	PairInstances pair;
+void RendererSceneCull::_instance_setup_pairing(Instance *p_instance, PairInstances &r_pair) const {
+	PairInstances &pair = r_pair;
 
 	pair.instance = p_instance;
 	pair.pair_allocator = &pair_allocator;
-	pair.pair_pass = pair_pass;
+	pair.bvh = nullptr;
+	pair.bvh2 = nullptr;
 	pair.pair_mask = 0;
+	pair.skip_grid_lights = false;
 
 	if ((1 << p_instance->base_type) & RSE::INSTANCE_GEOMETRY_MASK) {
 		pair.pair_mask |= 1 << RSE::INSTANCE_LIGHT;
@@ -1880,9 +1922,12 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		pair.pair_mask |= geometry_instance_pair_mask;
 
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
+		pair.skip_grid_lights = true;
 	} else if (p_instance->base_type == RSE::INSTANCE_LIGHT) {
-		pair.pair_mask |= RSE::INSTANCE_GEOMETRY_MASK;
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		if (!static_cast<InstanceLightData *>(p_instance->base_data)->in_light_grid) {
+			pair.pair_mask |= RSE::INSTANCE_GEOMETRY_MASK;
+			pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		}
 
 		RSE::LightBakeMode bake_mode = RSG::light_storage->light_get_bake_mode(p_instance->base);
 		if (bake_mode == RSE::LIGHT_BAKE_STATIC || bake_mode == RSE::LIGHT_BAKE_DYNAMIC) {
@@ -1907,10 +1952,175 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
+}
 
-	pair.pair();
+bool RendererSceneCull::LightGrid::fits(const AABB &p_aabb) const {
+	Vector3i size = get_cell(p_aabb.get_end()) - get_cell(p_aabb.position) + Vector3i(1, 1, 1);
+	return (uint64_t)size.x * size.y * size.z <= MAX_CELLS_PER_LIGHT;
+}
 
-	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
+void RendererSceneCull::LightGrid::insert(Instance *p_light, const AABB &p_aabb) {
+	Vector3i from = get_cell(p_aabb.position);
+	Vector3i to = get_cell(p_aabb.get_end());
+	for (int32_t x = from.x; x <= to.x; x++) {
+		for (int32_t y = from.y; y <= to.y; y++) {
+			for (int32_t z = from.z; z <= to.z; z++) {
+				Cell &cell = cells[Vector3i(x, y, z)];
+				cell.lights.push_back(p_light);
+				cell.aabbs.push_back(p_aabb);
+			}
+		}
+	}
+	light_count++;
+}
+
+void RendererSceneCull::LightGrid::remove(Instance *p_light, const AABB &p_aabb) {
+	Vector3i from = get_cell(p_aabb.position);
+	Vector3i to = get_cell(p_aabb.get_end());
+	for (int32_t x = from.x; x <= to.x; x++) {
+		for (int32_t y = from.y; y <= to.y; y++) {
+			for (int32_t z = from.z; z <= to.z; z++) {
+				HashMap<Vector3i, Cell>::Iterator E = cells.find(Vector3i(x, y, z));
+				ERR_CONTINUE(!E);
+				int64_t idx = E->value.lights.find(p_light);
+				ERR_CONTINUE(idx < 0);
+				E->value.lights.remove_at_unordered(idx);
+				E->value.aabbs.remove_at_unordered(idx);
+				if (E->value.lights.is_empty()) {
+					cells.remove(E);
+				}
+			}
+		}
+	}
+	light_count--;
+}
+
+void RendererSceneCull::LightGrid::query(const AABB &p_aabb, LocalVector<Instance *> &r_lights) const {
+	Vector3i from = get_cell(p_aabb.position);
+	Vector3i to = get_cell(p_aabb.get_end());
+	Vector3i size = to - from + Vector3i(1, 1, 1);
+
+	// A light overlapping several cells is only reported from the cell holding the minimum corner of the overlap.
+	if ((uint64_t)size.x * size.y * size.z > (uint64_t)cells.size()) {
+		for (const KeyValue<Vector3i, Cell> &E : cells) {
+			for (uint32_t i = 0; i < E.value.lights.size(); i++) {
+				const AABB &aabb = E.value.aabbs[i];
+				if (aabb.intersects(p_aabb) && get_cell(aabb.position.max(p_aabb.position)) == E.key) {
+					r_lights.push_back(E.value.lights[i]);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int32_t x = from.x; x <= to.x; x++) {
+		for (int32_t y = from.y; y <= to.y; y++) {
+			for (int32_t z = from.z; z <= to.z; z++) {
+				Vector3i key(x, y, z);
+				HashMap<Vector3i, Cell>::ConstIterator E = cells.find(key);
+				if (!E) {
+					continue;
+				}
+				for (uint32_t i = 0; i < E->value.lights.size(); i++) {
+					const AABB &aabb = E->value.aabbs[i];
+					if (aabb.intersects(p_aabb) && get_cell(aabb.position.max(p_aabb.position)) == key) {
+						r_lights.push_back(E->value.lights[i]);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool RendererSceneCull::_light_uses_grid(Instance *p_instance) const {
+	const LightGrid &grid = p_instance->scenario->light_grid;
+	if (grid.cell_size <= 0.0) {
+		return false;
+	}
+
+	// Shadows, projectors and soft shadows rely on the pairs to track which geometry is affected.
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+	if (light->uses_projector || light->uses_softshadow) {
+		return false;
+	}
+	if (RSG::light_storage->light_get_type(p_instance->base) == RSE::LIGHT_DIRECTIONAL || RSG::light_storage->light_has_shadow(p_instance->base)) {
+		return false;
+	}
+
+	return grid.fits(p_instance->transformed_aabb);
+}
+
+bool RendererSceneCull::_update_light_grid(Instance *p_instance) const {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+	LightGrid &grid = p_instance->scenario->light_grid;
+
+	bool was_in_grid = light->in_light_grid;
+	bool use_grid = _light_uses_grid(p_instance);
+
+	// Only geometry the light covered before or covers now needs to gather its lights again.
+	if (was_in_grid) {
+		_light_grid_mark_geometry_dirty(p_instance->scenario, light->light_grid_aabb);
+	}
+	if (use_grid && (!was_in_grid || light->light_grid_aabb != p_instance->transformed_aabb)) {
+		_light_grid_mark_geometry_dirty(p_instance->scenario, p_instance->transformed_aabb);
+	}
+
+	if (was_in_grid && (!use_grid || light->light_grid_aabb != p_instance->transformed_aabb)) {
+		grid.remove(p_instance, light->light_grid_aabb);
+		light->in_light_grid = false;
+	}
+	if (use_grid && !light->in_light_grid) {
+		grid.insert(p_instance, p_instance->transformed_aabb);
+		light->light_grid_aabb = p_instance->transformed_aabb;
+		light->in_light_grid = true;
+	}
+
+	return was_in_grid != use_grid;
+}
+
+void RendererSceneCull::_light_grid_mark_geometry_dirty(Scenario *p_scenario, const AABB &p_aabb) const {
+	LightGridDirtyGeometry dirty_geometry;
+	dirty_geometry.scenario = p_scenario;
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].aabb_query(p_aabb, dirty_geometry);
+}
+
+void RendererSceneCull::_instance_pair_query_threaded(uint32_t p_index, void *p_userdata) const {
+	pair_instances[p_index].query();
+}
+
+void RendererSceneCull::_update_instance_pairs() const {
+	uint32_t pair_count = 0;
+	while (_instance_pair_list.first()) {
+		Instance *instance = _instance_pair_list.first()->self();
+		_instance_pair_list.remove(&instance->pair_item);
+
+		if (pair_instances.size() <= pair_count) {
+			pair_instances.resize(pair_count + 1);
+		}
+		_instance_setup_pairing(instance, pair_instances[pair_count]);
+		pair_count++;
+	}
+
+	if (pair_count == 0) {
+		return;
+	}
+
+	// Querying the indexers does not modify any instance, so it can be spread across threads.
+	if (pair_count > thread_cull_threshold) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_instance_pair_query_threaded, (void *)nullptr, pair_count, -1, true, SNAME("PairInstances"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < pair_count; i++) {
+			pair_instances[i].query();
+		}
+	}
+
+	// Pairing touches both instances of each pair, so it is applied serially.
+	for (uint32_t i = 0; i < pair_count; i++) {
+		pair_pass++;
+		pair_instances[i].pair_pass = pair_pass;
+		pair_instances[i].pair();
+	}
 }
 
 void RendererSceneCull::_unpair_instance(Instance *p_instance) {
@@ -1918,6 +2128,19 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		return; //nothing to do
 	}
 
+	if (p_instance->pair_item.in_list()) {
+		_instance_pair_list.remove(&p_instance->pair_item);
+	}
+
+	if (p_instance->base_type == RSE::INSTANCE_LIGHT) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+		if (light->in_light_grid) {
+			p_instance->scenario->light_grid.remove(p_instance, light->light_grid_aabb);
+			_light_grid_mark_geometry_dirty(p_instance->scenario, light->light_grid_aabb);
+			light->in_light_grid = false;
+		}
+	}
+
 	while (p_instance->pairs.first()) {
 		InstancePair *pair = p_instance->pairs.first()->self();
 		Instance *other_instance = p_instance == pair->a ? pair->b : pair->a;
@@ -2905,6 +3128,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	// Minimize allocations when picking the most relevant lights per mesh.
 	// We need to track the score and current index of the best N lights.
 	thread_local LocalVector<Pair<float, uint32_t>> omni_score_idx, spot_score_idx, area_score_idx;
+	thread_local LocalVector<Instance *> relevant_lights;
 	omni_score_idx.clear();
 	spot_score_idx.clear();
 	area_score_idx.clear();
@@ -2994,6 +3218,10 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (base_type == RSE::INSTANCE_MESH) {
 						mesh_visible = true;
+					} else if (base_type == RSE::INSTANCE_MULTIMESH) {
+						if (multimesh_chunk_culling) {
+							cull_result.multimeshes.push_back(idata.instance);
+						}
 					} else if (base_type == RSE::INSTANCE_PARTICLES) {
 						//particles visible? process them
 						if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
@@ -3036,7 +3264,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 							SortArray<Pair<float, uint32_t>> heapify; // SortArray has heap functions, but no local storage.
 							// Iterate over the lights (possibly > max_renderable_lights), keeping the closest to the mesh center.
 							Vector3 mesh_center = idata.instance->transformed_aabb.get_center();
-							for (const Instance *E : geom->lights) {
+							relevant_lights.clear();
+							for (Instance *E : geom->lights) {
+								relevant_lights.push_back(E);
+							}
+							if (cull_data.scenario->light_grid.light_count) {
+								cull_data.scenario->light_grid.query(idata.instance->transformed_aabb, relevant_lights);
+							}
+							for (const Instance *E : relevant_lights) {
 								RSE::LightType light_type = RSG::light_storage->light_get_type(E->base);
 								if (((RSE::LIGHT_OMNI == light_type) && (total_omni_count++ < max_lights_total)) ||
 										((RSE::LIGHT_SPOT == light_type) && (total_spot_count++ < max_lights_total)) ||
@@ -3299,6 +3534,55 @@ void RendererSceneCull::_scene_particles_set_view_axis(RID p_particles, const Ve
 	RSG::particles_storage->particles_set_view_axis(p_particles, p_axis, p_up_axis);
 }
 
+void RendererSceneCull::_cull_multimesh_chunks(const Vector<Plane> &p_planes, Span<Vector3> p_shadow_directions) {
+	// Directional shadows are cast from outside the frustum, so only keep the planes that a chunk's
+	// shadow can't cross, which are those the light travels away through.
+	Vector<Plane> planes;
+	for (const Plane &plane : p_planes) {
+		bool keep = true;
+		for (const Vector3 &direction : p_shadow_directions) {
+			if (plane.normal.dot(direction) < 0) {
+				keep = false;
+				break;
+			}
+		}
+		if (keep) {
+			planes.push_back(plane);
+		}
+	}
+
+	for (uint64_t i = 0; i < scene_cull_result.multimeshes.size(); i++) {
+		Instance *instance = scene_cull_result.multimeshes[i];
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+
+		// The culled buffer is shared by every instance of the multimesh, and other instances
+		// may be drawn in passes that this frustum doesn't cover.
+		HashMap<RID, uint32_t>::ConstIterator E = multimesh_instance_counts.find(instance->base);
+		if (!E || E->value != 1) {
+			continue;
+		}
+
+		// Dynamic VoxelGI objects are drawn from the probe, not the camera.
+		if (!geom->voxel_gi_instances.is_empty()) {
+			continue;
+		}
+
+		// Positional shadows may be drawn from any side of the multimesh.
+		bool positional_shadow = false;
+		for (const Instance *E : geom->lights) {
+			if (RSG::light_storage->light_get_type(E->base) != RSE::LIGHT_DIRECTIONAL && RSG::light_storage->light_has_shadow(E->base)) {
+				positional_shadow = true;
+				break;
+			}
+		}
+		if (positional_shadow) {
+			continue;
+		}
+
+		RSG::mesh_storage->multimesh_cull_chunks(instance->base, instance->transform, planes);
+	}
+}
+
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, float p_window_output_max_value, bool p_using_shadows, RenderingServerTypes::RenderInfo *r_render_info) {
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
@@ -3358,11 +3642,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	cull.frustum = Frustum(planes);
 
 	Vector<RID> directional_lights;
+	FrameLocalVector<Vector3> directional_shadow_directions;
 	// directional lights
 	{
 		cull.shadow_count = 0;
 
-		Vector<Instance *> lights_with_shadow;
+		FrameLocalVector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible || !(E->layer_mask & p_visible_layers)) {
@@ -3388,8 +3673,9 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
+			directional_shadow_directions.push_back(-lights_with_shadow[i]->transform.basis.get_column(Vector3::AXIS_Z));
 		}
 	}
 
@@ -3472,6 +3758,14 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			}
 			RSG::mesh_storage->update_mesh_instances();
 		}
+
+		if (multimesh_chunk_culling) {
+			// SDFGI renders regions around the camera, not just what it sees.
+			if (cull.sdfgi.region_count == 0) {
+				_cull_multimesh_chunks(planes, directional_shadow_directions);
+			}
+			RSG::mesh_storage->update_multimesh_chunks();
+		}
 	}
 
 	//render shadows
@@ -3859,7 +4153,7 @@ void RendererSceneCull::render_probes() {
 	/* REFLECTION PROBES */
 
 	SelfList<InstanceReflectionProbeData> *ref_probe = reflection_probe_render_list.first();
-	Vector<SelfList<InstanceReflectionProbeData> *> done_list;
+	FrameLocalVector<SelfList<InstanceReflectionProbeData> *> done_list;
 
 	bool busy = false;
 
@@ -4149,6 +4443,11 @@ void RendererSceneCull::render_particle_colliders() {
 				scene_cull_result.geometry_instances.push_back(geom->geometry_instance);
 			}
 
+			if (multimesh_chunk_culling) {
+				// Heightfields are drawn from above, so restore the full buffers of culled multimeshes.
+				RSG::mesh_storage->update_multimesh_chunks();
+			}
+
 			scene_render->render_particle_collider_heightfield(hfpc->base, hfpc->transform, scene_cull_result.geometry_instances);
 		}
 		heightfield_particle_colliders_update_list.remove(heightfield_particle_colliders_update_list.begin());
@@ -4360,9 +4659,14 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) const {
 }
 
 void RendererSceneCull::update_dirty_instances() const {
-	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
-	}
+	do {
+		while (_instance_update_list.first()) {
+			_update_dirty_instance(_instance_update_list.first()->self());
+		}
+
+		// Pairing may queue further updates (e.g. lightmap captures), so loop until both lists are empty.
+		_update_instance_pairs();
+	} while (_instance_update_list.first());
 
 	// Update dirty resources after dirty instances as instance updates may affect resources.
 	RSG::utilities->update_dirty_resources();
@@ -4479,6 +4783,7 @@ RendererSceneCull *RendererSceneCull::singleton = nullptr;
 void RendererSceneCull::set_scene_render(RendererSceneRender *p_scene_render) {
 	scene_render = p_scene_render;
 	geometry_instance_pair_mask = scene_render->geometry_instance_get_pair_mask();
+	multimesh_chunk_culling = multimesh_chunk_culling && RSG::mesh_storage->multimesh_has_chunk_culling();
 }
 
 /* INTERPOLATION API */
@@ -4520,9 +4825,16 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	light_grid_cell_size = GLOBAL_GET("rendering/limits/spatial_indexer/light_grid_cell_size");
+	multimesh_chunk_culling = GLOBAL_GET("rendering/limits/multimesh/chunk_culling");
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	if (int(GLOBAL_GET("rendering/occlusion_culling/culling_method")) == 1) {
+		// Raster occlusion culling doesn't need any module, so it replaces the dummy implementation.
+		dummy_occlusion_culling = memnew(RasterOcclusionCull);
+	} else {
+		dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	}
 
 	light_culler = memnew(RenderingLightCuller);
 
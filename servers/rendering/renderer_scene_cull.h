@@ -324,6 +324,29 @@ public:
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
+	// Uniform grid of lights that are not paired with geometry. The lights
+	// affecting an instance are gathered from it when culling instead.
+	struct LightGrid {
+		static const uint32_t MAX_CELLS_PER_LIGHT = 512;
+
+		struct Cell {
+			LocalVector<Instance *> lights;
+			LocalVector<AABB> aabbs;
+		};
+
+		real_t cell_size = 0.0;
+		HashMap<Vector3i, Cell> cells;
+		uint32_t light_count = 0;
+
+		_FORCE_INLINE_ Vector3i get_cell(const Vector3 &p_pos) const {
+			return Vector3i(Math::floor(p_pos.x / cell_size), Math::floor(p_pos.y / cell_size), Math::floor(p_pos.z / cell_size));
+		}
+		bool fits(const AABB &p_aabb) const;
+		void insert(Instance *p_light, const AABB &p_aabb);
+		void remove(Instance *p_light, const AABB &p_aabb);
+		void query(const AABB &p_aabb, LocalVector<Instance *> &r_lights) const;
+	};
+
 	struct Scenario {
 		enum IndexerType {
 			INDEXER_GEOMETRY, //for geometry
@@ -348,6 +371,7 @@ public:
 		SelfList<Instance>::List instances;
 
 		LocalVector<RID> dynamic_lights;
+		LightGrid light_grid;
 
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
@@ -360,6 +384,19 @@ public:
 		}
 	};
 
+	// Flags the geometry inside a volume that a grid light entered or left, so it gathers its lights again.
+	struct LightGridDirtyGeometry {
+		Scenario *scenario = nullptr;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *instance = (Instance *)p_data;
+			if (instance->array_index >= 0) {
+				scenario->instance_data[instance->array_index].flags |= InstanceData::FLAG_GEOM_LIGHTING_DIRTY;
+			}
+			return false;
+		}
+	};
+
 	int indexer_update_iterations = 0;
 
 	mutable RID_Owner<Scenario, true> scenario_owner;
@@ -439,6 +476,7 @@ public:
 		AABB aabb;
 		AABB transformed_aabb;
 		AABB prev_transformed_aabb;
+		AABB pair_aabb; // Volume stored in the indexer.
 
 		InstanceUniforms instance_uniforms;
 
@@ -466,6 +504,7 @@ public:
 		bool update_dependencies;
 
 		SelfList<Instance> update_item;
+		SelfList<Instance> pair_item;
 
 		AABB *custom_aabb = nullptr; // <Zylann> would using aabb directly with a bool be better?
 		float extra_margin;
@@ -561,7 +600,8 @@ public:
 
 		Instance() :
 				scenario_item(this),
-				update_item(this) {
+				update_item(this),
+				pair_item(this) {
 			base_type = RSE::INSTANCE_NONE;
 			cast_shadows = RSE::SHADOW_CASTING_SETTING_ON;
 			receive_shadows = true;
@@ -613,6 +653,7 @@ public:
 	};
 
 	mutable SelfList<Instance>::List _instance_update_list;
+	mutable SelfList<Instance>::List _instance_pair_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false) const;
 
 	struct InstanceGeometryData : public InstanceBaseData {
@@ -693,6 +734,9 @@ public:
 		bool uses_projector = false;
 		bool uses_softshadow = false;
 
+		bool in_light_grid = false;
+		AABB light_grid_aabb;
+
 		HashSet<Instance *> geometries;
 
 		Instance *baked_light = nullptr;
@@ -816,33 +860,42 @@ public:
 	struct PairInstances {
 		Instance *instance = nullptr;
 		PagedAllocator<InstancePair> *pair_allocator = nullptr;
-		SelfList<InstancePair>::List pairs_found;
+		LocalVector<Instance *> pairs_found;
 		DynamicBVH *bvh = nullptr;
 		DynamicBVH *bvh2 = nullptr; //some may need to cull in two
-		uint32_t pair_mask;
-		uint64_t pair_pass;
+		uint32_t pair_mask = 0;
+		uint64_t pair_pass = 0;
+		bool skip_grid_lights = false;
 
 		_FORCE_INLINE_ bool operator()(void *p_data) {
 			Instance *p_instance = (Instance *)p_data;
 
+			if (skip_grid_lights && p_instance->base_type == RSE::INSTANCE_LIGHT && static_cast<InstanceLightData *>(p_instance->base_data)->in_light_grid) {
+				return false;
+			}
+
 			if (instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type))) {
 				//test is more coarse in indexer
-				p_instance->pair_check = pair_pass;
-				InstancePair *pair = pair_allocator->alloc();
-				pair->a = instance;
-				pair->b = p_instance;
-				pairs_found.add(&pair->list_a);
+				pairs_found.push_back(p_instance);
 			}
 			return false;
 		}
 
-		void pair() {
+		// Only reads the indexers, so queries for several instances can run at once.
+		void query() {
+			pairs_found.clear();
 			if (bvh) {
 				bvh->aabb_query(instance->transformed_aabb, *this);
 			}
 			if (bvh2) {
 				bvh2->aabb_query(instance->transformed_aabb, *this);
 			}
+		}
+
+		void pair() {
+			for (Instance *other_instance : pairs_found) {
+				other_instance->pair_check = pair_pass;
+			}
 			while (instance->pairs.first()) {
 				InstancePair *pair = instance->pairs.first()->self();
 				Instance *other_instance = instance == pair->a ? pair->b : pair->a;
@@ -856,20 +909,23 @@ public:
 
 				pair_allocator->free(pair);
 			}
-			while (pairs_found.first()) {
-				InstancePair *pair = pairs_found.first()->self();
-				pairs_found.remove(pairs_found.first());
+			for (Instance *other_instance : pairs_found) {
+				InstancePair *pair = pair_allocator->alloc();
+				pair->a = instance;
+				pair->b = other_instance;
 
-				if (pair->b->pair_check == pair_pass) {
+				if (other_instance->pair_check == pair_pass) {
 					//paired
-					_instance_pair(instance, pair->b);
+					_instance_pair(instance, other_instance);
 				}
-				pair->a->pairs.add(&pair->list_a);
-				pair->b->pairs.add(&pair->list_b);
+				instance->pairs.add(&pair->list_a);
+				other_instance->pairs.add(&pair->list_b);
 			}
 		}
 	};
 
+	mutable LocalVector<PairInstances> pair_instances;
+
 	mutable HashSet<Instance *> heightfield_particle_colliders_update_list;
 
 	PagedArrayPool<Instance *> instance_cull_page_pool;
@@ -879,6 +935,9 @@ public:
 	PagedArray<Instance *> instance_cull_result;
 	PagedArray<Instance *> instance_shadow_cull_result;
 
+	// Not backed by FrameArena: the threaded cull fills these on worker threads and append_from() hands
+	// the pages over to the render thread, while frame arena memory must be freed by the thread that
+	// allocated it. The pages return to the shared pools on clear(), so growth only allocates while warming up.
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
 		PagedArray<Instance *> lights;
@@ -889,6 +948,7 @@ public:
 		PagedArray<RID> voxel_gi_instances;
 		PagedArray<RID> mesh_instances;
 		PagedArray<RID> fog_volumes;
+		PagedArray<Instance *> multimeshes;
 
 		struct DirectionalShadow {
 			PagedArray<RenderGeometryInstance *> cascade_geometry_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
@@ -907,6 +967,7 @@ public:
 			voxel_gi_instances.clear();
 			mesh_instances.clear();
 			fog_volumes.clear();
+			multimeshes.clear();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
@@ -932,6 +993,7 @@ public:
 			voxel_gi_instances.reset();
 			mesh_instances.reset();
 			fog_volumes.reset();
+			multimeshes.reset();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].reset();
@@ -957,6 +1019,7 @@ public:
 			voxel_gi_instances.merge_unordered(p_cull_result.voxel_gi_instances);
 			mesh_instances.merge_unordered(p_cull_result.mesh_instances);
 			fog_volumes.merge_unordered(p_cull_result.fog_volumes);
+			multimeshes.merge_unordered(p_cull_result.multimeshes);
 
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
@@ -983,6 +1046,7 @@ public:
 			voxel_gi_instances.set_page_pool(p_rid_pool);
 			mesh_instances.set_page_pool(p_rid_pool);
 			fog_volumes.set_page_pool(p_rid_pool);
+			multimeshes.set_page_pool(p_instance_pool);
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].set_page_pool(p_geometry_instance_pool);
@@ -1009,6 +1073,11 @@ public:
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
+	real_t light_grid_cell_size = 0.0;
+	bool multimesh_chunk_culling = false;
+	// Number of instances using each multimesh. Chunks are culled on the multimesh itself,
+	// so only multimeshes drawn by a single instance can be culled.
+	HashMap<RID, uint32_t> multimesh_instance_counts;
 
 	mutable RID_Owner<Instance, true> instance_owner{ 65536, 4194304 };
 
@@ -1073,6 +1142,12 @@ public:
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance) const;
+	void _instance_setup_pairing(Instance *p_instance, PairInstances &r_pair) const;
+	bool _light_uses_grid(Instance *p_instance) const;
+	bool _update_light_grid(Instance *p_instance) const;
+	void _light_grid_mark_geometry_dirty(Scenario *p_scenario, const AABB &p_aabb) const;
+	void _instance_pair_query_threaded(uint32_t p_index, void *p_userdata) const;
+	void _update_instance_pairs() const;
 	void _unpair_instance(Instance *p_instance);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
@@ -1153,6 +1228,7 @@ public:
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 
+	void _cull_multimesh_chunks(const Vector<Plane> &p_planes, Span<Vector3> p_shadow_directions);
 	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, float p_window_output_max_value, bool p_using_shadows = true, RenderingServerTypes::RenderInfo *r_render_info = nullptr);
 	void render_empty_scene(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_scenario, RID p_shadow_atlas, float p_window_output_max_value);
 
@@ -38,9 +38,14 @@
 #include <cfloat> // FLT_MIN, FLT_MAX
 
 class RendererSceneOcclusionCull {
+	RendererSceneOcclusionCull *previous_singleton = nullptr;
+
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	static Rect2 _get_viewport_rect(const Projection &p_cam_projection);
+	static Vector2 _get_jitter(const Rect2 &p_viewport_rect, const Size2i &p_buffer_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -239,10 +244,13 @@ public:
 	virtual void set_build_quality(RSE::ViewportOcclusionCullingBuildQuality p_quality) {}
 
 	RendererSceneOcclusionCull() {
+		previous_singleton = singleton;
 		singleton = this;
 	}
 
 	virtual ~RendererSceneOcclusionCull() {
-		singleton = nullptr;
+		if (singleton == this) {
+			singleton = previous_singleton;
+		}
 	}
 };
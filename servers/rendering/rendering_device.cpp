@@ -35,6 +35,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
@@ -147,12 +148,6 @@ static RD::HitShaderBindingTableRange _encode_hit_sbt_range(uint32_t p_offset, u
 
 #define RENDER_GRAPH_FULL_BARRIERS 0
 
-// The command graph can automatically issue secondary command buffers and record them on background threads when they reach an arbitrary
-// size threshold. This can be very beneficial towards reducing the time the main thread takes to record all the rendering commands. However,
-// this setting is not enabled by default as it's been shown to cause some strange issues with certain IHVs that have yet to be understood.
-
-#define SECONDARY_COMMAND_BUFFERS_PER_FRAME 0
-
 RenderingDevice *RenderingDevice::singleton = nullptr;
 
 RenderingDevice *RenderingDevice::get_singleton() {
@@ -4204,6 +4199,9 @@ RID RenderingDevice::shader_create_from_bytecode_with_samplers(const Vector<uint
 	shader->name.append_utf8(shader_container->shader_name);
 	shader->driver_id = shader_id;
 	shader->layout_hash = driver->shader_get_layout_hash(shader_id);
+	if (pipeline_usage.record || pipeline_usage.precompile) {
+		shader->binary_hash = _pipeline_usage_hash(p_shader_binary.ptr(), p_shader_binary.size());
+	}
 
 	for (int i = 0; i < shader->uniform_sets.size(); i++) {
 		uint32_t format = 0; // No format, default.
@@ -4257,6 +4255,10 @@ RID RenderingDevice::shader_create_from_bytecode_with_samplers(const Vector<uint
 		}
 	}
 
+	if (pipeline_usage.precompile && shader->pipeline_type == PIPELINE_TYPE_RASTERIZATION) {
+		_pipeline_usage_precompile_shader(id, shader->binary_hash);
+	}
+
 #ifdef DEV_ENABLED
 	set_resource_name(id, "RID:" + itos(id.get_id()));
 #endif
@@ -4863,6 +4865,7 @@ RID RenderingDevice::render_pipeline_create(RID p_shader, FramebufferFormatID p_
 	}
 
 	RDD::VertexFormatID driver_vertex_format;
+	const Vector<VertexAttribute> *vertex_attributes = nullptr;
 	if (p_vertex_format != INVALID_ID) {
 		// Uses vertices, else it does not.
 		const VertexDescriptionCache *vd;
@@ -4873,6 +4876,7 @@ RID RenderingDevice::render_pipeline_create(RID p_shader, FramebufferFormatID p_
 		ERR_FAIL_NULL_V(vd, RID());
 
 		driver_vertex_format = vd->driver_id;
+		vertex_attributes = &vd->vertex_formats;
 
 		// Validate with inputs.
 		for (uint32_t i = 0; i < 64; i++) {
@@ -4970,6 +4974,10 @@ RID RenderingDevice::render_pipeline_create(RID p_shader, FramebufferFormatID p_
 		update_pipeline_cache();
 	}
 
+	if (pipeline_usage.record) {
+		_pipeline_usage_record(shader, fb_format.E->key(), vertex_attributes, p_render_primitive, p_rasterization_state, p_multisample_state, p_depth_stencil_state, p_blend_state, p_dynamic_state_flags, p_for_render_pass, p_specialization_constants);
+	}
+
 	pipeline.shader = p_shader;
 	pipeline.shader_driver_id = shader->driver_id;
 	pipeline.shader_layout_hash = shader->layout_hash;
@@ -7608,6 +7616,11 @@ bool RenderingDevice::_dependencies_make_mutable(RID p_id, RDG::ResourceTracker
 void RenderingDevice::free_rid(RID p_rid) {
 	ERR_RENDER_THREAD_GUARD();
 
+	if (pipeline_usage.precompile && shader_owner.owns(p_rid)) {
+		// Pipelines still being precompiled for this shader would become dependencies after they're freed.
+		_pipeline_usage_cancel_shader(p_rid);
+	}
+
 	_free_dependencies(p_rid); // Recursively erase dependencies first, to avoid potential API problems.
 	_free_internal(p_rid);
 }
@@ -8075,6 +8088,9 @@ void RenderingDevice::_begin_frame(bool p_presented) {
 	GodotProfileZoneGrouped(_profile_zone, "_free_pending_resources");
 	_free_pending_resources(frame);
 
+	// Release the pipelines that were created to warm up the pipeline cache.
+	_pipeline_usage_update(false);
+
 	// Advance staging buffers if used.
 	if (upload_staging_buffers.used) {
 		upload_staging_buffers.current = (upload_staging_buffers.current + 1) % upload_staging_buffers.blocks.size();
@@ -8524,8 +8540,16 @@ Error RenderingDevice::initialize(RenderingContextDriver *p_context, DisplayServ
 	driver->begin_segment(frame, frames_drawn++);
 	driver->command_buffer_begin(frames[0].command_buffer);
 
+	// The command graph can record its largest draw lists into secondary command buffers on worker threads. This can be very beneficial
+	// towards reducing the time the main thread takes to record all the rendering commands. However, it's not enabled by default as it's
+	// been shown to cause some strange issues with certain IHVs that have yet to be understood, and only Vulkan supports it.
+	uint32_t secondary_command_buffers_per_frame = 0;
+	if (driver->get_api_name() == "Vulkan") {
+		secondary_command_buffers_per_frame = GLOBAL_GET("rendering/rendering_device/secondary_command_buffers/max_per_frame");
+	}
+
 	// Create draw graph and start it initialized as well.
-	draw_graph.initialize(driver, &_render_pass_create_from_graph, frames.size(), main_queue_family, SECONDARY_COMMAND_BUFFERS_PER_FRAME);
+	draw_graph.initialize(driver, &_render_pass_create_from_graph, frames.size(), main_queue_family, secondary_command_buffers_per_frame);
 	draw_graph.begin();
 
 	for (uint32_t i = 0; i < frames.size(); i++) {
@@ -8595,6 +8619,10 @@ Error RenderingDevice::initialize(RenderingContextDriver *p_context, DisplayServ
 		}
 	}
 
+	if (is_main_instance) {
+		_pipeline_usage_initialize();
+	}
+
 	// Find the best method available for VRS on the current hardware.
 	_vrs_detect_method();
 
@@ -8675,6 +8703,547 @@ void RenderingDevice::_save_pipeline_cache(void *p_data) {
 	}
 }
 
+/************************/
+/**** PIPELINE USAGE ****/
+/************************/
+
+#define PIPELINE_USAGE_FILE_MAGIC 0x55504452 // "RDPU"
+#define PIPELINE_USAGE_FILE_VERSION 1
+
+namespace {
+
+// Pipeline descriptions are serialized field by field so they can be compared and
+// hashed as plain bytes, regardless of struct padding or pointers inside vectors.
+class PipelineUsageWriter {
+	LocalVector<uint8_t> &data;
+
+public:
+	void put_u32(uint32_t p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + sizeof(uint32_t));
+		encode_uint32(p_value, &data[ofs]);
+	}
+
+	void put_u64(uint64_t p_value) {
+		put_u32(uint32_t(p_value));
+		put_u32(uint32_t(p_value >> 32));
+	}
+
+	void put_float(float p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + sizeof(float));
+		encode_float(p_value, &data[ofs]);
+	}
+
+	void put_int_vector(const Vector<int32_t> &p_values) {
+		put_u32(p_values.size());
+		for (int32_t value : p_values) {
+			put_u32(uint32_t(value));
+		}
+	}
+
+	PipelineUsageWriter(LocalVector<uint8_t> &r_data) :
+			data(r_data) {}
+};
+
+class PipelineUsageReader {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t ofs = 0;
+	bool failed = false;
+
+public:
+	uint32_t get_u32() {
+		if (ofs + sizeof(uint32_t) > size) {
+			failed = true;
+			return 0;
+		}
+		uint32_t value = decode_uint32(data + ofs);
+		ofs += sizeof(uint32_t);
+		return value;
+	}
+
+	uint64_t get_u64() {
+		uint64_t low = get_u32();
+		return low | (uint64_t(get_u32()) << 32);
+	}
+
+	float get_float() {
+		if (ofs + sizeof(float) > size) {
+			failed = true;
+			return 0.0f;
+		}
+		float value = decode_float(data + ofs);
+		ofs += sizeof(float);
+		return value;
+	}
+
+	// Counts are bounded by the remaining data, so a corrupt file can't trigger huge allocations.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (count > size - ofs) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	Vector<int32_t> get_int_vector() {
+		Vector<int32_t> values;
+		uint32_t count = get_count();
+		values.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			values.write[i] = int32_t(get_u32());
+		}
+		return values;
+	}
+
+	bool is_valid() const {
+		return !failed && ofs == size;
+	}
+
+	PipelineUsageReader(const uint8_t *p_data, uint32_t p_size) :
+			data(p_data),
+			size(p_size) {}
+};
+
+} // namespace
+
+uint64_t RenderingDevice::_pipeline_usage_hash(const uint8_t *p_data, uint32_t p_size) {
+	uint64_t low = hash_murmur3_buffer(p_data, p_size);
+	uint64_t high = hash_murmur3_buffer(p_data, p_size, 0x9e3779b9);
+	return low | (high << 32);
+}
+
+void RenderingDevice::_pipeline_usage_initialize() {
+	pipeline_usage.record = GLOBAL_GET("rendering/rendering_device/pipeline_usage/record");
+	pipeline_usage.precompile = GLOBAL_GET("rendering/rendering_device/pipeline_usage/precompile");
+	pipeline_usage.file_path = GLOBAL_GET("rendering/rendering_device/pipeline_usage/file_path");
+	if (Engine::get_singleton()->is_editor_hint() || pipeline_usage.file_path.is_empty()) {
+		// The editor creates pipelines the project never uses, keep them out of the recording.
+		pipeline_usage.record = false;
+		pipeline_usage.precompile = false;
+		return;
+	}
+
+	if (pipeline_usage.precompile && !pipeline_cache_enabled) {
+		// Precompiled pipelines are freed right away, only the driver's pipeline cache keeps the work.
+		WARN_PRINT("Precompiling recorded pipeline usage requires \"rendering/rendering_device/pipeline_cache/enable\" to be enabled.");
+		pipeline_usage.precompile = false;
+	}
+
+	if ((!pipeline_usage.record && !pipeline_usage.precompile) || !FileAccess::exists(pipeline_usage.file_path)) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(pipeline_usage.file_path, FileAccess::READ);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Unable to open pipeline usage file \"%s\".", pipeline_usage.file_path));
+	if (f->get_32() != PIPELINE_USAGE_FILE_MAGIC || f->get_32() != PIPELINE_USAGE_FILE_VERSION) {
+		WARN_PRINT(vformat("Pipeline usage file \"%s\" is invalid or was created by a different version, ignoring it.", pipeline_usage.file_path));
+		return;
+	}
+
+	uint32_t count = f->get_32();
+	uint32_t pending_count = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t size = f->get_32();
+		if (f->eof_reached() || size < sizeof(uint64_t) || size > f->get_length() - f->get_position()) {
+			WARN_PRINT(vformat("Pipeline usage file \"%s\" is truncated.", pipeline_usage.file_path));
+			break;
+		}
+
+		Vector<uint8_t> description;
+		description.resize(size);
+		f->get_buffer(description.ptrw(), size);
+
+		if (pipeline_usage.record) {
+			// Keep what previous sessions recorded, so several play sessions accumulate into one file.
+			uint64_t hash = _pipeline_usage_hash(description.ptr(), size);
+			if (!pipeline_usage.recorded_hashes.has(hash)) {
+				pipeline_usage.recorded_hashes.insert(hash);
+				pipeline_usage.recorded.push_back(description);
+			}
+		}
+
+		if (pipeline_usage.precompile) {
+			uint64_t shader_hash = PipelineUsageReader(description.ptr(), size).get_u64();
+			pipeline_usage.pending[shader_hash].push_back(description);
+			pending_count++;
+		}
+	}
+
+	if (pipeline_usage.precompile) {
+		print_verbose(vformat("Loaded %d pipelines to precompile for %d shaders from \"%s\".", pending_count, pipeline_usage.pending.size(), pipeline_usage.file_path));
+	}
+}
+
+void RenderingDevice::_pipeline_usage_record(const Shader *p_shader, const FramebufferFormatKey &p_framebuffer_key, const Vector<VertexAttribute> *p_vertex_attributes, RenderPrimitive p_render_primitive, const PipelineRasterizationState &p_rasterization_state, const PipelineMultisampleState &p_multisample_state, const PipelineDepthStencilState &p_depth_stencil_state, const PipelineColorBlendState &p_blend_state, BitField<PipelineDynamicStateFlags> p_dynamic_state_flags, uint32_t p_for_render_pass, const Vector<PipelineSpecializationConstant> &p_specialization_constants) {
+	LocalVector<uint8_t> data;
+	PipelineUsageWriter w(data);
+
+	// The shader binary hash must come first, it's used to group the descriptions when loading.
+	w.put_u64(p_shader->binary_hash);
+
+	w.put_u32(p_framebuffer_key.attachments.size());
+	for (const AttachmentFormat &attachment : p_framebuffer_key.attachments) {
+		w.put_u32(attachment.format);
+		w.put_u32(attachment.samples);
+		w.put_u32(attachment.usage_flags);
+	}
+	w.put_u32(p_framebuffer_key.passes.size());
+	for (const FramebufferPass &pass : p_framebuffer_key.passes) {
+		w.put_int_vector(pass.color_attachments);
+		w.put_int_vector(pass.input_attachments);
+		w.put_int_vector(pass.resolve_attachments);
+		w.put_int_vector(pass.preserve_attachments);
+		w.put_u32(uint32_t(pass.depth_attachment));
+		w.put_u32(uint32_t(pass.depth_resolve_attachment));
+	}
+	w.put_u32(p_framebuffer_key.view_count);
+	w.put_u32(uint32_t(p_framebuffer_key.vrs_attachment));
+
+	w.put_u32(p_vertex_attributes != nullptr);
+	if (p_vertex_attributes) {
+		w.put_u32(p_vertex_attributes->size());
+		for (const VertexAttribute &attribute : *p_vertex_attributes) {
+			w.put_u32(attribute.binding);
+			w.put_u32(attribute.location);
+			w.put_u32(attribute.offset);
+			w.put_u32(attribute.format);
+			w.put_u32(attribute.stride);
+			w.put_u32(attribute.frequency);
+		}
+	}
+
+	w.put_u32(p_render_primitive);
+
+	w.put_u32(p_rasterization_state.enable_depth_clamp);
+	w.put_u32(p_rasterization_state.discard_primitives);
+	w.put_u32(p_rasterization_state.wireframe);
+	w.put_u32(p_rasterization_state.cull_mode);
+	w.put_u32(p_rasterization_state.front_face);
+	w.put_u32(p_rasterization_state.depth_bias_enabled);
+	w.put_float(p_rasterization_state.depth_bias_constant_factor);
+	w.put_float(p_rasterization_state.depth_bias_clamp);
+	w.put_float(p_rasterization_state.depth_bias_slope_factor);
+	w.put_float(p_rasterization_state.line_width);
+	w.put_u32(p_rasterization_state.patch_control_points);
+
+	w.put_u32(p_multisample_state.sample_count);
+	w.put_u32(p_multisample_state.enable_sample_shading);
+	w.put_float(p_multisample_state.min_sample_shading);
+	w.put_u32(p_multisample_state.sample_mask.size());
+	for (uint32_t mask : p_multisample_state.sample_mask) {
+		w.put_u32(mask);
+	}
+	w.put_u32(p_multisample_state.enable_alpha_to_coverage);
+	w.put_u32(p_multisample_state.enable_alpha_to_one);
+
+	w.put_u32(p_depth_stencil_state.enable_depth_test);
+	w.put_u32(p_depth_stencil_state.enable_depth_write);
+	w.put_u32(p_depth_stencil_state.depth_compare_operator);
+	w.put_u32(p_depth_stencil_state.enable_depth_range);
+	w.put_float(p_depth_stencil_state.depth_range_min);
+	w.put_float(p_depth_stencil_state.depth_range_max);
+	w.put_u32(p_depth_stencil_state.enable_stencil);
+	for (const PipelineDepthStencilState::StencilOperationState *op : { &p_depth_stencil_state.front_op, &p_depth_stencil_state.back_op }) {
+		w.put_u32(op->fail);
+		w.put_u32(op->pass);
+		w.put_u32(op->depth_fail);
+		w.put_u32(op->compare);
+		w.put_u32(op->compare_mask);
+		w.put_u32(op->write_mask);
+		w.put_u32(op->reference);
+	}
+
+	w.put_u32(p_blend_state.enable_logic_op);
+	w.put_u32(p_blend_state.logic_op);
+	w.put_u32(p_blend_state.attachments.size());
+	for (const PipelineColorBlendState::Attachment &attachment : p_blend_state.attachments) {
+		w.put_u32(attachment.enable_blend);
+		w.put_u32(attachment.src_color_blend_factor);
+		w.put_u32(attachment.dst_color_blend_factor);
+		w.put_u32(attachment.color_blend_op);
+		w.put_u32(attachment.src_alpha_blend_factor);
+		w.put_u32(attachment.dst_alpha_blend_factor);
+		w.put_u32(attachment.alpha_blend_op);
+		w.put_u32((attachment.write_r ? 1 : 0) | (attachment.write_g ? 2 : 0) | (attachment.write_b ? 4 : 0) | (attachment.write_a ? 8 : 0));
+	}
+	w.put_float(p_blend_state.blend_constant.r);
+	w.put_float(p_blend_state.blend_constant.g);
+	w.put_float(p_blend_state.blend_constant.b);
+	w.put_float(p_blend_state.blend_constant.a);
+
+	w.put_u32(p_dynamic_state_flags);
+	w.put_u32(p_for_render_pass);
+	w.put_u32(p_specialization_constants.size());
+	for (const PipelineSpecializationConstant &constant : p_specialization_constants) {
+		w.put_u32(constant.type);
+		w.put_u32(constant.constant_id);
+		w.put_u32(constant.int_value);
+	}
+
+	uint64_t hash = _pipeline_usage_hash(data.ptr(), data.size());
+
+	MutexLock lock(pipeline_usage.mutex);
+	if (pipeline_usage.recorded_hashes.has(hash)) {
+		return;
+	}
+	pipeline_usage.recorded_hashes.insert(hash);
+
+	Vector<uint8_t> description;
+	description.resize(data.size());
+	memcpy(description.ptrw(), data.ptr(), data.size());
+	pipeline_usage.recorded.push_back(description);
+}
+
+void RenderingDevice::_pipeline_usage_precompile_shader(RID p_shader, uint64_t p_binary_hash) {
+	MutexLock lock(pipeline_usage.mutex);
+	HashMap<uint64_t, LocalVector<Vector<uint8_t>>>::Iterator E = pipeline_usage.pending.find(p_binary_hash);
+	if (!E) {
+		return;
+	}
+
+	// Each recorded description is only precompiled once, even if the shader is created again later.
+	PipelineUsagePrecompilation *precompilation = memnew(PipelineUsagePrecompilation);
+	precompilation->shader = p_shader;
+	precompilation->descriptions = std::move(E->value);
+	pipeline_usage.pending.remove(E);
+
+	precompilation->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RenderingDevice::_pipeline_usage_precompile_task, precompilation, precompilation->descriptions.size(), -1, false, SNAME("PipelinePrecompilation"));
+	pipeline_usage.precompilations.push_back(precompilation);
+}
+
+void RenderingDevice::_pipeline_usage_precompile_task(uint32_t p_index, PipelineUsagePrecompilation *p_precompilation) {
+	if (p_precompilation->cancelled.is_set()) {
+		return;
+	}
+
+	const Vector<uint8_t> &description = p_precompilation->descriptions[p_index];
+	PipelineUsageReader r(description.ptr(), description.size());
+	r.get_u64(); // Shader binary hash, already matched.
+
+	Vector<AttachmentFormat> attachments;
+	attachments.resize(r.get_count());
+	for (AttachmentFormat &attachment : attachments) {
+		attachment.format = DataFormat(r.get_u32());
+		attachment.samples = TextureSamples(r.get_u32());
+		attachment.usage_flags = r.get_u32();
+	}
+	Vector<FramebufferPass> passes;
+	passes.resize(r.get_count());
+	for (FramebufferPass &pass : passes) {
+		pass.color_attachments = r.get_int_vector();
+		pass.input_attachments = r.get_int_vector();
+		pass.resolve_attachments = r.get_int_vector();
+		pass.preserve_attachments = r.get_int_vector();
+		pass.depth_attachment = int32_t(r.get_u32());
+		pass.depth_resolve_attachment = int32_t(r.get_u32());
+	}
+	uint32_t view_count = r.get_u32();
+	int32_t vrs_attachment = int32_t(r.get_u32());
+
+	bool has_vertex_format = r.get_u32();
+	Vector<VertexAttribute> vertex_attributes;
+	if (has_vertex_format) {
+		vertex_attributes.resize(r.get_count());
+		for (VertexAttribute &attribute : vertex_attributes) {
+			attribute.binding = r.get_u32();
+			attribute.location = r.get_u32();
+			attribute.offset = r.get_u32();
+			attribute.format = DataFormat(r.get_u32());
+			attribute.stride = r.get_u32();
+			attribute.frequency = VertexFrequency(r.get_u32());
+		}
+	}
+
+	RenderPrimitive render_primitive = RenderPrimitive(r.get_u32());
+
+	PipelineRasterizationState rasterization_state;
+	rasterization_state.enable_depth_clamp = r.get_u32();
+	rasterization_state.discard_primitives = r.get_u32();
+	rasterization_state.wireframe = r.get_u32();
+	rasterization_state.cull_mode = PolygonCullMode(r.get_u32());
+	rasterization_state.front_face = PolygonFrontFace(r.get_u32());
+	rasterization_state.depth_bias_enabled = r.get_u32();
+	rasterization_state.depth_bias_constant_factor = r.get_float();
+	rasterization_state.depth_bias_clamp = r.get_float();
+	rasterization_state.depth_bias_slope_factor = r.get_float();
+	rasterization_state.line_width = r.get_float();
+	rasterization_state.patch_control_points = r.get_u32();
+
+	PipelineMultisampleState multisample_state;
+	multisample_state.sample_count = TextureSamples(r.get_u32());
+	multisample_state.enable_sample_shading = r.get_u32();
+	multisample_state.min_sample_shading = r.get_float();
+	multisample_state.sample_mask.resize(r.get_count());
+	for (uint32_t &mask : multisample_state.sample_mask) {
+		mask = r.get_u32();
+	}
+	multisample_state.enable_alpha_to_coverage = r.get_u32();
+	multisample_state.enable_alpha_to_one = r.get_u32();
+
+	PipelineDepthStencilState depth_stencil_state;
+	depth_stencil_state.enable_depth_test = r.get_u32();
+	depth_stencil_state.enable_depth_write = r.get_u32();
+	depth_stencil_state.depth_compare_operator = CompareOperator(r.get_u32());
+	depth_stencil_state.enable_depth_range = r.get_u32();
+	depth_stencil_state.depth_range_min = r.get_float();
+	depth_stencil_state.depth_range_max = r.get_float();
+	depth_stencil_state.enable_stencil = r.get_u32();
+	for (PipelineDepthStencilState::StencilOperationState *op : { &depth_stencil_state.front_op, &depth_stencil_state.back_op }) {
+		op->fail = StencilOperation(r.get_u32());
+		op->pass = StencilOperation(r.get_u32());
+		op->depth_fail = StencilOperation(r.get_u32());
+		op->compare = CompareOperator(r.get_u32());
+		op->compare_mask = r.get_u32();
+		op->write_mask = r.get_u32();
+		op->reference = r.get_u32();
+	}
+
+	PipelineColorBlendState blend_state;
+	blend_state.enable_logic_op = r.get_u32();
+	blend_state.logic_op = LogicOperation(r.get_u32());
+	blend_state.attachments.resize(r.get_count());
+	for (PipelineColorBlendState::Attachment &attachment : blend_state.attachments) {
+		attachment.enable_blend = r.get_u32();
+		attachment.src_color_blend_factor = BlendFactor(r.get_u32());
+		attachment.dst_color_blend_factor = BlendFactor(r.get_u32());
+		attachment.color_blend_op = BlendOperation(r.get_u32());
+		attachment.src_alpha_blend_factor = BlendFactor(r.get_u32());
+		attachment.dst_alpha_blend_factor = BlendFactor(r.get_u32());
+		attachment.alpha_blend_op = BlendOperation(r.get_u32());
+		uint32_t write_mask = r.get_u32();
+		attachment.write_r = write_mask & 1;
+		attachment.write_g = write_mask & 2;
+		attachment.write_b = write_mask & 4;
+		attachment.write_a = write_mask & 8;
+	}
+	blend_state.blend_constant.r = r.get_float();
+	blend_state.blend_constant.g = r.get_float();
+	blend_state.blend_constant.b = r.get_float();
+	blend_state.blend_constant.a = r.get_float();
+
+	BitField<PipelineDynamicStateFlags> dynamic_state_flags = r.get_u32();
+	uint32_t for_render_pass = r.get_u32();
+	Vector<PipelineSpecializationConstant> specialization_constants;
+	specialization_constants.resize(r.get_count());
+	for (PipelineSpecializationConstant &constant : specialization_constants) {
+		constant.type = PipelineSpecializationConstantType(r.get_u32());
+		constant.constant_id = r.get_u32();
+		constant.int_value = r.get_u32();
+	}
+
+	if (!r.is_valid()) {
+		print_verbose("Skipping malformed pipeline description in pipeline usage file.");
+		return;
+	}
+
+	FramebufferFormatID framebuffer_format;
+	if (attachments.is_empty()) {
+		framebuffer_format = framebuffer_format_create_empty(multisample_state.sample_count);
+	} else {
+		framebuffer_format = framebuffer_format_create_multipass(attachments, passes, view_count, vrs_attachment);
+	}
+	VertexFormatID vertex_format = has_vertex_format ? vertex_format_create(vertex_attributes) : INVALID_ID;
+	if (framebuffer_format == INVALID_ID || (has_vertex_format && vertex_format == INVALID_ID)) {
+		return;
+	}
+
+	RID pipeline = render_pipeline_create(p_precompilation->shader, framebuffer_format, vertex_format, render_primitive, rasterization_state, multisample_state, depth_stencil_state, blend_state, dynamic_state_flags, for_render_pass, specialization_constants);
+	if (pipeline.is_valid()) {
+		// Pipelines can only be freed from the render thread, they're released on the next frame.
+		MutexLock lock(pipeline_usage.mutex);
+		pipeline_usage.precompiled_pipelines.push_back(pipeline);
+		pipeline_usage.precompiled_count++;
+	}
+}
+
+// Tasks access the shader without holding any lock, so they must be done before it's freed.
+void RenderingDevice::_pipeline_usage_cancel_shader(RID p_shader) {
+	LocalVector<PipelineUsagePrecompilation *> cancelled;
+	{
+		MutexLock lock(pipeline_usage.mutex);
+		for (uint32_t i = 0; i < pipeline_usage.precompilations.size(); i++) {
+			PipelineUsagePrecompilation *precompilation = pipeline_usage.precompilations[i];
+			if (precompilation->shader == p_shader) {
+				precompilation->cancelled.set();
+				cancelled.push_back(precompilation);
+				pipeline_usage.precompilations.remove_at_unordered(i);
+				i--;
+			}
+		}
+	}
+
+	// Same as in _pipeline_usage_update(), wait without holding the usage mutex.
+	for (PipelineUsagePrecompilation *precompilation : cancelled) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(precompilation->group_task);
+		memdelete(precompilation);
+	}
+}
+
+void RenderingDevice::_pipeline_usage_update(bool p_finalizing) {
+	if (!pipeline_usage.precompile) {
+		return;
+	}
+
+	LocalVector<PipelineUsagePrecompilation *> finished;
+	LocalVector<RID> pipelines;
+	{
+		MutexLock lock(pipeline_usage.mutex);
+		for (uint32_t i = 0; i < pipeline_usage.precompilations.size(); i++) {
+			PipelineUsagePrecompilation *precompilation = pipeline_usage.precompilations[i];
+			if (p_finalizing || WorkerThreadPool::get_singleton()->is_group_task_completed(precompilation->group_task)) {
+				finished.push_back(precompilation);
+				pipeline_usage.precompilations.remove_at_unordered(i);
+				i--;
+			}
+		}
+	}
+
+	// The tasks may be blocked on the device's lock, so they must be waited on without holding the usage mutex.
+	for (PipelineUsagePrecompilation *precompilation : finished) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(precompilation->group_task);
+		memdelete(precompilation);
+	}
+
+	{
+		MutexLock lock(pipeline_usage.mutex);
+		pipelines = std::move(pipeline_usage.precompiled_pipelines);
+		if (!finished.is_empty() && pipeline_usage.precompilations.is_empty()) {
+			print_verbose(vformat("Precompiled %d pipelines from recorded pipeline usage so far.", pipeline_usage.precompiled_count));
+		}
+	}
+
+	for (const RID &pipeline : pipelines) {
+		// The shader may have been freed already, which also frees its pipelines.
+		if (render_pipeline_owner.owns(pipeline)) {
+			free_rid(pipeline);
+		}
+	}
+}
+
+void RenderingDevice::_pipeline_usage_save() {
+	if (!pipeline_usage.record) {
+		return;
+	}
+
+	MutexLock lock(pipeline_usage.mutex);
+	DirAccess::make_dir_recursive_absolute(pipeline_usage.file_path.get_base_dir());
+	Ref<FileAccess> f = FileAccess::open(pipeline_usage.file_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Unable to write pipeline usage file \"%s\".", pipeline_usage.file_path));
+
+	f->store_32(PIPELINE_USAGE_FILE_MAGIC);
+	f->store_32(PIPELINE_USAGE_FILE_VERSION);
+	f->store_32(pipeline_usage.recorded.size());
+	for (const Vector<uint8_t> &description : pipeline_usage.recorded) {
+		f->store_32(description.size());
+		f->store_buffer(description);
+	}
+
+	print_verbose(vformat("Recorded %d pipelines to \"%s\".", pipeline_usage.recorded.size(), pipeline_usage.file_path));
+}
+
 template <typename T>
 void RenderingDevice::_free_rids(T &p_owner, const char *p_type) {
 	LocalVector<RID> owned = p_owner.get_owned_list();
@@ -8872,6 +9441,10 @@ void RenderingDevice::finalize() {
 	// Delete everything the graph has created.
 	draw_graph.finalize();
 
+	// Finish precompiling pipelines and save the recorded pipeline usage.
+	_pipeline_usage_update(true);
+	_pipeline_usage_save();
+
 	// Free all resources.
 	_free_rids(render_pipeline_owner, "Pipeline");
 	_free_rids(compute_pipeline_owner, "Compute");
@@ -942,6 +942,7 @@ private:
 		String name; // Used for debug.
 		RDD::ShaderID driver_id;
 		uint32_t layout_hash = 0;
+		uint64_t binary_hash = 0; // Only computed when pipeline usage is recorded or precompiled.
 		BitField<RDD::PipelineStageBits> stage_bits = {};
 		Vector<uint32_t> set_formats;
 	};
@@ -1239,6 +1240,39 @@ private:
 	Vector<uint8_t> _load_pipeline_cache();
 	static void _save_pipeline_cache(void *p_data);
 
+	// Render pipelines created during a session can be recorded to a file and precompiled on later
+	// runs. Recorded descriptions are grouped by the hash of the shader binary they use and created
+	// on worker threads as soon as a matching shader is, so the driver's pipeline cache is warm by
+	// the time the renderer asks for them.
+	struct PipelineUsagePrecompilation {
+		RID shader;
+		LocalVector<Vector<uint8_t>> descriptions;
+		WorkerThreadPool::GroupID group_task = -1;
+		SafeFlag cancelled; // Set when the shader is about to be freed.
+	};
+
+	struct PipelineUsage {
+		Mutex mutex;
+		bool record = false;
+		bool precompile = false;
+		String file_path;
+		HashSet<uint64_t> recorded_hashes;
+		LocalVector<Vector<uint8_t>> recorded;
+		HashMap<uint64_t, LocalVector<Vector<uint8_t>>> pending; // Keyed by shader binary hash.
+		LocalVector<PipelineUsagePrecompilation *> precompilations;
+		LocalVector<RID> precompiled_pipelines;
+		uint32_t precompiled_count = 0;
+	} pipeline_usage;
+
+	static uint64_t _pipeline_usage_hash(const uint8_t *p_data, uint32_t p_size);
+	void _pipeline_usage_initialize();
+	void _pipeline_usage_record(const Shader *p_shader, const FramebufferFormatKey &p_framebuffer_key, const Vector<VertexAttribute> *p_vertex_attributes, RenderPrimitive p_render_primitive, const PipelineRasterizationState &p_rasterization_state, const PipelineMultisampleState &p_multisample_state, const PipelineDepthStencilState &p_depth_stencil_state, const PipelineColorBlendState &p_blend_state, BitField<PipelineDynamicStateFlags> p_dynamic_state_flags, uint32_t p_for_render_pass, const Vector<PipelineSpecializationConstant> &p_specialization_constants);
+	void _pipeline_usage_precompile_shader(RID p_shader, uint64_t p_binary_hash);
+	void _pipeline_usage_precompile_task(uint32_t p_index, PipelineUsagePrecompilation *p_precompilation);
+	void _pipeline_usage_cancel_shader(RID p_shader);
+	void _pipeline_usage_update(bool p_finalizing);
+	void _pipeline_usage_save();
+
 	struct ComputePipeline {
 		RID shader;
 		RDD::ShaderID shader_driver_id;
@@ -38,6 +38,10 @@
 // Prints the total number of bytes used for draw lists in a frame.
 #define PRINT_DRAW_LIST_STATS 0
 
+// Draw lists with less instruction data than this are recorded directly into the primary command buffer, as the cost of
+// dispatching them to a worker thread would outweigh the time saved.
+#define SECONDARY_COMMAND_BUFFER_MIN_INSTRUCTION_DATA_SIZE (16 * 1024)
+
 RenderingDeviceGraph::RenderingDeviceGraph() {
 	driver_honors_barriers = false;
 	driver_clears_with_copy_engine = false;
@@ -1067,6 +1071,7 @@ void RenderingDeviceGraph::_add_draw_list_begin(FramebufferCache *p_framebuffer_
 	}
 
 	draw_instruction_list.split_cmd_buffer = p_split_cmd_buffer;
+	draw_instruction_list.can_use_secondary = true;
 
 #if defined(DEBUG_ENABLED) || defined(DEV_ENABLED)
 	draw_instruction_list.breadcrumb = p_breadcrumb;
@@ -1075,10 +1080,55 @@ void RenderingDeviceGraph::_add_draw_list_begin(FramebufferCache *p_framebuffer_
 
 void RenderingDeviceGraph::_run_secondary_command_buffer_task(const SecondaryCommandBuffer *p_secondary) {
 	driver->command_buffer_begin_secondary(p_secondary->command_buffer, p_secondary->render_pass, 0, p_secondary->framebuffer);
-	_run_draw_list_command(p_secondary->command_buffer, p_secondary->instruction_data.ptr(), p_secondary->instruction_data.size());
+	_run_draw_list_command(p_secondary->command_buffer, p_secondary->instruction_data, p_secondary->instruction_data_size);
 	driver->command_buffer_end(p_secondary->command_buffer);
 }
 
+void RenderingDeviceGraph::_start_secondary_command_buffer_tasks(const RecordedCommandSort *p_sorted_commands, uint32_t p_sorted_commands_count) {
+	Frame &f = frames[frame];
+	if (f.secondary_command_buffers.is_empty()) {
+		return;
+	}
+
+	// The largest draw lists are recorded into secondary command buffers by worker threads while the main thread
+	// records everything else. The primary command buffer only needs to wait for them once it reaches each one.
+	for (uint32_t i = 0; i < p_sorted_commands_count && f.secondary_command_buffers_used < f.secondary_command_buffers.size(); i++) {
+		const uint32_t command_data_offset = command_data_offsets[p_sorted_commands[i].index];
+		RecordedCommand *command = reinterpret_cast<RecordedCommand *>(&command_data[command_data_offset]);
+		if (command->type != RecordedCommand::TYPE_DRAW_LIST) {
+			continue;
+		}
+
+		RecordedDrawListCommand *draw_list_command = static_cast<RecordedDrawListCommand *>(command);
+		draw_list_command->secondary_command_buffer_index = -1;
+		if (!draw_list_command->can_use_secondary || draw_list_command->instruction_data_size < SECONDARY_COMMAND_BUFFER_MIN_INSTRUCTION_DATA_SIZE) {
+			continue;
+		}
+
+		// Render passes and framebuffers are created on demand, which must happen on this thread.
+		RDD::RenderPassID render_pass;
+		RDD::FramebufferID framebuffer;
+		if (draw_list_command->framebuffer_cache != nullptr) {
+			_get_draw_list_render_pass_and_framebuffer(draw_list_command, render_pass, framebuffer);
+		} else {
+			render_pass = draw_list_command->render_pass;
+			framebuffer = draw_list_command->framebuffer;
+		}
+
+		if (!framebuffer || !render_pass) {
+			continue;
+		}
+
+		draw_list_command->secondary_command_buffer_index = f.secondary_command_buffers_used++;
+		SecondaryCommandBuffer &secondary = f.secondary_command_buffers[draw_list_command->secondary_command_buffer_index];
+		secondary.instruction_data = draw_list_command->instruction_data();
+		secondary.instruction_data_size = draw_list_command->instruction_data_size;
+		secondary.render_pass = render_pass;
+		secondary.framebuffer = framebuffer;
+		secondary.task = WorkerThreadPool::get_singleton()->add_template_task(this, &RenderingDeviceGraph::_run_secondary_command_buffer_task, &secondary, true, SNAME("RenderingDeviceGraphSecondaryCommandBuffer"));
+	}
+}
+
 void RenderingDeviceGraph::_wait_for_secondary_command_buffer_tasks() {
 	for (uint32_t i = 0; i < frames[frame].secondary_command_buffers_used; i++) {
 		WorkerThreadPool::TaskID &task = frames[frame].secondary_command_buffers[i].task;
@@ -1194,7 +1244,17 @@ void RenderingDeviceGraph::_run_render_commands(int32_t p_level, const RecordedC
 					framebuffer = draw_list_command->framebuffer;
 				}
 
-				if (framebuffer && render_pass) {
+				if (draw_list_command->secondary_command_buffer_index >= 0) {
+					SecondaryCommandBuffer &secondary = frames[frame].secondary_command_buffers[draw_list_command->secondary_command_buffer_index];
+					driver->command_begin_render_pass(r_command_buffer, secondary.render_pass, secondary.framebuffer, RDD::COMMAND_BUFFER_TYPE_SECONDARY, draw_list_command->region, clear_values);
+					if (secondary.task != WorkerThreadPool::INVALID_TASK_ID) {
+						WorkerThreadPool::get_singleton()->wait_for_task_completion(secondary.task);
+						secondary.task = WorkerThreadPool::INVALID_TASK_ID;
+					}
+
+					driver->command_buffer_execute_secondary(r_command_buffer, secondary.command_buffer);
+					driver->command_end_render_pass(r_command_buffer);
+				} else if (framebuffer && render_pass) {
 					driver->command_begin_render_pass(r_command_buffer, render_pass, framebuffer, draw_list_command->command_buffer_type, draw_list_command->region, clear_values);
 					_run_draw_list_command(r_command_buffer, draw_list_command->instruction_data(), draw_list_command->instruction_data_size);
 					driver->command_end_render_pass(r_command_buffer);
@@ -2264,12 +2324,14 @@ void RenderingDeviceGraph::add_draw_list_execute_commands(RDD::CommandBufferID p
 	DrawListExecuteCommandsInstruction *instruction = reinterpret_cast<DrawListExecuteCommandsInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListExecuteCommandsInstruction)));
 	instruction->type = DrawListInstruction::TYPE_EXECUTE_COMMANDS;
 	instruction->command_buffer = p_command_buffer;
+	draw_instruction_list.can_use_secondary = false;
 }
 
 void RenderingDeviceGraph::add_draw_list_next_subpass(RDD::CommandBufferType p_command_buffer_type) {
 	DrawListNextSubpassInstruction *instruction = reinterpret_cast<DrawListNextSubpassInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListNextSubpassInstruction)));
 	instruction->type = DrawListInstruction::TYPE_NEXT_SUBPASS;
 	instruction->command_buffer_type = p_command_buffer_type;
+	draw_instruction_list.can_use_secondary = false;
 }
 
 void RenderingDeviceGraph::add_draw_list_set_blend_constants(const Color &p_color) {
@@ -2358,6 +2420,8 @@ void RenderingDeviceGraph::add_draw_list_end() {
 	command->breadcrumb = draw_instruction_list.breadcrumb;
 #endif
 	command->split_cmd_buffer = draw_instruction_list.split_cmd_buffer;
+	command->can_use_secondary = draw_instruction_list.can_use_secondary;
+	command->secondary_command_buffer_index = -1;
 	command->clear_values_count = draw_instruction_list.attachment_clear_values.size();
 	command->trackers_count = trackers_count;
 
@@ -2745,6 +2809,8 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			print_line(vformat("Recording %d commands", command_count));
 #endif
 
+			_start_secondary_command_buffer_tasks(commands_sorted.ptr(), command_count);
+
 			uint32_t boosted_priority = 0;
 			uint32_t current_level = commands_sorted[0].level;
 			uint32_t current_level_start = 0;
@@ -2770,6 +2836,8 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			print_line("COMMANDS", command_count, "LEVELS", current_level + 1);
 #endif
 		} else {
+			_start_secondary_command_buffer_tasks(commands_sorted.ptr(), command_count);
+
 			for (uint32_t i = 0; i < command_count; i++) {
 				_group_barriers_for_render_commands(r_command_buffer, &commands_sorted[i], 1, p_full_barriers);
 				_run_render_commands(i, &commands_sorted[i], 1, r_command_buffer, r_command_buffer_pool, current_label_index, current_label_level);
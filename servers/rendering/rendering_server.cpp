@@ -1369,8 +1369,8 @@ Error RenderingServer::mesh_create_surface_data_from_arrays(RenderingServerTypes
 
 			RenderingServerTypes::SurfaceData::LOD lod;
 			lod.edge_length = distance;
-			lod.index_data = data;
-			lods.push_back(lod);
+			lod.index_data = std::move(data);
+			lods.push_back(std::move(lod));
 		}
 	}
 
@@ -1378,15 +1378,15 @@ Error RenderingServer::mesh_create_surface_data_from_arrays(RenderingServerTypes
 	surface_data.format = format;
 	surface_data.primitive = p_primitive;
 	surface_data.aabb = aabb;
-	surface_data.vertex_data = vertex_array;
-	surface_data.attribute_data = attrib_array;
-	surface_data.skin_data = skin_array;
+	surface_data.vertex_data = std::move(vertex_array);
+	surface_data.attribute_data = std::move(attrib_array);
+	surface_data.skin_data = std::move(skin_array);
 	surface_data.vertex_count = array_len;
-	surface_data.index_data = index_array;
+	surface_data.index_data = std::move(index_array);
 	surface_data.index_count = index_array_len;
-	surface_data.blend_shape_data = blend_shape_data;
-	surface_data.bone_aabbs = bone_aabb;
-	surface_data.lods = lods;
+	surface_data.blend_shape_data = std::move(blend_shape_data);
+	surface_data.bone_aabbs = std::move(bone_aabb);
+	surface_data.lods = std::move(lods);
 	surface_data.uv_scale = uv_scale;
 
 	return OK;
@@ -2980,6 +2980,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME);
 	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME);
 	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_CACHED_ITEMS_IN_FRAME);
 	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_MAX);
 
 	BIND_ENUM_CONSTANT(RSE::VIEWPORT_RENDER_INFO_TYPE_VISIBLE);
@@ -3690,6 +3691,7 @@ void RenderingServer::init() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/shadow_atlas/size", PROPERTY_HINT_RANGE, "128,16384"), 2048);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/batching/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/batching/uniform_set_cache_size", PROPERTY_HINT_RANGE, "256,1048576,1"), 4096);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/2d/canvas_cull/threaded_cull_minimum_items", PROPERTY_HINT_RANGE, "32,1048576,1"), 2048);
 
 	// Number of commands that can be drawn per frame.
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
@@ -3808,9 +3810,12 @@ void RenderingServer::init() {
 
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/update_iterations_per_frame", PROPERTY_HINT_RANGE, "0,1024,1"), 10);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 1000);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "rendering/limits/spatial_indexer/light_grid_cell_size", PROPERTY_HINT_RANGE, "0,256,0.01,or_greater,suffix:m"), 0.0);
 
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"), 512);
 
+	GLOBAL_DEF_RST("rendering/limits/multimesh/chunk_culling", false);
+
 	// OpenGL limits
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/opengl/max_renderable_elements", PROPERTY_HINT_RANGE, "1024,65536,1"), 65536);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/opengl/max_renderable_lights", PROPERTY_HINT_RANGE, "2,256,1"), 32);
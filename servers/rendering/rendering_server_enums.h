@@ -556,6 +556,7 @@ enum ViewportRenderInfo {
 	VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME,
 	VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME,
 	VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME,
+	VIEWPORT_RENDER_INFO_CACHED_ITEMS_IN_FRAME,
 	VIEWPORT_RENDER_INFO_MAX,
 };
 
@@ -447,7 +447,7 @@ static String _get_global_shader_uniform_from_type_and_index(const String &p_buf
 	}
 }
 
-String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
+String ShaderCompiler::_dump_node_code(CompileContext &p_context, const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
 	String code;
 
 	switch (p_node->type) {
@@ -457,9 +457,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			// Render modes.
 
 			for (int i = 0; i < pnode->render_modes.size(); i++) {
-				if (p_default_actions.render_mode_defines.has(pnode->render_modes[i]) && !used_rmode_defines.has(pnode->render_modes[i])) {
+				if (p_default_actions.render_mode_defines.has(pnode->render_modes[i]) && !p_context.used_rmode_defines.has(pnode->render_modes[i])) {
 					r_gen_code.defines.push_back(p_default_actions.render_mode_defines[pnode->render_modes[i]]);
-					used_rmode_defines.insert(pnode->render_modes[i]);
+					p_context.used_rmode_defines.insert(pnode->render_modes[i]);
 				}
 
 				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
@@ -700,7 +700,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 				if (varying.stage == SL::ShaderNode::Varying::STAGE_FRAGMENT) {
 					var_frag_to_light.push_back(Pair<StringName, SL::ShaderNode::Varying>(varying_name, varying));
-					fragment_varyings.insert(varying_name);
+					p_context.fragment_varyings.insert(varying_name);
 					continue;
 				}
 				if (varying.type < SL::TYPE_INT) {
@@ -764,7 +764,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					gcode += "]";
 				}
 				gcode += "=";
-				gcode += _dump_node_code(cnode.initializer, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				gcode += _dump_node_code(p_context, cnode.initializer, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				gcode += ";\n";
 				for (int j = 0; j < STAGE_MAX; j++) {
 					r_gen_code.stage_globals[j] += gcode;
@@ -776,10 +776,10 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			//code for functions
 			for (int i = 0; i < pnode->vfunctions.size(); i++) {
 				SL::FunctionNode *fnode = pnode->vfunctions[i].function;
-				function = fnode;
-				current_func_name = fnode->name;
-				function_code[fnode->name] = _dump_node_code(fnode->body, p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
-				function = nullptr;
+				p_context.function = fnode;
+				p_context.current_func_name = fnode->name;
+				function_code[fnode->name] = _dump_node_code(p_context, fnode->body, p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				p_context.function = nullptr;
 			}
 
 			//place functions in actual code
@@ -789,9 +789,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			for (int i = 0; i < pnode->vfunctions.size(); i++) {
 				SL::FunctionNode *fnode = pnode->vfunctions[i].function;
 
-				function = fnode;
+				p_context.function = fnode;
 
-				current_func_name = fnode->name;
+				p_context.current_func_name = fnode->name;
 
 				if (p_actions.entry_point_stages.has(fnode->name)) {
 					Stage stage = p_actions.entry_point_stages[fnode->name];
@@ -799,7 +799,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					r_gen_code.code[fnode->name] = function_code[fnode->name];
 				}
 
-				function = nullptr;
+				p_context.function = nullptr;
 			}
 
 			//code+=dump_node_code(pnode->body,p_level);
@@ -818,7 +818,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			int i = 0;
 			for (List<ShaderLanguage::Node *>::ConstIterator itr = bnode->statements.begin(); itr != bnode->statements.end(); ++itr, ++i) {
-				String scode = _dump_node_code(*itr, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String scode = _dump_node_code(p_context, *itr, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 
 				if ((*itr)->type == SL::Node::NODE_TYPE_CONTROL_FLOW || bnode->single_statement) {
 					code += scode; //use directly
@@ -854,7 +854,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				if (is_array) {
 					declaration += "[";
 					if (vdnode->declarations[i].size_expression != nullptr) {
-						declaration += _dump_node_code(vdnode->declarations[i].size_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						declaration += _dump_node_code(p_context, vdnode->declarations[i].size_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					} else {
 						declaration += itos(vdnode->declarations[i].size);
 					}
@@ -864,7 +864,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				if (!is_array || vdnode->declarations[i].single_expression) {
 					if (!vdnode->declarations[i].initializer.is_empty()) {
 						declaration += "=";
-						declaration += _dump_node_code(vdnode->declarations[i].initializer[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						declaration += _dump_node_code(p_context, vdnode->declarations[i].initializer[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					}
 				} else {
 					int size = vdnode->declarations[i].initializer.size();
@@ -883,7 +883,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							if (j > 0) {
 								declaration += ",";
 							}
-							declaration += _dump_node_code(vdnode->declarations[i].initializer[j], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+							declaration += _dump_node_code(p_context, vdnode->declarations[i].initializer[j], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 						}
 						declaration += ")";
 					}
@@ -896,13 +896,13 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			SL::VariableNode *vnode = (SL::VariableNode *)p_node;
 			bool use_fragment_varying = false;
 
-			if (!vnode->is_local && !(p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX)) {
+			if (!vnode->is_local && !(p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_VERTEX)) {
 				if (p_assigning) {
-					if (shader->varyings.has(vnode->name)) {
+					if (p_context.shader->varyings.has(vnode->name)) {
 						use_fragment_varying = true;
 					}
 				} else {
-					if (fragment_varyings.has(vnode->name)) {
+					if (p_context.fragment_varyings.has(vnode->name)) {
 						use_fragment_varying = true;
 					}
 				}
@@ -912,35 +912,35 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				*p_actions.write_flag_pointers[vnode->name] = true;
 			}
 
-			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
+			if (p_default_actions.usage_defines.has(vnode->name) && !p_context.used_name_defines.has(vnode->name)) {
 				String define = p_default_actions.usage_defines[vnode->name];
 				if (define.begins_with("@")) {
 					define = p_default_actions.usage_defines[define.substr(1)];
 				}
 				r_gen_code.defines.push_back(define);
-				used_name_defines.insert(vnode->name);
+				p_context.used_name_defines.insert(vnode->name);
 			}
 
-			if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
+			if (p_actions.usage_flag_pointers.has(vnode->name) && !p_context.used_flag_pointers.has(vnode->name)) {
 				*p_actions.usage_flag_pointers[vnode->name] = true;
-				used_flag_pointers.insert(vnode->name);
+				p_context.used_flag_pointers.insert(vnode->name);
 			}
 
 			if (p_default_actions.renames.has(vnode->name)) {
 				code = p_default_actions.renames[vnode->name];
 			} else {
 				bool param_found = false;
-				if (function) {
-					for (const SL::FunctionNode::Argument &argument : function->arguments) {
+				if (p_context.function) {
+					for (const SL::FunctionNode::Argument &argument : p_context.function->arguments) {
 						if (argument.name == vnode->name) {
 							param_found = true;
 							break;
 						}
 					}
 				}
-				if (!param_found && shader->uniforms.has(vnode->name)) {
+				if (!param_found && p_context.shader->uniforms.has(vnode->name)) {
 					//its a uniform!
-					const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[vnode->name];
+					const ShaderLanguage::ShaderNode::Uniform &u = p_context.shader->uniforms[vnode->name];
 					if (u.is_texture()) {
 						StringName name;
 						if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
@@ -993,10 +993,10 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (vnode->name == time_name) {
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
+				if (p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_FRAGMENT) {
+				if (p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_FRAGMENT) {
 					r_gen_code.uses_fragment_time = true;
 				}
 			}
@@ -1015,7 +1015,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			code += "]";
 			code += "(";
 			for (int i = 0; i < sz; i++) {
-				code += _dump_node_code(acnode->initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(p_context, acnode->initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				if (i != sz - 1) {
 					code += ", ";
 				}
@@ -1026,16 +1026,16 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			SL::ArrayNode *anode = (SL::ArrayNode *)p_node;
 			bool use_fragment_varying = false;
 
-			if (!anode->is_local && !(p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX)) {
-				if (anode->assign_expression != nullptr && shader->varyings.has(anode->name)) {
+			if (!anode->is_local && !(p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_VERTEX)) {
+				if (anode->assign_expression != nullptr && p_context.shader->varyings.has(anode->name)) {
 					use_fragment_varying = true;
 				} else {
 					if (p_assigning) {
-						if (shader->varyings.has(anode->name)) {
+						if (p_context.shader->varyings.has(anode->name)) {
 							use_fragment_varying = true;
 						}
 					} else {
-						if (fragment_varyings.has(anode->name)) {
+						if (p_context.fragment_varyings.has(anode->name)) {
 							use_fragment_varying = true;
 						}
 					}
@@ -1046,35 +1046,35 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				*p_actions.write_flag_pointers[anode->name] = true;
 			}
 
-			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
+			if (p_default_actions.usage_defines.has(anode->name) && !p_context.used_name_defines.has(anode->name)) {
 				String define = p_default_actions.usage_defines[anode->name];
 				if (define.begins_with("@")) {
 					define = p_default_actions.usage_defines[define.substr(1)];
 				}
 				r_gen_code.defines.push_back(define);
-				used_name_defines.insert(anode->name);
+				p_context.used_name_defines.insert(anode->name);
 			}
 
-			if (p_actions.usage_flag_pointers.has(anode->name) && !used_flag_pointers.has(anode->name)) {
+			if (p_actions.usage_flag_pointers.has(anode->name) && !p_context.used_flag_pointers.has(anode->name)) {
 				*p_actions.usage_flag_pointers[anode->name] = true;
-				used_flag_pointers.insert(anode->name);
+				p_context.used_flag_pointers.insert(anode->name);
 			}
 
 			if (p_default_actions.renames.has(anode->name)) {
 				code = p_default_actions.renames[anode->name];
 			} else {
 				bool param_found = false;
-				if (function) {
-					for (const SL::FunctionNode::Argument &argument : function->arguments) {
+				if (p_context.function) {
+					for (const SL::FunctionNode::Argument &argument : p_context.function->arguments) {
 						if (argument.name == anode->name) {
 							param_found = true;
 							break;
 						}
 					}
 				}
-				if (!param_found && shader->uniforms.has(anode->name)) {
+				if (!param_found && p_context.shader->uniforms.has(anode->name)) {
 					//its a uniform!
-					const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[anode->name];
+					const ShaderLanguage::ShaderNode::Uniform &u = p_context.shader->uniforms[anode->name];
 					if (u.is_texture()) {
 						code = _mkid(anode->name); //texture, use as is
 					} else {
@@ -1102,21 +1102,21 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			if (anode->call_expression != nullptr) {
 				code += ".";
-				code += _dump_node_code(anode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
+				code += _dump_node_code(p_context, anode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
 			} else if (anode->index_expression != nullptr) {
 				code += "[";
-				code += _dump_node_code(anode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(p_context, anode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += "]";
 			} else if (anode->assign_expression != nullptr) {
 				code += "=";
-				code += _dump_node_code(anode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
+				code += _dump_node_code(p_context, anode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
 			}
 
 			if (anode->name == time_name) {
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
+				if (p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_FRAGMENT) {
+				if (p_actions.entry_point_stages.has(p_context.current_func_name) && p_actions.entry_point_stages[p_context.current_func_name] == STAGE_FRAGMENT) {
 					r_gen_code.uses_fragment_time = true;
 				}
 			}
@@ -1143,7 +1143,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else {
 						code += "";
 					}
-					code += _dump_node_code(cnode->array_declarations[0].initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, cnode->array_declarations[0].initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				}
 				code += ")";
 			}
@@ -1164,14 +1164,14 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				case SL::OP_ASSIGN_BIT_AND:
 				case SL::OP_ASSIGN_BIT_OR:
 				case SL::OP_ASSIGN_BIT_XOR:
-					code = _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, true) + _opstr(onode->op) + _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code = _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, true) + _opstr(onode->op) + _dump_node_code(p_context, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					break;
 				case SL::OP_BIT_INVERT:
 				case SL::OP_NEGATE:
 				case SL::OP_NOT:
 				case SL::OP_DECREMENT:
 				case SL::OP_INCREMENT: {
-					const String node_code = _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					const String node_code = _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 
 					if (onode->op == SL::OP_NEGATE && node_code.begins_with("-")) { // To prevent writing unary minus twice.
 						code = node_code;
@@ -1182,7 +1182,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				} break;
 				case SL::OP_POST_DECREMENT:
 				case SL::OP_POST_INCREMENT:
-					code = _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + _opstr(onode->op);
+					code = _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + _opstr(onode->op);
 					break;
 				case SL::OP_CALL:
 				case SL::OP_STRUCT:
@@ -1193,9 +1193,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					const bool is_internal_func = internal_functions.has(vnode->name);
 
 					if (!is_internal_func) {
-						for (int i = 0; i < shader->vfunctions.size(); i++) {
-							if (shader->vfunctions[i].name == vnode->name) {
-								func = shader->vfunctions[i].function;
+						for (int i = 0; i < p_context.shader->vfunctions.size(); i++) {
+							if (p_context.shader->vfunctions[i].name == vnode->name) {
+								func = p_context.shader->vfunctions[i].function;
 								break;
 							}
 						}
@@ -1213,9 +1213,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else if (onode->op == SL::OP_CONSTRUCT) {
 						code += String(vnode->name);
 					} else {
-						if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
+						if (p_actions.usage_flag_pointers.has(vnode->name) && !p_context.used_flag_pointers.has(vnode->name)) {
 							*p_actions.usage_flag_pointers[vnode->name] = true;
-							used_flag_pointers.insert(vnode->name);
+							p_context.used_flag_pointers.insert(vnode->name);
 						}
 
 						if (is_internal_func) {
@@ -1281,7 +1281,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							}
 						}
 
-						String node_code = _dump_node_code(onode->arguments[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						String node_code = _dump_node_code(p_context, onode->arguments[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 						if (is_texture_func && i == 1) {
 							// If we're doing a texture lookup we need to check our texture argument
 							StringName texture_uniform;
@@ -1310,8 +1310,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								if (actions.custom_samplers.has(texture_uniform)) {
 									sampler_name = actions.custom_samplers[texture_uniform];
 								} else {
-									if (shader->uniforms.has(texture_uniform)) {
-										const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[texture_uniform];
+									if (p_context.shader->uniforms.has(texture_uniform)) {
+										const ShaderLanguage::ShaderNode::Uniform &u = p_context.shader->uniforms[texture_uniform];
 										if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 											is_screen_texture = true;
 										} else if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
@@ -1323,23 +1323,23 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 									} else {
 										bool found = false;
 
-										for (int j = 0; j < function->arguments.size(); j++) {
-											if (function->arguments[j].name == texture_uniform) {
-												if (function->arguments[j].tex_builtin_check) {
-													ERR_CONTINUE(!actions.custom_samplers.has(function->arguments[j].tex_builtin));
-													sampler_name = actions.custom_samplers[function->arguments[j].tex_builtin];
+										for (int j = 0; j < p_context.function->arguments.size(); j++) {
+											if (p_context.function->arguments[j].name == texture_uniform) {
+												if (p_context.function->arguments[j].tex_builtin_check) {
+													ERR_CONTINUE(!actions.custom_samplers.has(p_context.function->arguments[j].tex_builtin));
+													sampler_name = actions.custom_samplers[p_context.function->arguments[j].tex_builtin];
 													found = true;
 													break;
 												}
-												if (function->arguments[j].tex_argument_check) {
-													if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
+												if (p_context.function->arguments[j].tex_argument_check) {
+													if (p_context.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 														is_screen_texture = true;
-													} else if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
+													} else if (p_context.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
 														is_depth_texture = true;
-													} else if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_NORMAL_ROUGHNESS_TEXTURE) {
+													} else if (p_context.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_NORMAL_ROUGHNESS_TEXTURE) {
 														is_normal_roughness_texture = true;
 													}
-													sampler_name = _get_sampler_name(function->arguments[j].tex_argument_filter, function->arguments[j].tex_argument_repeat);
+													sampler_name = _get_sampler_name(p_context.function->arguments[j].tex_argument_filter, p_context.function->arguments[j].tex_argument_repeat);
 													found = true;
 													break;
 												}
@@ -1374,8 +1374,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							} else if (correct_texture_uniform && RS::get_singleton()->is_low_end()) {
 								// Texture function on low end hardware (i.e. OpenGL).
 
-								if (shader->uniforms.has(texture_uniform)) {
-									const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[texture_uniform];
+								if (p_context.shader->uniforms.has(texture_uniform)) {
+									const ShaderLanguage::ShaderNode::Uniform &u = p_context.shader->uniforms[texture_uniform];
 									if (actions.check_multiview_samplers) {
 										if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 											multiview_uv_needed = true;
@@ -1425,19 +1425,19 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					}
 				} break;
 				case SL::OP_INDEX: {
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "[";
-					code += _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "]";
 
 				} break;
 				case SL::OP_SELECT_IF: {
 					code += "(";
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "?";
-					code += _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += ":";
-					code += _dump_node_code(onode->arguments[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += ")";
 
 				} break;
@@ -1449,7 +1449,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					if (p_use_scope) {
 						code += "(";
 					}
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + " " + _opstr(onode->op) + " " + _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + " " + _opstr(onode->op) + " " + _dump_node_code(p_context, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					if (p_use_scope) {
 						code += ")";
 					}
@@ -1461,45 +1461,45 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 		case SL::Node::NODE_TYPE_CONTROL_FLOW: {
 			SL::ControlFlowNode *cfnode = (SL::ControlFlowNode *)p_node;
 			if (cfnode->flow_op == SL::FLOW_OP_IF) {
-				code += _mktab(p_level) + "if (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "if (" + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 				if (cfnode->blocks.size() == 2) {
 					code += _mktab(p_level) + "else\n";
-					code += _dump_node_code(cfnode->blocks[1], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(p_context, cfnode->blocks[1], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 				}
 			} else if (cfnode->flow_op == SL::FLOW_OP_SWITCH) {
-				code += _mktab(p_level) + "switch (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "switch (" + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_CASE) {
-				code += _mktab(p_level) + "case " + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ":\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "case " + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ":\n";
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_DEFAULT) {
 				code += _mktab(p_level) + "default:\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_DO) {
 				code += _mktab(p_level) + "do";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
-				code += _mktab(p_level) + "while (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ");";
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "while (" + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ");";
 			} else if (cfnode->flow_op == SL::FLOW_OP_WHILE) {
-				code += _mktab(p_level) + "while (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "while (" + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(p_context, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_FOR) {
-				String left = _dump_node_code(cfnode->blocks[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
-				String middle = _dump_node_code(cfnode->blocks[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
-				String right = _dump_node_code(cfnode->blocks[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String left = _dump_node_code(p_context, cfnode->blocks[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String middle = _dump_node_code(p_context, cfnode->blocks[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String right = _dump_node_code(p_context, cfnode->blocks[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += _mktab(p_level) + "for (" + left + ";" + middle + ";" + right + ")\n";
-				code += _dump_node_code(cfnode->blocks[3], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(p_context, cfnode->blocks[3], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 
 			} else if (cfnode->flow_op == SL::FLOW_OP_RETURN) {
 				if (cfnode->expressions.size()) {
-					code = "return " + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ";";
+					code = "return " + _dump_node_code(p_context, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ";";
 				} else {
 					code = "return;";
 				}
 			} else if (cfnode->flow_op == SL::FLOW_OP_DISCARD) {
-				if (p_actions.usage_flag_pointers.has("DISCARD") && !used_flag_pointers.has("DISCARD")) {
+				if (p_actions.usage_flag_pointers.has("DISCARD") && !p_context.used_flag_pointers.has("DISCARD")) {
 					*p_actions.usage_flag_pointers["DISCARD"] = true;
-					used_flag_pointers.insert("DISCARD");
+					p_context.used_flag_pointers.insert("DISCARD");
 				}
 
 				code = "discard;";
@@ -1518,17 +1518,17 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			} else {
 				name = mnode->name;
 			}
-			code = _dump_node_code(mnode->owner, p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + "." + name;
+			code = _dump_node_code(p_context, mnode->owner, p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + "." + name;
 			if (mnode->index_expression != nullptr) {
 				code += "[";
-				code += _dump_node_code(mnode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(p_context, mnode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += "]";
 			} else if (mnode->assign_expression != nullptr) {
 				code += "=";
-				code += _dump_node_code(mnode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
+				code += _dump_node_code(p_context, mnode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
 			} else if (mnode->call_expression != nullptr) {
 				code += ".";
-				code += _dump_node_code(mnode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
+				code += _dump_node_code(p_context, mnode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
 			}
 		} break;
 	}
@@ -1542,6 +1542,11 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 }
 
 Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	CompileContext context;
+	return _compile(context, p_mode, p_code, p_actions, p_path, r_gen_code);
+}
+
+Error ShaderCompiler::_compile(CompileContext &p_context, RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1550,10 +1555,10 @@ Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, Iden
 	info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
 	info.base_varying_index = actions.base_varying_index;
 
-	Error err = parser.compile(p_code, info);
+	Error err = p_context.parser.compile(p_code, info);
 
 	if (err != OK) {
-		Vector<ShaderLanguage::FilePosition> include_positions = parser.get_include_positions();
+		Vector<ShaderLanguage::FilePosition> include_positions = p_context.parser.get_include_positions();
 
 		String current;
 		HashMap<String, Vector<String>> includes;
@@ -1625,10 +1630,10 @@ Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, Iden
 			line = include_positions[include_positions.size() - 1].line;
 		} else {
 			file = p_path;
-			line = parser.get_error_line();
+			line = p_context.parser.get_error_line();
 		}
 
-		_err_print_error(nullptr, file.utf8().get_data(), line, parser.get_error_text().utf8().get_data(), false, ERR_HANDLER_SHADER);
+		_err_print_error(nullptr, file.utf8().get_data(), line, p_context.parser.get_error_text().utf8().get_data(), false, ERR_HANDLER_SHADER);
 		return err;
 	}
 
@@ -1645,15 +1650,15 @@ Error ShaderCompiler::compile(RSE::ShaderMode p_mode, const String &p_code, Iden
 	r_gen_code.uses_depth_texture = false;
 	r_gen_code.uses_normal_roughness_texture = false;
 
-	used_name_defines.clear();
-	used_rmode_defines.clear();
-	used_flag_pointers.clear();
-	fragment_varyings.clear();
+	p_context.used_name_defines.clear();
+	p_context.used_rmode_defines.clear();
+	p_context.used_flag_pointers.clear();
+	p_context.fragment_varyings.clear();
 
-	shader = parser.get_shader();
-	function = nullptr;
+	p_context.shader = p_context.parser.get_shader();
+	p_context.function = nullptr;
 	// Return value only relevant within nested calls.
-	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_ALLOW_DISCARD_ _dump_node_code(p_context, p_context.shader, 1, r_gen_code, *p_actions, actions, false);
 
 	return OK;
 }
@@ -110,30 +110,37 @@ public:
 	};
 
 private:
-	ShaderLanguage parser;
+	// Mutable state of a single compilation, so compile() can run concurrently
+	// while the tables filled by initialize() are shared read-only.
+	struct CompileContext {
+		ShaderLanguage parser;
+		const ShaderLanguage::ShaderNode *shader = nullptr;
+		const ShaderLanguage::FunctionNode *function = nullptr;
+		StringName current_func_name;
+
+		HashSet<StringName> used_name_defines;
+		HashSet<StringName> used_flag_pointers;
+		HashSet<StringName> used_rmode_defines;
+		HashSet<StringName> fragment_varyings;
+	};
 
 	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
 
 	void _dump_function_deps(const ShaderLanguage::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added);
-	String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
+	String _dump_node_code(CompileContext &p_context, const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
 
-	const ShaderLanguage::ShaderNode *shader = nullptr;
-	const ShaderLanguage::FunctionNode *function = nullptr;
-	StringName current_func_name;
 	StringName time_name;
 	HashSet<StringName> texture_functions;
-
-	HashSet<StringName> used_name_defines;
-	HashSet<StringName> used_flag_pointers;
-	HashSet<StringName> used_rmode_defines;
 	HashSet<StringName> internal_functions;
-	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	Error _compile(CompileContext &p_context, RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+
 public:
+	// Can be called from several threads at once, each compilation uses its own parser and state.
 	Error compile(RSE::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
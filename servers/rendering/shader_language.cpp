@@ -738,21 +738,22 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 						CASE_MAX,
 					} lut_case = CASE_ALL;
 
-					static bool suffix_lut[CASE_MAX][127];
-
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
-
-						for (int i = 0; i < 127; i++) {
-							char t = char(i);
-
-							suffix_lut[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
-							suffix_lut[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
-							suffix_lut[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
-							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
-							suffix_lut[CASE_NONE][i] = false;
+					// Initialized once in a thread-safe way, shaders can be parsed on several threads at once.
+					static const struct SuffixLUT {
+						bool table[CASE_MAX][127];
+
+						SuffixLUT() {
+							for (int i = 0; i < 127; i++) {
+								char t = char(i);
+
+								table[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
+								table[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
+								table[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
+								table[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
+								table[CASE_NONE][i] = false;
+							}
 						}
-					}
+					} suffix_lut;
 
 					String str;
 					int i = 0;
@@ -770,7 +771,7 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 								error = true;
 							}
 						} else {
-							if (symbol < 0x7F && suffix_lut[lut_case][symbol]) {
+							if (symbol < 0x7F && suffix_lut.table[lut_case][symbol]) {
 								if (symbol == 'x') {
 									hexa_found = true;
 									lut_case = CASE_HEXA_PERIOD;
@@ -3568,6 +3569,7 @@ const ShaderLanguage::BuiltinFuncDef ShaderLanguage::builtin_func_defs[] = {
 };
 
 HashSet<StringName> global_func_set;
+Mutex global_func_set_mutex;
 
 const ShaderLanguage::BuiltinFuncOutArgs ShaderLanguage::builtin_func_out_args[] = {
 	{ "modf", { 1, -1 } },
@@ -3618,8 +3620,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::builtin_vectorized_constructo
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
-
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
 
@@ -12328,16 +12328,20 @@ ShaderLanguage::ShaderLanguage() {
 	nodes = nullptr;
 	completion_class = TAG_GLOBAL;
 
-	if (instance_counter.get() == 0) {
-		int idx = 0;
-		while (builtin_func_defs[idx].name) {
-			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
-				global_func_set.insert(builtin_func_defs[idx].name);
+	{
+		// Instances can be created and destroyed on several threads at once.
+		MutexLock lock(global_func_set_mutex);
+		if (instance_counter.get() == 0) {
+			int idx = 0;
+			while (builtin_func_defs[idx].name) {
+				if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
+					global_func_set.insert(builtin_func_defs[idx].name);
+				}
+				idx++;
 			}
-			idx++;
 		}
+		instance_counter.increment();
 	}
-	instance_counter.increment();
 
 #ifdef DEBUG_ENABLED
 	warnings_check_map.insert(ShaderWarning::UNUSED_CONSTANT, &used_constants);
@@ -12352,6 +12356,8 @@ ShaderLanguage::ShaderLanguage() {
 
 ShaderLanguage::~ShaderLanguage() {
 	clear();
+
+	MutexLock lock(global_func_set_mutex);
 	instance_counter.decrement();
 	if (instance_counter.get() == 0) {
 		global_func_set.clear();
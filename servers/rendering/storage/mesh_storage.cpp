@@ -236,7 +236,9 @@ void RendererMeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<flo
 	if (mmi && mmi->interpolated) {
 		ERR_FAIL_COND_MSG(p_buffer.size() != mmi->_data_curr.size(), "Buffer should have " + itos(mmi->_data_curr.size()) + " elements, got " + itos(p_buffer.size()) + " instead.");
 
-		mmi->_data_curr = p_buffer;
+		// Copy into the buffer we already own rather than sharing the caller's,
+		// which would be forked by the next per-instance write.
+		memcpy(mmi->_data_curr.ptrw(), p_buffer.ptr(), p_buffer.size() * sizeof(float));
 		_multimesh_add_to_interpolation_lists(p_multimesh, *mmi);
 
 #if defined(DEBUG_ENABLED) && defined(TOOLS_ENABLED)
@@ -271,8 +273,8 @@ void RendererMeshStorage::multimesh_set_buffer_interpolated(RID p_multimesh, con
 
 		// We are assuming that mmi->interpolated is the case. (Can possibly assert this?)
 		// Even if this flag hasn't been set - just calling this function suggests interpolation is desired.
-		mmi->_data_prev = p_buffer_prev;
-		mmi->_data_curr = p_buffer;
+		memcpy(mmi->_data_prev.ptrw(), p_buffer_prev.ptr(), p_buffer_prev.size() * sizeof(float));
+		memcpy(mmi->_data_curr.ptrw(), p_buffer.ptr(), p_buffer.size() * sizeof(float));
 		_multimesh_add_to_interpolation_lists(p_multimesh, *mmi);
 
 #if defined(DEBUG_ENABLED) && defined(TOOLS_ENABLED)
@@ -349,6 +351,60 @@ AABB RendererMeshStorage::multimesh_get_aabb(RID p_multimesh) {
 	return _multimesh_get_aabb(p_multimesh);
 }
 
+void RendererMeshStorage::_multimesh_compute_chunk_aabbs(const float *p_data, uint32_t p_stride, uint32_t p_instances, const AABB &p_mesh_aabb, LocalVector<AABB> &r_chunk_aabbs) {
+	r_chunk_aabbs.resize(Math::division_round_up(p_instances, MULTIMESH_CULL_CHUNK_SIZE));
+
+	for (uint32_t i = 0; i < p_instances; i++) {
+		const float *data = p_data + p_stride * i;
+		Transform3D t;
+
+		t.basis.rows[0][0] = data[0];
+		t.basis.rows[0][1] = data[1];
+		t.basis.rows[0][2] = data[2];
+		t.origin.x = data[3];
+		t.basis.rows[1][0] = data[4];
+		t.basis.rows[1][1] = data[5];
+		t.basis.rows[1][2] = data[6];
+		t.origin.y = data[7];
+		t.basis.rows[2][0] = data[8];
+		t.basis.rows[2][1] = data[9];
+		t.basis.rows[2][2] = data[10];
+		t.origin.z = data[11];
+
+		AABB &chunk_aabb = r_chunk_aabbs[i / MULTIMESH_CULL_CHUNK_SIZE];
+		if (i % MULTIMESH_CULL_CHUNK_SIZE == 0) {
+			chunk_aabb = t.xform(p_mesh_aabb);
+		} else {
+			chunk_aabb.merge_with(t.xform(p_mesh_aabb));
+		}
+	}
+}
+
+void RendererMeshStorage::_multimesh_cull_chunk_aabbs(const LocalVector<AABB> &p_chunk_aabbs, const Transform3D &p_transform, const Vector<Plane> &p_planes, LocalVector<uint8_t> &r_chunk_visible) {
+	// Bring the planes to the local space of the multimesh, so chunk AABBs don't need to be transformed.
+	LocalVector<Plane> planes;
+	planes.resize(p_planes.size());
+	for (int i = 0; i < p_planes.size(); i++) {
+		planes[i] = p_transform.xform_inv(p_planes[i]);
+	}
+
+	for (uint32_t i = 0; i < p_chunk_aabbs.size(); i++) {
+		if (r_chunk_visible[i]) {
+			continue; // Already visible from another instance of the multimesh.
+		}
+
+		bool visible = true;
+		for (const Plane &plane : planes) {
+			if (plane.distance_to(p_chunk_aabbs[i].get_support(-plane.normal)) > 0) {
+				visible = false;
+				break;
+			}
+		}
+
+		r_chunk_visible[i] = visible;
+	}
+}
+
 void RendererMeshStorage::_multimesh_add_to_interpolation_lists(RID p_multimesh, MultiMeshInterpolator &r_mmi) {
 	if (!r_mmi.on_interpolate_update_list) {
 		r_mmi.on_interpolate_update_list = true;
@@ -32,6 +32,7 @@
 
 #include "core/math/color.h"
 #include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
 #include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_server_enums.h"
 #include "servers/rendering/rendering_server_types.h"
@@ -168,6 +169,16 @@ public:
 
 	virtual AABB multimesh_get_aabb(RID p_multimesh);
 
+	// Chunk culling: only the chunks of a 3D multimesh that intersect p_planes (in world space) are kept
+	// in the instance buffer until the next update_multimesh_chunks(). Multimeshes that were culled before
+	// but not in the current pass are restored to their full buffer by update_multimesh_chunks().
+	// The culled buffer is used by every instance and pass that draws the multimesh, so callers must
+	// only cull multimeshes that nothing else draws before the next update_multimesh_chunks().
+	// Storages that don't implement it keep drawing full buffers, so the scene cull skips the chunk tests.
+	virtual bool multimesh_has_chunk_culling() const { return false; }
+	virtual void multimesh_cull_chunks(RID p_multimesh, const Transform3D &p_transform, const Vector<Plane> &p_planes) = 0;
+	virtual void update_multimesh_chunks() = 0;
+
 	virtual RID _multimesh_allocate() = 0;
 	virtual void _multimesh_initialize(RID p_rid) = 0;
 	virtual void _multimesh_free(RID p_rid) = 0;
@@ -206,6 +217,13 @@ public:
 	// This allows shared functionality for interpolation across backends.
 	virtual MultiMeshInterpolator *_multimesh_get_interpolator(RID p_multimesh) const = 0;
 
+protected:
+	// Consecutive instances are grouped in chunks of this size for chunk culling.
+	static constexpr uint32_t MULTIMESH_CULL_CHUNK_SIZE = 256;
+
+	static void _multimesh_compute_chunk_aabbs(const float *p_data, uint32_t p_stride, uint32_t p_instances, const AABB &p_mesh_aabb, LocalVector<AABB> &r_chunk_aabbs);
+	static void _multimesh_cull_chunk_aabbs(const LocalVector<AABB> &p_chunk_aabbs, const Transform3D &p_transform, const Vector<Plane> &p_planes, LocalVector<uint8_t> &r_chunk_visible);
+
 private:
 	void _multimesh_add_to_interpolation_lists(RID p_multimesh, MultiMeshInterpolator &r_mmi);
 
@@ -52,6 +52,7 @@ public:
 		DEPENDENCY_CHANGED_MESH,
 		DEPENDENCY_CHANGED_MULTIMESH,
 		DEPENDENCY_CHANGED_MULTIMESH_VISIBLE_INSTANCES,
+		DEPENDENCY_CHANGED_MULTIMESH_CULLED_INSTANCES,
 		DEPENDENCY_CHANGED_PARTICLES,
 		DEPENDENCY_CHANGED_PARTICLES_INSTANCES,
 		DEPENDENCY_CHANGED_DECAL,
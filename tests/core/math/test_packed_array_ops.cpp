@@ -0,0 +1,250 @@
+/**************************************************************************/
+/*  test_packed_array_ops.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_packed_array_ops)
+
+#include "core/math/packed_array_ops.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+
+namespace TestPackedArrayOps {
+
+// Sizes that are not multiples of the lane count exercise the scalar tails.
+static const int64_t test_sizes[] = { 0, 1, 3, 4, 7, 33 };
+
+template <typename T>
+static void check_elementwise_kernels() {
+	for (int64_t size : test_sizes) {
+		LocalVector<T> a;
+		LocalVector<T> b;
+		for (int64_t i = 0; i < size; i++) {
+			a.push_back(T(i * 3 - 20));
+			b.push_back(T(17 - i * 2));
+		}
+		LocalVector<T> dst;
+		dst.resize(size);
+
+		PackedArrayOps::add(a.ptr(), b.ptr(), dst.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(dst[i], T(a[i] + b[i]));
+		}
+		PackedArrayOps::multiply(a.ptr(), b.ptr(), dst.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(dst[i], T(a[i] * b[i]));
+		}
+		PackedArrayOps::min(a.ptr(), b.ptr(), dst.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(dst[i], MIN(a[i], b[i]));
+		}
+		PackedArrayOps::max(a.ptr(), b.ptr(), dst.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(dst[i], MAX(a[i], b[i]));
+		}
+
+		LocalVector<uint8_t> mask;
+		mask.resize(size);
+		PackedArrayOps::greater(a.ptr(), T(0), mask.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(mask[i], a[i] > T(0) ? 1 : 0);
+		}
+		PackedArrayOps::less(a.ptr(), T(0), mask.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK_EQ(mask[i], a[i] < T(0) ? 1 : 0);
+		}
+
+		PackedArrayOps::Accumulator<T> expected_sum = 0;
+		PackedArrayOps::Accumulator<T> expected_dot = 0;
+		for (int64_t i = 0; i < size; i++) {
+			expected_sum += a[i];
+			expected_dot += PackedArrayOps::Accumulator<T>(a[i]) * b[i];
+		}
+		CHECK_EQ(PackedArrayOps::sum(a.ptr(), size), expected_sum);
+		CHECK_EQ(PackedArrayOps::dot(a.ptr(), b.ptr(), size), expected_dot);
+	}
+}
+
+TEST_CASE("[PackedArrayOps] Element-wise kernels") {
+	check_elementwise_kernels<int32_t>();
+	check_elementwise_kernels<int64_t>();
+	check_elementwise_kernels<float>();
+	check_elementwise_kernels<double>();
+}
+
+TEST_CASE("[PackedArrayOps] Integer overflow and accumulation") {
+	const int32_t a[] = { INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX };
+	const int32_t b[] = { 1, 2, 3, 4, 5 };
+	int32_t dst[5];
+	PackedArrayOps::add(a, b, dst, 5);
+	CHECK_EQ(dst[0], INT32_MIN);
+	CHECK_EQ(dst[4], INT32_MIN + 4);
+
+	// Sums of 32-bit integers don't overflow.
+	CHECK_EQ(PackedArrayOps::sum(a, 5), int64_t(INT32_MAX) * 5);
+	CHECK_EQ(PackedArrayOps::dot(a, b, 5), int64_t(INT32_MAX) * 15);
+}
+
+TEST_CASE("[PackedArrayOps] Comparisons against values outside the element range") {
+	const int32_t ints[] = { INT32_MIN, -1, 0, 1, INT32_MAX };
+	uint8_t mask[5];
+	// Truncated to 32 bits, this would be -1294967296.
+	PackedArrayOps::greater(ints, int64_t(3000000000), mask, 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(mask[i], 0);
+	}
+	PackedArrayOps::less(ints, int64_t(-3000000000), mask, 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(mask[i], 0);
+	}
+
+	// 0.1 is not exactly representable, and float(0.1) is greater than 0.1.
+	const float floats[] = { 0.1f, 0.1f, 0.1f, 0.1f, 0.1f };
+	PackedArrayOps::greater(floats, 0.1, mask, 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(mask[i], 1);
+	}
+	PackedArrayOps::less(floats, 0.1, mask, 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(mask[i], 0);
+	}
+	PackedArrayOps::less(floats, 1e300, mask, 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(mask[i], 1);
+	}
+}
+
+TEST_CASE("[PackedArrayOps] NaN handling matches between lanes and tail") {
+	// The first four elements go through the vector kernel, the fifth through the scalar tail.
+	const float a[] = { Math::NaN, 1.0f, Math::NaN, 2.0f, Math::NaN };
+	const float b[] = { 1.0f, Math::NaN, 3.0f, 0.0f, 5.0f };
+	float dst[5];
+
+	PackedArrayOps::min(a, b, dst, 5);
+	CHECK_EQ(dst[0], 1.0f);
+	CHECK(Math::is_nan(dst[1]));
+	CHECK_EQ(dst[2], 3.0f);
+	CHECK_EQ(dst[3], 0.0f);
+	CHECK_EQ(dst[4], 5.0f);
+
+	PackedArrayOps::max(a, b, dst, 5);
+	CHECK_EQ(dst[0], 1.0f);
+	CHECK(Math::is_nan(dst[1]));
+	CHECK_EQ(dst[2], 3.0f);
+	CHECK_EQ(dst[3], 2.0f);
+	CHECK_EQ(dst[4], 5.0f);
+
+	uint8_t mask[5];
+	PackedArrayOps::greater(a, 0.0f, mask, 5);
+	CHECK_EQ(mask[0], 0);
+	CHECK_EQ(mask[1], 1);
+	CHECK_EQ(mask[4], 0);
+}
+
+TEST_CASE("[PackedArrayOps] Bound packed array methods") {
+	PackedFloat32Array a = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+	PackedFloat32Array b = { 5.0f, 4.0f, 3.0f, 2.0f, 1.0f };
+	Variant va = a;
+	Callable::CallError ce;
+
+	const Variant arg_b = b;
+	const Variant *args[] = { &arg_b };
+	Variant ret;
+	va.callp("elementwise_add", args, 1, ret, ce);
+	CHECK_EQ(ce.error, Callable::CallError::CALL_OK);
+	CHECK_EQ(PackedFloat32Array(ret), PackedFloat32Array({ 6.0f, 6.0f, 6.0f, 6.0f, 6.0f }));
+
+	va.callp("dot", args, 1, ret, ce);
+	CHECK_EQ(ret.get_type(), Variant::FLOAT);
+	CHECK_EQ(double(ret), 35.0);
+
+	va.callp("sum", nullptr, 0, ret, ce);
+	CHECK_EQ(double(ret), 15.0);
+
+	const Variant arg_value = 2.5;
+	const Variant *value_args[] = { &arg_value };
+	va.callp("elementwise_greater", value_args, 1, ret, ce);
+	CHECK_EQ(PackedByteArray(ret), PackedByteArray({ 0, 0, 1, 1, 1 }));
+
+	Variant vi = PackedInt32Array({ 1, -2, 3 });
+	vi.callp("sum", nullptr, 0, ret, ce);
+	CHECK_EQ(ret.get_type(), Variant::INT);
+	CHECK_EQ(int64_t(ret), 2);
+
+	ERR_PRINT_OFF;
+	const Variant arg_short = PackedFloat32Array({ 1.0f });
+	const Variant *short_args[] = { &arg_short };
+	va.callp("elementwise_multiply", short_args, 1, ret, ce);
+	ERR_PRINT_ON;
+	CHECK(PackedFloat32Array(ret).is_empty());
+}
+
+TEST_CASE("[PackedArrayOps][Benchmark] Bulk methods compared to per-element Variant evaluation") {
+	constexpr int64_t SIZE = 100000;
+	PackedFloat32Array a;
+	PackedFloat32Array b;
+	a.resize(SIZE);
+	b.resize(SIZE);
+	for (int64_t i = 0; i < SIZE; i++) {
+		a.set(i, float(i % 1000) * 0.5f);
+		b.set(i, float(i % 7) - 3.0f);
+	}
+
+	// What a script does without the bulk methods: one Variant operator dispatch per element.
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	PackedFloat32Array looped;
+	looped.resize(SIZE);
+	Variant looped_sum = 0.0;
+	for (int64_t i = 0; i < SIZE; i++) {
+		bool valid = true;
+		Variant product;
+		Variant::evaluate(Variant::OP_MULTIPLY, a[i], b[i], product, valid);
+		looped.set(i, product);
+		Variant::evaluate(Variant::OP_ADD, looped_sum, product, looped_sum, valid);
+	}
+	const uint64_t looped_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	Variant va = a;
+	const Variant arg_b = b;
+	const Variant *args[] = { &arg_b };
+	Variant bulk;
+	Variant bulk_sum;
+	Callable::CallError ce;
+	va.callp("elementwise_multiply", args, 1, bulk, ce);
+	va.callp("dot", args, 1, bulk_sum, ce);
+	const uint64_t bulk_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	CHECK_EQ(PackedFloat32Array(bulk), looped);
+	CHECK(Math::is_equal_approx(double(bulk_sum), double(looped_sum)));
+	MESSAGE(vformat("Multiply and dot over %d floats: %d usec with per-element operators, %d usec with bulk methods.", SIZE, looped_usec, bulk_usec));
+}
+
+} // namespace TestPackedArrayOps
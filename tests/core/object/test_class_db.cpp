@@ -886,6 +886,51 @@ TEST_SUITE("[ClassDB]") {
 			}
 		}
 	}
+
+	TEST_CASE("[ClassDB] Frozen inheritance checks match unfrozen ones") {
+		const bool was_frozen = ClassDB::is_frozen();
+		ClassDB::unfreeze();
+		CHECK_FALSE(ClassDB::is_frozen());
+
+		LocalVector<StringName> classes;
+		ClassDB::get_class_list(classes);
+		LocalVector<StringName> bases;
+		for (uint32_t i = 0; i < classes.size(); i += 25) {
+			bases.push_back(classes[i]);
+		}
+		bases.push_back("Object");
+		bases.push_back("RefCounted");
+
+		LocalVector<bool> expected;
+		for (const StringName &name : classes) {
+			for (const StringName &base : bases) {
+				expected.push_back(ClassDB::is_parent_class(name, base));
+			}
+		}
+
+		ClassDB::freeze();
+		CHECK(ClassDB::is_frozen());
+
+		bool all_match = true;
+		uint32_t idx = 0;
+		for (const StringName &name : classes) {
+			for (const StringName &base : bases) {
+				all_match = all_match && ClassDB::is_parent_class(name, base) == expected[idx++];
+			}
+		}
+		CHECK_MESSAGE(all_match, "Inheritance ranges should give the same results as walking the hierarchy.");
+		CHECK(ClassDB::is_parent_class("RefCounted", "Object"));
+		CHECK_FALSE(ClassDB::is_parent_class("Object", "RefCounted"));
+
+		// Writes thaw the table and freeze it again once done.
+		ClassDB::set_class_enabled("Object", ClassDB::is_class_enabled("Object"));
+		CHECK(ClassDB::is_frozen());
+		CHECK(ClassDB::class_exists("Object"));
+
+		if (!was_frozen) {
+			ClassDB::unfreeze();
+		}
+	}
 }
 
 } // namespace TestClassDB
@@ -36,6 +36,9 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "tests/signal_watcher.h"
 
 namespace TestObject {
@@ -514,6 +517,86 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalCounter : public Object {
+	GDCLASS(SignalCounter, Object);
+
+public:
+	uint32_t calls = 0;
+	Object *source = nullptr;
+	SignalCounter *to_disconnect = nullptr;
+	SignalCounter *to_connect = nullptr;
+
+	void count() {
+		calls++;
+	}
+
+	void count_and_reconnect() {
+		calls++;
+		if (to_disconnect) {
+			source->disconnect("counted", callable_mp(to_disconnect, &SignalCounter::count));
+			to_disconnect = nullptr;
+		}
+		if (to_connect) {
+			source->connect("counted", callable_mp(to_connect, &SignalCounter::count));
+			to_connect = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[Object] Connections changed during emission don't affect it") {
+	Object source;
+	source.add_user_signal(MethodInfo("counted"));
+	SignalCounter first;
+	SignalCounter second;
+	SignalCounter third;
+
+	first.source = &source;
+	first.to_disconnect = &second;
+	first.to_connect = &third;
+	source.connect("counted", callable_mp(&first, &SignalCounter::count_and_reconnect));
+	source.connect("counted", callable_mp(&second, &SignalCounter::count));
+
+	source.emit_signal("counted");
+	CHECK(first.calls == 1);
+	CHECK_MESSAGE(second.calls == 1, "Slots disconnected mid-emission are still called by it.");
+	CHECK_MESSAGE(third.calls == 0, "Slots connected mid-emission are only called by later emissions.");
+
+	source.emit_signal("counted");
+	CHECK(first.calls == 2);
+	CHECK(second.calls == 1);
+	CHECK(third.calls == 1);
+}
+
+TEST_CASE("[Object][Benchmark] Signal emission") {
+	const uint32_t connection_counts[] = { 0, 1, 8, 64 };
+	constexpr uint32_t EMISSIONS = 20000;
+
+	for (uint32_t connection_count : connection_counts) {
+		Object source;
+		source.add_user_signal(MethodInfo("counted"));
+		LocalVector<SignalCounter *> counters;
+		for (uint32_t i = 0; i < connection_count; i++) {
+			counters.push_back(memnew(SignalCounter));
+			source.connect("counted", callable_mp(counters[i], &SignalCounter::count));
+		}
+
+		const StringName signal_name = "counted";
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < EMISSIONS; i++) {
+			source.emit_signal(signal_name);
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		bool all_called = true;
+		for (SignalCounter *counter : counters) {
+			all_called = all_called && counter->calls == EMISSIONS;
+			memdelete(counter);
+		}
+		CHECK(all_called);
+		MESSAGE(vformat("%d emissions with %d connections took %d usec.", EMISSIONS, connection_count, elapsed));
+	}
+}
+
 class NotificationObjectSuperclass : public Object {
 	GDCLASS(NotificationObjectSuperclass, Object);
 
@@ -691,4 +774,75 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+// Looks up live and stale IDs from several threads while objects are being created and freed,
+// and reports lookup throughput with one thread and with one thread per core.
+TEST_CASE("[ObjectDB] Concurrent lookups") {
+	static const uint32_t OBJECT_COUNT = 256;
+	static const uint32_t LOOKUPS_PER_THREAD = 200000;
+
+	struct LookupTester {
+		LocalVector<Object *> objects;
+		LocalVector<ObjectID> stale_ids;
+		SafeNumeric<uint32_t> errors;
+		SafeNumeric<uint32_t> finished_threads;
+
+		static void thread_func(void *p_data) {
+			LookupTester *tester = (LookupTester *)p_data;
+			for (uint32_t i = 0; i < LOOKUPS_PER_THREAD; i++) {
+				const uint32_t idx = i % OBJECT_COUNT;
+				Object *object = tester->objects[idx];
+				if (ObjectDB::get_instance(object->get_instance_id()) != object) {
+					tester->errors.increment();
+				}
+				if (ObjectDB::get_instance(tester->stale_ids[idx]) != nullptr) {
+					tester->errors.increment();
+				}
+			}
+			tester->finished_threads.increment();
+		}
+
+		uint64_t run(uint32_t p_thread_count) {
+			TightLocalVector<Thread> threads;
+			threads.resize(p_thread_count);
+			finished_threads.set(0);
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].start(thread_func, this);
+			}
+			// Allocate and release slots while the lookups run.
+			while (finished_threads.get() < p_thread_count) {
+				Object *temp = memnew(Object);
+				memdelete(temp);
+			}
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].wait_to_finish();
+			}
+			return MAX<uint64_t>(1, OS::get_singleton()->get_ticks_usec() - begin);
+		}
+	};
+
+	LookupTester tester;
+	for (uint32_t i = 0; i < OBJECT_COUNT; i++) {
+		tester.objects.push_back(memnew(Object));
+		Object *stale = memnew(Object);
+		tester.stale_ids.push_back(stale->get_instance_id());
+		memdelete(stale);
+	}
+
+	const uint32_t thread_count = MAX(2, OS::get_singleton()->get_processor_count());
+	const uint64_t single_usec = tester.run(1);
+	const uint64_t multi_usec = tester.run(thread_count);
+
+	MESSAGE(vformat("1 thread: %d lookups/usec, %d threads: %d lookups/usec.",
+			uint64_t(LOOKUPS_PER_THREAD) * 2 / single_usec,
+			thread_count,
+			uint64_t(LOOKUPS_PER_THREAD) * 2 * thread_count / multi_usec));
+	CHECK_MESSAGE(tester.errors.get() == 0, "Lookups should always resolve live objects and never resolve freed ones.");
+
+	for (Object *object : tester.objects) {
+		memdelete(object);
+	}
+}
+
 } // namespace TestObject
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_small_object_allocator.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_small_object_allocator)
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+#include "core/os/small_object_allocator.h"
+#include "core/os/thread.h"
+
+namespace TestSmallObjectAllocator {
+
+TEST_CASE("[SmallObjectAllocator] Blocks fit their size and are owned") {
+	for (size_t size = 1; size <= SmallObjectAllocator::MAX_SIZE; size++) {
+		void *block = SmallObjectAllocator::alloc(size, false);
+		REQUIRE(block != nullptr);
+		CHECK(SmallObjectAllocator::owns(block));
+		CHECK(SmallObjectAllocator::get_block_size(block) >= size);
+		CHECK((reinterpret_cast<uintptr_t>(block) % 16) == 0);
+		SmallObjectAllocator::free(block);
+	}
+
+	CHECK(SmallObjectAllocator::alloc(SmallObjectAllocator::MAX_SIZE + 1, false) == nullptr);
+
+	int on_stack = 0;
+	CHECK_FALSE(SmallObjectAllocator::owns(&on_stack));
+	CHECK(SmallObjectAllocator::get_reserved_bytes() > 0);
+}
+
+TEST_CASE("[SmallObjectAllocator] Zeroed allocations") {
+	uint8_t *block = static_cast<uint8_t *>(SmallObjectAllocator::alloc(100, false));
+	REQUIRE(block != nullptr);
+	memset(block, 0xAB, SmallObjectAllocator::get_block_size(block));
+	SmallObjectAllocator::free(block);
+
+	// Usually hands out the block that was just freed, so its old contents must be cleared.
+	uint8_t *zeroed = static_cast<uint8_t *>(SmallObjectAllocator::alloc(100, true));
+	REQUIRE(zeroed != nullptr);
+	bool all_zero = true;
+	for (size_t i = 0; i < SmallObjectAllocator::get_block_size(zeroed); i++) {
+		all_zero = all_zero && zeroed[i] == 0;
+	}
+	CHECK(all_zero);
+	SmallObjectAllocator::free(zeroed);
+}
+
+TEST_CASE("[SmallObjectAllocator] Memory::alloc_static uses it for small blocks") {
+	void *small = Memory::alloc_static(64);
+	void *large = Memory::alloc_static(SmallObjectAllocator::MAX_SIZE * 4);
+	CHECK(SmallObjectAllocator::owns(small));
+	CHECK_FALSE(SmallObjectAllocator::owns(large));
+
+	// Growing past the block size moves the data out of the allocator.
+	memset(small, 0x5A, 64);
+	small = Memory::realloc_static(small, SmallObjectAllocator::MAX_SIZE * 2);
+	CHECK_FALSE(SmallObjectAllocator::owns(small));
+	CHECK(static_cast<uint8_t *>(small)[63] == 0x5A);
+
+	Memory::free_static(small);
+	Memory::free_static(large);
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[SmallObjectAllocator] Blocks cached by exited threads are reused") {
+	static constexpr uint32_t BLOCK_COUNT = 4096;
+	static constexpr size_t BLOCK_SIZE = SmallObjectAllocator::MAX_SIZE;
+	const uint32_t size_class = SmallObjectAllocator::SIZE_CLASS_COUNT - 1;
+
+	LocalVector<void *> blocks;
+	blocks.resize(BLOCK_COUNT);
+
+	// Allocate on one thread and free on another, so both caches hold blocks of the same class when they exit.
+	Thread allocating_thread;
+	allocating_thread.start(
+			[](void *p_blocks) {
+				LocalVector<void *> &thread_blocks = *static_cast<LocalVector<void *> *>(p_blocks);
+				for (uint32_t i = 0; i < thread_blocks.size(); i++) {
+					thread_blocks[i] = SmallObjectAllocator::alloc(BLOCK_SIZE, false);
+				}
+			},
+			&blocks);
+	allocating_thread.wait_to_finish();
+
+	for (void *block : blocks) {
+		REQUIRE(block != nullptr);
+	}
+
+	Thread freeing_thread;
+	freeing_thread.start(
+			[](void *p_blocks) {
+				for (void *block : *static_cast<LocalVector<void *> *>(p_blocks)) {
+					SmallObjectAllocator::free(block);
+				}
+			},
+			&blocks);
+	freeing_thread.wait_to_finish();
+
+	const uint64_t page_count = SmallObjectAllocator::get_size_class_stats(size_class).page_count;
+	for (uint32_t i = 0; i < BLOCK_COUNT; i++) {
+		blocks[i] = SmallObjectAllocator::alloc(BLOCK_SIZE, false);
+	}
+	CHECK(SmallObjectAllocator::get_size_class_stats(size_class).page_count == page_count);
+
+	for (void *block : blocks) {
+		SmallObjectAllocator::free(block);
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestSmallObjectAllocator
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
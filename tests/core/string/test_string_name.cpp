@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = StringName("interned_name");
+	const StringName b = StringName(String("interned_name"));
+	const StringName c = StringName("other_name");
+
+	CHECK_MESSAGE(a == b, "StringNames created from equal strings should be equal.");
+	CHECK_MESSAGE(a.data_unique_pointer() == b.data_unique_pointer(), "StringNames created from equal strings should share their data.");
+	CHECK(a != c);
+	CHECK(a.hash() == String("interned_name").hash());
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Release and re-intern") {
+	{
+		const StringName a = StringName("transient_string_name");
+		CHECK(a == "transient_string_name");
+	}
+	// The entry was released above, so this has to be created again.
+	const StringName b = StringName("transient_string_name");
+	CHECK(b == "transient_string_name");
+	CHECK(b.length() == 21);
+}
+
+// Interns the same set of names from many threads at once, while also creating and
+// releasing names unique to each thread. Checks that every thread ends up with the same
+// interned data and reports how long it took, as a measure of table contention.
+TEST_CASE("[StringName] Concurrent interning") {
+	static const uint32_t NAME_COUNT = 1024;
+	static const uint32_t ROUNDS = 16;
+
+	struct InterningTester {
+		LocalVector<String> names;
+		TightLocalVector<Thread> threads;
+		TightLocalVector<LocalVector<StringName>> results;
+		SafeNumeric<uint32_t> next_thread_idx;
+
+		static void thread_func(void *p_data) {
+			InterningTester *tester = (InterningTester *)p_data;
+			const uint32_t thread_idx = tester->next_thread_idx.postincrement();
+			LocalVector<StringName> &result = tester->results[thread_idx];
+
+			for (uint32_t round = 0; round < ROUNDS; round++) {
+				result.clear();
+				for (uint32_t i = 0; i < NAME_COUNT; i++) {
+					result.push_back(StringName(tester->names[i]));
+					// Names only this thread uses are released right away, exercising removal.
+					const StringName unique = StringName(tester->names[i] + "_" + itos(thread_idx));
+				}
+			}
+		}
+
+		void test() {
+			for (uint32_t i = 0; i < NAME_COUNT; i++) {
+				names.push_back("concurrent_name_" + itos(i));
+			}
+
+			threads.resize(MAX(2, OS::get_singleton()->get_processor_count()));
+			results.resize(threads.size());
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].start(thread_func, this);
+			}
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].wait_to_finish();
+			}
+			const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+			MESSAGE(vformat("%d threads interned %d names in %d usec.", threads.size(), threads.size() * NAME_COUNT * ROUNDS * 2, elapsed));
+
+			bool all_equal = true;
+			for (uint32_t i = 0; i < NAME_COUNT; i++) {
+				for (uint32_t j = 1; j < threads.size(); j++) {
+					all_equal = all_equal && results[j][i].data_unique_pointer() == results[0][i].data_unique_pointer();
+				}
+				all_equal = all_equal && results[0][i] == names[i];
+			}
+			CHECK_MESSAGE(all_equal, "All threads should have interned the same names to the same data.");
+		}
+	};
+
+	InterningTester tester;
+	tester.test();
+}
+
+} // namespace TestStringName
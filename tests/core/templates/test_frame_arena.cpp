@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_frame_arena.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_frame_arena)
+
+#include "core/templates/frame_arena.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and don't overlap") {
+	uint8_t *a = static_cast<uint8_t *>(FrameArena::alloc(3));
+	uint8_t *b = static_cast<uint8_t *>(FrameArena::alloc(100));
+	uint8_t *c = static_cast<uint8_t *>(FrameArena::alloc(1));
+
+	CHECK((reinterpret_cast<uintptr_t>(a) % 16) == 0);
+	CHECK((reinterpret_cast<uintptr_t>(b) % 16) == 0);
+	CHECK((reinterpret_cast<uintptr_t>(c) % 16) == 0);
+	CHECK(b >= a + 3);
+	CHECK(c >= b + 100);
+
+	FrameArena::free(c);
+	FrameArena::free(b);
+	FrameArena::free(a);
+}
+
+TEST_CASE("[FrameArena] Most recent allocation is reused and grows in place") {
+	void *a = FrameArena::alloc(64);
+	FrameArena::free(a);
+	void *b = FrameArena::alloc(64);
+	CHECK(a == b);
+
+	uint8_t *grown = static_cast<uint8_t *>(FrameArena::realloc(b, 4096));
+	CHECK(static_cast<void *>(grown) == b);
+	FrameArena::free(grown);
+}
+
+TEST_CASE("[FrameArena] Reallocation keeps contents") {
+	uint32_t *a = static_cast<uint32_t *>(FrameArena::alloc(sizeof(uint32_t) * 16));
+	for (uint32_t i = 0; i < 16; i++) {
+		a[i] = i * 7;
+	}
+	// Another allocation on top forces the reallocation to move.
+	void *b = FrameArena::alloc(16);
+	uint32_t *moved = static_cast<uint32_t *>(FrameArena::realloc(a, sizeof(uint32_t) * 1024));
+	CHECK(moved != a);
+	for (uint32_t i = 0; i < 16; i++) {
+		CHECK(moved[i] == i * 7);
+	}
+	FrameArena::free(b);
+	FrameArena::free(moved);
+}
+
+TEST_CASE("[FrameArena] Allocations larger than a block") {
+	const size_t size = 4 * 1024 * 1024;
+	uint8_t *small = static_cast<uint8_t *>(FrameArena::alloc(16));
+	uint8_t *large = static_cast<uint8_t *>(FrameArena::alloc(size));
+	memset(large, 0xAB, size);
+	small[0] = 1;
+	CHECK(large[size - 1] == 0xAB);
+	CHECK(small[0] == 1);
+	FrameArena::free(large);
+	FrameArena::free(small);
+
+	FrameArena::advance_frame();
+	void *after = FrameArena::alloc(16);
+	CHECK(after != nullptr);
+	FrameArena::free(after);
+}
+
+TEST_CASE("[FrameArena] FrameLocalVector") {
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	FrameLocalVector<String> strings;
+	strings.push_back("a");
+	strings.push_back("b");
+
+	CHECK(vector.size() == 10000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[9999] == 9999);
+	CHECK(strings[1] == "b");
+
+	vector.reset();
+	CHECK(vector.is_empty());
+	CHECK(strings.size() == 2);
+}
+
+} // namespace TestFrameArena
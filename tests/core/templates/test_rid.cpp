@@ -241,6 +241,70 @@ TEST_CASE("[RID_Owner] Thread safety") {
 		tester.test();
 	}
 }
+
+TEST_CASE("[RID_Owner][Benchmark] Contended allocation, lookup and free") {
+	constexpr uint32_t ITERATIONS = 20000;
+	constexpr uint32_t BATCH = 16;
+
+	struct ContentionTester {
+		RID_Owner<uint64_t, true> rid_owner;
+		TightLocalVector<Thread> threads;
+		SafeNumeric<uint32_t> next_thread_idx;
+		std::atomic<uint32_t> errors = 0;
+
+		ContentionTester() :
+				rid_owner(256) {
+			threads.resize(OS::get_singleton()->get_processor_count());
+		}
+
+		void test() {
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].start(
+						[](void *p_data) {
+							ContentionTester *ct = (ContentionTester *)p_data;
+							const uint64_t self_th_idx = ct->next_thread_idx.postincrement();
+							RID rids[BATCH];
+							uint32_t local_errors = 0;
+
+							// Each thread churns through batches, so slots freed by one thread get reused by others.
+							for (uint32_t i = 0; i < ITERATIONS / BATCH; i++) {
+								for (uint32_t j = 0; j < BATCH; j++) {
+									rids[j] = ct->rid_owner.make_rid((self_th_idx << 32) | (i * BATCH + j));
+								}
+								for (uint32_t j = 0; j < BATCH; j++) {
+									const uint64_t *value = ct->rid_owner.get_or_null(rids[j]);
+									if (!value || *value != ((self_th_idx << 32) | (i * BATCH + j)) || !ct->rid_owner.owns(rids[j])) {
+										local_errors++;
+									}
+								}
+								for (uint32_t j = 0; j < BATCH; j++) {
+									ct->rid_owner.free(rids[j]);
+									if (ct->rid_owner.owns(rids[j])) {
+										local_errors++;
+									}
+								}
+							}
+
+							ct->errors.fetch_add(local_errors, std::memory_order_relaxed);
+						},
+						this);
+			}
+
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].wait_to_finish();
+			}
+		}
+	};
+
+	ContentionTester tester;
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	tester.test();
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+	CHECK_EQ(tester.errors.load(), 0u);
+	CHECK_EQ(tester.rid_owner.get_rid_count(), 0u);
+	MESSAGE(vformat("%d threads x %d RIDs made, looked up and freed in %d usec.", tester.threads.size(), ITERATIONS, elapsed));
+}
 #endif // THREADS_ENABLED
 
 } // namespace TestRID
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_small_hash_map.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_small_hash_map)
+
+#include "core/templates/small_hash_map.h"
+
+namespace TestSmallHashMap {
+
+TEST_CASE("[SmallHashMap] Insert, lookup and erase") {
+	SmallHashMap<int, int, 4> map;
+	for (int i = 0; i < 4; i++) {
+		map.insert(i, i * 10);
+	}
+	CHECK(map.size() == 4);
+	CHECK(map.get_capacity() == 4);
+	CHECK(map[2] == 20);
+	CHECK(map.getptr(5) == nullptr);
+
+	// Spill out of the inline storage.
+	for (int i = 4; i < 100; i++) {
+		map.insert(i, i * 10);
+	}
+	CHECK(map.size() == 100);
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.has(i));
+		CHECK(map[i] == i * 10);
+	}
+
+	for (int i = 0; i < 100; i += 3) {
+		CHECK(map.erase(i));
+	}
+	CHECK_FALSE(map.erase(0));
+	CHECK(map.size() == 66);
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.has(i) == (i % 3 != 0));
+	}
+}
+
+TEST_CASE("[SmallHashMap] Insertion order is kept and freed slots are reused") {
+	SmallHashMap<int, int, 4> map;
+	map.insert(3, 0);
+	map.insert(1, 0);
+	map.insert(2, 0);
+	map.erase(1);
+	map.insert(7, 0);
+	map.insert(0, 0, true);
+
+	const int expected[] = { 0, 3, 2, 7 };
+	int i = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == expected[i++]);
+	}
+	CHECK(i == 4);
+	// The erased slot was reused, so nothing spilled out of the inline storage.
+	CHECK(map.get_capacity() == 4);
+}
+
+TEST_CASE("[SmallHashMap] Elements are pointer-stable") {
+	SmallHashMap<int, int, 2> map;
+	map[0] = 42;
+	const int *first = map.getptr(0);
+	for (int i = 1; i < 1000; i++) {
+		map[i] = i;
+	}
+	CHECK(map.getptr(0) == first);
+	CHECK(*first == 42);
+}
+
+TEST_CASE("[SmallHashMap] Copy, clear and sort") {
+	SmallHashMap<int, String, 4> map;
+	for (int i = 20; i > 0; i--) {
+		map.insert(i, itos(i));
+	}
+	SmallHashMap<int, String, 4> copy(map);
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(copy.size() == 20);
+
+	copy.sort();
+	int expected = 1;
+	for (const KeyValue<int, String> &E : copy) {
+		CHECK(E.key == expected);
+		CHECK(E.value == itos(expected));
+		expected++;
+	}
+	CHECK(copy.has(20));
+	CHECK(copy.last()->key == 20);
+
+	map = copy;
+	CHECK(map.size() == 20);
+	CHECK(map.begin()->key == 1);
+}
+
+} // namespace TestSmallHashMap
@@ -707,4 +707,44 @@ TEST_CASE("[Vector] Cyclic Reference") {
 }
 #endif
 
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Vector] Copy on write is recorded") {
+	Vector<int> vector;
+	vector.resize(64);
+	vector.ptrw();
+
+	const uint64_t copies = CowDataCopyStats::get_copy_count();
+	const uint64_t bytes = CowDataCopyStats::get_copied_bytes();
+
+	// Writing to an unshared vector doesn't copy.
+	vector.ptrw();
+	CHECK(CowDataCopyStats::get_copy_count() == copies);
+
+	Vector<int> shared = vector;
+	shared.ptrw();
+	CHECK(CowDataCopyStats::get_copy_count() == copies + 1);
+	CHECK(CowDataCopyStats::get_copied_bytes() == bytes + 64 * sizeof(int));
+
+	// Resizing, inserting into and removing from a shared vector fork it as well.
+	Vector<int> shrunk = vector;
+	shrunk.resize(32);
+	CHECK(CowDataCopyStats::get_copy_count() == copies + 2);
+	CHECK(CowDataCopyStats::get_copied_bytes() == bytes + 96 * sizeof(int));
+
+	Vector<int> inserted = vector;
+	inserted.insert(0, 1);
+	CHECK(CowDataCopyStats::get_copy_count() == copies + 3);
+	CHECK(CowDataCopyStats::get_copied_bytes() == bytes + 160 * sizeof(int));
+
+	Vector<int> removed = vector;
+	removed.remove_at(0);
+	CHECK(CowDataCopyStats::get_copy_count() == copies + 4);
+	CHECK(CowDataCopyStats::get_copied_bytes() == bytes + 223 * sizeof(int));
+
+	CowDataCopyStats::CallSite sites[4];
+	CHECK(CowDataCopyStats::get_call_sites(sites, 4) > 0);
+	CHECK(sites[0].copies > 0);
+}
+#endif // DEBUG_ENABLED
+
 } // namespace TestVector
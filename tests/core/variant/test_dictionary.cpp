@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_dictionary)
 
 #include "core/object/ref_counted.h"
+#include "core/os/os.h"
 #include "core/variant/typed_dictionary.h"
 
 namespace TestDictionary {
@@ -750,4 +751,101 @@ TEST_CASE("[Dictionary] RefCounted value init") {
 	CHECK_EQ(tdict[5.0], Variant(b));
 }
 
+TEST_CASE("[Dictionary] Insertion order and pointer stability past the inline capacity") {
+	Dictionary dict;
+	dict[0] = "first";
+	const Variant *first = dict.getptr(0);
+	for (int i = 1; i < 100; i++) {
+		dict[i] = i;
+	}
+	CHECK(dict.getptr(0) == first);
+	CHECK(*first == Variant("first"));
+
+	for (int i = 0; i < 100; i += 2) {
+		dict.erase(i);
+	}
+	dict[StringName("name")] = 1;
+	// String and StringName keys are interchangeable.
+	CHECK(dict.has("name"));
+
+	int expected = 1;
+	for (const KeyValue<Variant, Variant> &kv : dict) {
+		if (kv.key.get_type() == Variant::INT) {
+			CHECK(int(kv.key) == expected);
+			expected += 2;
+		}
+	}
+	CHECK(expected == 101);
+	CHECK(dict.get_key_at_index(dict.size() - 1) == Variant("name"));
+}
+
+template <typename TMap>
+static uint64_t _benchmark_map(const LocalVector<Variant> &p_keys, int p_rounds, uint64_t &r_insert_usec, uint64_t &r_lookup_usec, uint64_t &r_iterate_usec) {
+	uint64_t checksum = 0;
+	r_insert_usec = 0;
+	r_lookup_usec = 0;
+	r_iterate_usec = 0;
+
+	for (int round = 0; round < p_rounds; round++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		TMap map;
+		for (uint32_t i = 0; i < p_keys.size(); i++) {
+			map.insert(p_keys[i], int64_t(i));
+		}
+		r_insert_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < p_keys.size(); i++) {
+			checksum += int64_t(*map.getptr(p_keys[i]));
+		}
+		r_lookup_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const KeyValue<Variant, Variant> &kv : map) {
+			checksum += int64_t(kv.value);
+		}
+		r_iterate_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	return checksum;
+}
+
+TEST_CASE("[Dictionary][Benchmark] Backend compared to HashMap") {
+	// 5 to 8 keys overflow 4 inline slots, which costs an index and the first segment on top of the dictionary.
+	using HalfInlineMap = SmallHashMap<Variant, Variant, Dictionary::DICTIONARY_INLINE_CAPACITY / 2, HashMapHasherDefault, StringLikeVariantComparator>;
+
+	const uint32_t key_counts[] = { 3, 5, 8, 64, 1024 };
+	for (uint32_t key_count : key_counts) {
+		LocalVector<Variant> keys;
+		for (uint32_t i = 0; i < key_count; i++) {
+			keys.push_back(StringName("key_" + itos(i)));
+		}
+		const int rounds = MAX(1, 200000 / int(key_count));
+
+		uint64_t old_insert = 0;
+		uint64_t old_lookup = 0;
+		uint64_t old_iterate = 0;
+		const uint64_t old_checksum = _benchmark_map<HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>>(keys, rounds, old_insert, old_lookup, old_iterate);
+
+		uint64_t half_insert = 0;
+		uint64_t half_lookup = 0;
+		uint64_t half_iterate = 0;
+		const uint64_t half_checksum = _benchmark_map<HalfInlineMap>(keys, rounds, half_insert, half_lookup, half_iterate);
+
+		uint64_t new_insert = 0;
+		uint64_t new_lookup = 0;
+		uint64_t new_iterate = 0;
+		const uint64_t new_checksum = _benchmark_map<Dictionary::Map>(keys, rounds, new_insert, new_lookup, new_iterate);
+
+		CHECK(old_checksum == new_checksum);
+		CHECK(half_checksum == new_checksum);
+		MESSAGE(vformat("%d keys x %d rounds: insert %d -> %d -> %d usec, lookup %d -> %d -> %d usec, iterate %d -> %d -> %d usec (HashMap -> %d inline slots -> %d inline slots).",
+				key_count, rounds, old_insert, half_insert, new_insert, old_lookup, half_lookup, new_lookup, old_iterate, half_iterate, new_iterate,
+				Dictionary::DICTIONARY_INLINE_CAPACITY / 2, Dictionary::DICTIONARY_INLINE_CAPACITY));
+	}
+	MESSAGE(vformat("Map size: HashMap %d bytes, %d inline slots %d bytes, %d inline slots %d bytes.",
+			int(sizeof(HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>)),
+			Dictionary::DICTIONARY_INLINE_CAPACITY / 2, int(sizeof(HalfInlineMap)), Dictionary::DICTIONARY_INLINE_CAPACITY, int(sizeof(Dictionary::Map))));
+}
+
 } // namespace TestDictionary
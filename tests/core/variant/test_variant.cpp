@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_variant)
 
 #include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
 #include "core/variant/variant_parser.h"
 
 namespace TestVariant {
@@ -2466,4 +2467,22 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+TEST_CASE("[Variant] Packed arrays are moved into Variant") {
+	PackedFloat32Array array;
+	array.resize(16);
+	const float *data = array.ptr();
+
+	Variant variant = std::move(array);
+	CHECK(array.is_empty());
+	PackedFloat32Array *stored = VariantInternal::get_float32_array(&variant);
+	CHECK(stored->ptr() == data);
+
+	// Only the Variant references the buffer, so writing to it doesn't copy.
+	CHECK(stored->ptrw() == data);
+
+	// Copies still share the buffer.
+	PackedFloat32Array copy = variant;
+	CHECK(copy.ptr() == data);
+}
+
 } // namespace TestVariant
@@ -0,0 +1,226 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_raster_occlusion_cull)
+
+#include "core/math/projection.h"
+#include "core/os/os.h"
+#include "modules/modules_enabled.gen.h" // For raycast.
+#include "servers/rendering/raster_occlusion_cull.h"
+
+namespace TestRasterOcclusionCull {
+
+// A set of square walls facing the camera, which looks down -Z from the origin.
+class WallScene {
+	RendererSceneOcclusionCull *culler = nullptr;
+	RID occluder;
+	RID scenario = RID::from_uint64(0x7fff000000000001);
+	RID buffer = RID::from_uint64(0x7fff000000000002);
+	LocalVector<RID> instances;
+	LocalVector<Transform3D> transforms;
+
+public:
+	Transform3D cam_transform;
+	Projection cam_projection = Projection::create_perspective(70.0, 1.0, 0.05, 100.0);
+	bool cam_orthogonal = false;
+
+	void add_wall(const Transform3D &p_xform) {
+		RID instance = RID::from_uint64(0x7fff000000001000 + instances.size());
+		culler->scenario_set_instance(scenario, instance, occluder, p_xform, true);
+		instances.push_back(instance);
+		transforms.push_back(p_xform);
+	}
+
+	void add_wall(const Vector3 &p_center, real_t p_half_size) {
+		add_wall(Transform3D(Basis().scaled(Vector3(p_half_size, p_half_size, 1.0)), p_center));
+	}
+
+	void set_wall_enabled(int p_index, bool p_enabled) {
+		culler->scenario_set_instance(scenario, instances[p_index], occluder, transforms[p_index], p_enabled);
+	}
+
+	void update() {
+		culler->buffer_update(buffer, cam_transform, cam_projection, cam_orthogonal);
+	}
+
+	bool is_occluded(const AABB &p_aabb) const {
+		const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.get_end().x, p_aabb.get_end().y, p_aabb.get_end().z };
+		uint64_t timeout = 0;
+		return culler->buffer_get_ptr(buffer)->is_occluded(bounds, cam_transform.origin, cam_transform.affine_inverse(), cam_projection, cam_projection.get_z_near(), cam_orthogonal, timeout);
+	}
+
+	WallScene(RendererSceneOcclusionCull *p_culler, const Size2i &p_buffer_size) {
+		culler = p_culler;
+
+		occluder = culler->occluder_allocate();
+		culler->occluder_initialize(occluder);
+		PackedVector3Array vertices = { Vector3(-1, -1, 0), Vector3(1, -1, 0), Vector3(1, 1, 0), Vector3(-1, 1, 0) };
+		PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+		culler->occluder_set_mesh(occluder, vertices, indices);
+
+		culler->add_scenario(scenario);
+		culler->add_buffer(buffer);
+		culler->buffer_set_scenario(buffer, scenario);
+		culler->buffer_set_size(buffer, p_buffer_size);
+	}
+
+	~WallScene() {
+		culler->remove_buffer(buffer);
+		for (const RID &instance : instances) {
+			culler->scenario_remove_instance(scenario, instance);
+		}
+		culler->remove_scenario(scenario);
+		culler->free_occluder(occluder);
+	}
+};
+
+TEST_CASE("[RasterOcclusionCull] Perspective occlusion") {
+	bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	{
+		WallScene scene(culler, Size2i(64, 64));
+		scene.add_wall(Vector3(0, 0, -5), 2.0);
+		scene.update();
+
+		CHECK_MESSAGE(scene.is_occluded(AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1))), "A box behind the wall should be occluded.");
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(5, -0.5, -11), Vector3(1, 1, 1))), "A box next to the wall should not be occluded.");
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(-0.5, -0.5, -4), Vector3(1, 1, 1))), "A box in front of the wall should not be occluded.");
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(-1.5, -0.5, -11), Vector3(8, 1, 1))), "A box sticking out from behind the wall should not be occluded.");
+
+		scene.set_wall_enabled(0, false);
+		scene.update();
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1))), "A disabled wall should not occlude anything.");
+	}
+	memdelete(culler);
+
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+TEST_CASE("[RasterOcclusionCull] Walls crossing the near plane") {
+	bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	{
+		WallScene scene(culler, Size2i(64, 64));
+		// A floor going from behind the camera into the distance.
+		scene.add_wall(Transform3D(Basis(Vector3(1, 0, 0), Math::deg_to_rad(-90.0)).scaled_local(Vector3(20, 20, 1)), Vector3(0, -1, 0)));
+		scene.update();
+
+		CHECK_MESSAGE(scene.is_occluded(AABB(Vector3(-0.5, -3, -8), Vector3(1, 1, 1))), "A box below the floor should be occluded.");
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(-0.5, 0, -8), Vector3(1, 1, 1))), "A box above the floor should not be occluded.");
+	}
+	memdelete(culler);
+
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthogonal occlusion") {
+	bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	{
+		WallScene scene(culler, Size2i(64, 64));
+		scene.cam_projection = Projection::create_orthogonal_aspect(10.0, 1.0, 0.05, 100.0);
+		scene.cam_orthogonal = true;
+		scene.add_wall(Vector3(0, 0, -5), 2.0);
+		scene.update();
+
+		CHECK_MESSAGE(scene.is_occluded(AABB(Vector3(-0.5, -0.5, -11), Vector3(1, 1, 1))), "A box behind the wall should be occluded.");
+		CHECK_MESSAGE(!scene.is_occluded(AABB(Vector3(3, -0.5, -11), Vector3(1, 1, 1))), "A box next to the wall should not be occluded.");
+	}
+	memdelete(culler);
+
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+#ifdef MODULE_RAYCAST_ENABLED
+// The raycast module registers the default occlusion culler, which uses Embree.
+TEST_CASE("[RasterOcclusionCull] Benchmark against raycast occlusion culling") {
+	RendererSceneOcclusionCull *raycast_culler = RendererSceneOcclusionCull::get_singleton();
+	REQUIRE(raycast_culler);
+
+	bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	const Size2i buffer_size(128, 96);
+	const int iterations = 20;
+
+	RasterOcclusionCull *raster_culler = memnew(RasterOcclusionCull);
+	{
+		WallScene raster_scene(raster_culler, buffer_size);
+		WallScene raycast_scene(raycast_culler, buffer_size);
+
+		for (int i = 0; i < 256; i++) {
+			Vector3 center((i % 16) * 3.0 - 24.0, ((i / 16) % 4) * 3.0 - 6.0, -10.0 - (i / 64) * 10.0);
+			raster_scene.add_wall(center, 1.5);
+			raycast_scene.add_wall(center, 1.5);
+		}
+
+		// The raycast culler commits its scene on a thread, wait until it's done.
+		const AABB hidden(Vector3(-0.5, -0.5, -60), Vector3(1, 1, 1));
+		raycast_scene.update();
+		for (int i = 0; i < 1000 && !raycast_scene.is_occluded(hidden); i++) {
+			OS::get_singleton()->delay_usec(1000);
+			raycast_scene.update();
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			raster_scene.update();
+		}
+		uint64_t raster_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			raycast_scene.update();
+		}
+		uint64_t raycast_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("Raster: %d usec per update, raycast: %d usec per update.", raster_usec / iterations, raycast_usec / iterations));
+
+		// Both backends should agree on a few simple cases.
+		CHECK(raster_scene.is_occluded(hidden) == raycast_scene.is_occluded(hidden));
+		const AABB visible(Vector3(-0.5, 35, -60), Vector3(1, 1, 1));
+		CHECK(raster_scene.is_occluded(visible) == raycast_scene.is_occluded(visible));
+		CHECK(!raster_scene.is_occluded(visible));
+	}
+	memdelete(raster_culler);
+
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+#endif // MODULE_RAYCAST_ENABLED
+
+} // namespace TestRasterOcclusionCull
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  test_shader_batch.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_shader_batch)
+
+#include "servers/rendering/rendering_server.h"
+
+namespace TestShaderBatch {
+
+static bool has_parameter(RID p_shader, const String &p_name) {
+	List<PropertyInfo> parameters;
+	RS::get_singleton()->get_shader_parameter_list(p_shader, &parameters);
+	for (const PropertyInfo &parameter : parameters) {
+		if (parameter.name == p_name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Setting the code of many shaders at once compiles each of them") {
+	constexpr int SHADER_COUNT = 64;
+	Vector<RID> shaders;
+	Vector<String> codes;
+	for (int i = 0; i < SHADER_COUNT; i++) {
+		shaders.push_back(RS::get_singleton()->shader_create());
+		codes.push_back(vformat("shader_type spatial;\nuniform float value_%d;\nvoid fragment() {\n\tALBEDO = vec3(value_%d);\n}\n", i, i));
+	}
+
+	// A shader listed twice only gets its last code.
+	shaders.push_back(shaders[0]);
+	codes.push_back("shader_type canvas_item;\nuniform float replaced;\nvoid fragment() {\n\tCOLOR.r = replaced;\n}\n");
+
+	RS::get_singleton()->shaders_set_code(shaders, codes);
+
+	CHECK(has_parameter(shaders[0], "replaced"));
+	CHECK_FALSE(has_parameter(shaders[0], "value_0"));
+	for (int i = 1; i < SHADER_COUNT; i++) {
+		CHECK(has_parameter(shaders[i], vformat("value_%d", i)));
+	}
+
+	for (int i = 0; i < SHADER_COUNT; i++) {
+		RS::get_singleton()->free_rid(shaders[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Setting the code of shaders at once requires matching sizes") {
+	const RID shader = RS::get_singleton()->shader_create();
+	Vector<RID> shaders = { shader };
+
+	ERR_PRINT_OFF;
+	RS::get_singleton()->shaders_set_code(shaders, Vector<String>());
+	ERR_PRINT_ON;
+	CHECK_FALSE(has_parameter(shader, "value"));
+
+	RS::get_singleton()->free_rid(shader);
+}
+
+} // namespace TestShaderBatch